@@ -0,0 +1,168 @@
+/**
+ * @file dio_ext.c
+ * @author Mohamed Hassanin
+ * @brief An extension for the dio module for specific features in MCUs.
+ * @version 0.1
+ * @date 2021-03-07
+ */
+
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_ext.h" /* For this modules definitions */
+#include "dio_memmap.h" /* For Hardware definitions */
+#include "dio_inline.h" /* For the port register tables */
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+#if DIO_TOGGLE == STD_ON
+/**
+* Defines a table of pointers to the Port Data Toggle Register. Writing a
+* logic one to a bit of the input register toggles the output register bit.
+*/
+static uint8_t volatile * const Dio_PortsToggle[DIO_NUMBER_OF_PORTS] =
+{
+  (volatile uint8_t*)PINB,
+  (volatile uint8_t*)PINC,
+  (volatile uint8_t*)PIND
+};
+#endif
+
+/**********************************************************************
+* Functions Definitions
+**********************************************************************/
+#if DIO_TOGGLE == STD_ON
+/**************************************************************************
+* Function : Dio_ChannelToggle()
+*//**
+* \b Description:
+* This function is used to toggle the current state of a channel (pin). <br>
+* Writing a logic one to a PINx bit toggles the PORTx bit in hardware, so<br>
+* the toggle is a single write with no read-modify-write.<br>
+* PRE-CONDITION: The channel is configured as OUTPUT <br>
+* PRE-CONDITION: The channel is configured as GPIO <br>
+* PRE-CONDITION: The channel is within the maximum DioChannel_t definition<br>
+* @param Channel is the pin from the DioChannel_t that is
+* to be modified.
+* \b Example:
+* @code
+* Dio_ChannelToggle(PORTB_5);
+* @endcode
+* @see Dio_PortToggle
+* @return void
+**********************************************************************/
+void 
+Dio_ChannelToggle(DioChannel_t Channel)
+{
+  DIO_REG_WRITE(Dio_PortsToggle[DIO_CHANNEL_PORT(Channel)], DIO_CHANNEL_MASK(Channel));
+}
+
+/**************************************************************************
+* Function : Dio_PortToggle()
+*//**
+* \b Description:
+* This function is used to toggle the current state of the channels of a<br>
+* port selected by Mask. <br>
+* Writing a logic one to a PINx bit toggles the PORTx bit in hardware, so<br>
+* the toggle is a single write with no read-modify-write.<br>
+* PRE-CONDITION: The masked channels are configured as OUTPUT <br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition<br>
+* @param Port is the port from the DioPort_t that is to be modified.
+* @param Mask selects the channels to toggle, bit n for channel n
+* \b Example:
+* @code
+* Dio_PortToggle(DIO_PORTB, 0x21); // Toggle PORTB_0 and PORTB_5
+* @endcode
+* @see Dio_ChannelToggle
+* @return void
+**********************************************************************/
+void 
+Dio_PortToggle(DioPort_t Port, DioPortValue_t Mask)
+{
+  DIO_REG_WRITE(Dio_PortsToggle[Port], Mask);
+}
+#endif
+
+#if DIO_SET_PULLUP == STD_ON
+/**********************************************************************
+* Function : Dio_SetPullup()
+*//**
+* \b Description:
+* This function is used to enable/disable the pull-up resistor of a <br>
+* channel. On the ATmega328P the pull-up of an INPUT channel is its PORTx<br>
+* bit, it is set with a read-modify-write that runs with interrupts<br>
+* disabled so that it is not corrupted by an ISR writing the same port.<br>
+* PRE-CONDITION: The channel is configured as INPUT <br>
+* PRE-CONDITION: The channel is within the maximum DioChannel_t definition <br>
+* POST-CONDITION: The pullup resistor is attached/detached to/from the channel <br>
+* @param Channel is the channel to attach/detach the resistor to/from.
+* @param State is ENABLED or DISABLED
+* \b Example:
+* @code
+* Dio_SetPullup(PORTB_0, ENABLED);
+* @endcode
+* @see Dio_PortSetPullups
+* @return void
+**********************************************************************/
+void 
+Dio_SetPullup(DioChannel_t Channel, DioResistor_t State)
+{
+  const DioPort_t Port = DIO_CHANNEL_PORT(Channel);
+  const DioPortValue_t Mask = DIO_CHANNEL_MASK(Channel);
+  uint8_t Sreg; // Saved interrupt state
+
+  if(State >= MAX_RESISTOR)
+    {
+      //TODO: implement your error handling method
+      return;
+    }
+
+  DIO_CRITICAL_ENTER(Sreg);
+  if(State == ENABLED)
+    {
+      DIO_REG_WRITE(Dio_PortsOut[Port], DIO_REG_READ(Dio_PortsOut[Port]) | Mask);
+    }
+  else
+    {
+      DIO_REG_WRITE(Dio_PortsOut[Port], DIO_REG_READ(Dio_PortsOut[Port]) & (DioPortValue_t)~Mask);
+    }
+  DIO_CRITICAL_EXIT(Sreg);
+}
+
+/**********************************************************************
+* Function : Dio_PortSetPullups()
+*//**
+* \b Description:
+* This function is used to set the pull-up resistors of all the INPUT<br>
+* channels of a port with one write of its PORTx register: the pull-ups<br>
+* of the inputs selected by Mask are enabled and those of the other<br>
+* inputs are disabled. The OUTPUT channels keep their level, whatever<br>
+* their bit in Mask. The read-modify-write runs with interrupts disabled<br>
+* so that it is not corrupted by an ISR writing the same port.<br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition<br>
+* POST-CONDITION: The pull-up of each INPUT channel of the port follows<br>
+* its bit in Mask.<br>
+* @param Port is the port from the DioPort_t that is to be modified.
+* @param Mask selects the inputs to pull up, bit n for channel n
+* \b Example:
+* @code
+* Dio_PortSetPullups(DIO_PORTB, 0xFF); // Pull up every unused input
+* @endcode
+* @see Dio_SetPullup
+* @return void
+**********************************************************************/
+void 
+Dio_PortSetPullups(DioPort_t Port, DioPortValue_t Mask)
+{
+  uint8_t Sreg; // Saved interrupt state
+  uint8_t Direction; // The OUTPUT channels
+
+  DIO_CRITICAL_ENTER(Sreg);
+  Direction = DIO_REG_READ(Dio_PortsDir[Port]);
+  DIO_REG_WRITE(Dio_PortsOut[Port],
+                (DIO_REG_READ(Dio_PortsOut[Port]) & Direction) | (Mask & ~Direction));
+  DIO_CRITICAL_EXIT(Sreg);
+}
+#endif
+/*************** END OF FUNCTIONS ********************************/
@@ -0,0 +1,39 @@
+/** 
+ * @file dio_ext.h
+ * @author Mohamed Hassanin
+ * @brief An extension for the dio module for specific features in MCUs.
+ * @version 0.1
+ * @date 2021-03-07
+*/
+
+#ifndef DIO_EXT_H
+#define DIO_EXT_H
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include "dio_ext_cfg.h" /**< For dio configuration */
+#include "dio_cfg.h" /**< For dio configuration */
+
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#if DIO_TOGGLE == STD_ON
+void Dio_ChannelToggle(DioChannel_t Channel);
+void Dio_PortToggle(DioPort_t Port, DioPortValue_t Mask);
+#endif
+
+#if DIO_SET_PULLUP == STD_ON
+void Dio_SetPullup(DioChannel_t Channel, DioResistor_t State);
+void Dio_PortSetPullups(DioPort_t Port, DioPortValue_t Mask);
+#endif
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* DIO_EXT_H*/
+/*************** END OF FILE ********************************/
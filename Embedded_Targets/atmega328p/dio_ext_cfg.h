@@ -0,0 +1,60 @@
+/**
+ * @file dio_ext_cfg.h
+ * @author Mohamed Hassanin
+ * @brief An extension for the dio module for specific features in MCUs.
+ * @version 0.1
+ * @date 2021-03-07
+ */
+
+#ifndef DIO_EXT_CFG_H_
+#define DIO_EXT_CFG_H_
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+ * The feature is supported
+ */
+#define STD_ON 1
+/**
+ * The feature is not supported
+ */
+#define STD_OFF 0
+
+/**
+ * Does this target support toggling.
+ */
+#define DIO_TOGGLE STD_ON
+/**
+ * Does this target support pullup resistors.
+ */
+#define DIO_SET_PULLUP STD_ON
+/**
+ * Does this target support pulldown resistors.
+ */
+#define DIO_SET_PULLDOWN STD_OFF
+/**
+ * Does this target support output speed change
+ */
+#define DIO_SET_SPEED STD_OFF
+/**
+ * Does this target support mode change
+ */
+#define DIO_SET_MODE STD_OFF 
+
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+#if DIO_SET_PULLUP == STD_ON || DIO_SET_PULLDOWN == STD_ON
+/**
+* Defines the possible states of the channel pull-up/down resistors
+*/
+typedef enum
+{
+	DISABLED, /**< Used to disable the internal pull-up/down resistors */
+	ENABLED, /**< Used to enable the internal pull-up/down resistors */
+	MAX_RESISTOR /**< Resistor states should be below this value */
+}DioResistor_t;
+#endif
+
+#endif /* DIO_EXT_CFG_H_*/
+/************************* END OF FILE ********************************/
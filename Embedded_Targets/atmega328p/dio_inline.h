@@ -0,0 +1,151 @@
+/** 
+ * @file dio_inline.h
+ * @author Mohamed Hassanin
+ * @brief The port register tables of the dio and its inline fast path.
+ * The tables are shared by dio.c and, with DIO_INLINE set to STD_ON, by the
+ * static inline definitions of Dio_ChannelRead, Dio_ChannelWrite and
+ * Dio_SetChannelDirection below, which dio.h then exposes in place of the
+ * functions of dio.c with the same signatures. For a constant channel the
+ * port, the mask and the register are folded at build time and a call
+ * reduces to the register access itself (sbi / cbi / sbis on the AVR). A
+ * channel known at run time costs the shift of its mask instead of the
+ * channel lookup table. The inline functions do not take part in batches
+ * and are not counted, so DIO_INLINE needs DIO_SHADOW and DIO_INSTRUMENT
+ * set to STD_OFF.
+ * @version 0.1
+ * @date 2021-01-12
+*/
+#ifndef DIO_INLINE_H_
+#define DIO_INLINE_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_cfg.h" /**< For dio configuration */
+#include "dio_memmap.h" /**< For Hardware definitions */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+#if DIO_INLINE == STD_ON && (DIO_SHADOW == STD_ON || DIO_INSTRUMENT == STD_ON)
+#error "DIO_INLINE needs DIO_SHADOW and DIO_INSTRUMENT set to STD_OFF"
+#endif
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* Defines a table of pointers to the peripheral input register on the
+* microcontroller.
+*/
+static const volatile uint8_t * const Dio_PortsIn[DIO_NUMBER_OF_PORTS] =
+{ 
+  (volatile uint8_t*)PINB,
+  (volatile uint8_t*)PINC,
+  (volatile uint8_t*)PIND
+};
+/**
+* Defines a table of pointers to the peripheral data direction register
+on
+* the microcontroller.
+*/
+static uint8_t volatile * const Dio_PortsDir[DIO_NUMBER_OF_PORTS] =
+{
+  (volatile uint8_t*)DDRB,
+  (volatile uint8_t*)DDRC,
+  (volatile uint8_t*)DDRD
+};
+
+/**
+* Defines a table of pointers to the Port Data Output Register
+*/
+static uint8_t volatile * const Dio_PortsOut[DIO_NUMBER_OF_PORTS] =
+{
+  (volatile uint8_t*)PORTB,
+  (volatile uint8_t*)PORTC,
+  (volatile uint8_t*)PORTD
+};
+
+#if DIO_INLINE == STD_ON
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : Dio_InlineUpdate()
+*//**
+* \b Description:
+* Sets or clears the bits of Mask in a port register, in a critical<br>
+* section when DIO_ATOMIC is STD_ON. For a constant channel the port<br>
+* register is in the I/O space of sbi and cbi, so that the section is<br>
+* in Sreg, SREG / cli / sbi (cbi) / out SREG, Sreg: the interrupts are<br>
+* disabled for 2 instructions and 3 cycles, the 2 cycles of sbi or cbi<br>
+* and the out, in the timings of the AVR instruction set.<br>
+* @param Register is the port register
+* @param Mask is the mask of the channel
+* @param Set is 1 to set the bits, 0 to clear them
+* @return void
+**********************************************************************/
+static inline void
+Dio_InlineUpdate(uint8_t volatile * const Register, DioPortValue_t Mask, uint8_t Set)
+{
+#if DIO_ATOMIC == STD_ON
+  uint8_t Sreg; // Saved interrupt state
+
+  DIO_CRITICAL_ENTER(Sreg);
+#endif
+  if(Set != 0)
+    {
+      DIO_REG_WRITE(Register, DIO_REG_READ(Register) | Mask);
+    }
+  else
+    {
+      DIO_REG_WRITE(Register, DIO_REG_READ(Register) & (DioPortValue_t)~Mask);
+    }
+#if DIO_ATOMIC == STD_ON
+  DIO_CRITICAL_EXIT(Sreg);
+#endif
+}
+
+/**********************************************************************
+* Function : Dio_ChannelRead()
+*//**
+* \b Description:
+* The inline definition of Dio_ChannelRead.<br>
+* @see Dio_ChannelRead in dio.c
+**********************************************************************/
+static inline DioState_t
+Dio_ChannelRead(DioChannel_t Channel)
+{
+  return ((DIO_REG_READ(Dio_PortsIn[DIO_CHANNEL_PORT(Channel)]) & DIO_CHANNEL_MASK(Channel))
+          ? DIO_STATE_HIGH : DIO_STATE_LOW);
+}
+
+/**********************************************************************
+* Function : Dio_ChannelWrite()
+*//**
+* \b Description:
+* The inline definition of Dio_ChannelWrite.<br>
+* @see Dio_ChannelWrite in dio.c
+**********************************************************************/
+static inline void
+Dio_ChannelWrite(DioChannel_t Channel, DioState_t State)
+{
+  Dio_InlineUpdate(Dio_PortsOut[DIO_CHANNEL_PORT(Channel)], DIO_CHANNEL_MASK(Channel),
+                   State == DIO_STATE_HIGH);
+}
+
+/**********************************************************************
+* Function : Dio_SetChannelDirection()
+*//**
+* \b Description:
+* The inline definition of Dio_SetChannelDirection.<br>
+* @see Dio_SetChannelDirection in dio.c
+**********************************************************************/
+static inline void
+Dio_SetChannelDirection(DioChannel_t Channel, DioDirection_t Direction)
+{
+  Dio_InlineUpdate(Dio_PortsDir[DIO_CHANNEL_PORT(Channel)], DIO_CHANNEL_MASK(Channel),
+                   Direction == DIO_DIR_OUTPUT);
+}
+#endif
+
+#endif /* DIO_INLINE_H_*/
+/*************** END OF FILE ********************************/
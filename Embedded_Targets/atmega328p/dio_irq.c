@@ -0,0 +1,268 @@
+/**
+ * @file dio_irq.c
+ * @author Mohamed Hassanin
+ * @brief The implementation for the dio interrupt driven inputs on the
+ * pin change interrupts of the ATmega328P. Pin change bank n covers the
+ * channels of port n, its interrupt finds the channels that changed by
+ * comparing the port with the value cached by the previous interrupt.
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_irq.h" /* For this modules definitions */
+#include "dio_memmap.h" /* For Hardware definitions */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+#if (DIO_IRQ_QUEUE_SIZE & (DIO_IRQ_QUEUE_SIZE - 1U)) != 0 || DIO_IRQ_QUEUE_SIZE > 128U
+#error "DIO_IRQ_QUEUE_SIZE must be a power of two of at most 128"
+#endif
+/**
+* Wraps an index of the event queue.
+*/
+#define DIO_IRQ_QUEUE_MASK (DIO_IRQ_QUEUE_SIZE - 1U)
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The event queue. The head is written by the interrupts only and the
+* tail by Dio_IrqEventsRead only.
+*/
+static DioIrqEvent_t Dio_IrqQueue[DIO_IRQ_QUEUE_SIZE];
+static volatile uint8_t Dio_IrqHead;
+static volatile uint8_t Dio_IrqTail;
+/**
+* The number of events lost because the queue was full.
+*/
+static volatile uint16_t Dio_IrqOverflows;
+/**
+* The port levels sampled by the last interrupt of each port, and the
+* channels of each port that raise an event on a rising and on a falling
+* edge.
+*/
+static DioPortValue_t Dio_IrqCache[DIO_NUMBER_OF_PORTS];
+static DioPortValue_t Dio_IrqRising[DIO_NUMBER_OF_PORTS];
+static DioPortValue_t Dio_IrqFalling[DIO_NUMBER_OF_PORTS];
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : Dio_IrqPush()
+*//**
+* \b Description:
+* Appends an event to the queue, or counts an overflow when it is full.
+* Called from the interrupts only.
+**********************************************************************/
+static inline void
+Dio_IrqPush(uint8_t Port, DioPortValue_t Changed, DioPortValue_t Level)
+{
+  const uint8_t Head = Dio_IrqHead;
+  const uint8_t Next = (uint8_t)((Head + 1U) & DIO_IRQ_QUEUE_MASK);
+
+  if(Next == Dio_IrqTail)
+    {
+      Dio_IrqOverflows++;
+      return;
+    }
+
+  Dio_IrqQueue[Head].Port = Port;
+  Dio_IrqQueue[Head].Changed = Changed;
+  Dio_IrqQueue[Head].Level = Level;
+  // Publish the entry only after it is written
+  DIO_MEMORY_BARRIER();
+  Dio_IrqHead = Next;
+}
+
+/**********************************************************************
+* Function : Dio_IrqPortChange()
+*//**
+* \b Description:
+* The body of the pin change interrupt of a port: samples the port, finds
+* the channels that changed on one of their edges since the last sample
+* and queues them.
+**********************************************************************/
+static inline void
+Dio_IrqPortChange(uint8_t Port)
+{
+  const DioPortValue_t Level = DIO_REG_READ((volatile uint8_t *)DIO_PIN_ADDRESS(Port));
+  const DioPortValue_t Changed = (DioPortValue_t)(Level ^ Dio_IrqCache[Port]);
+  const DioPortValue_t Events = (DioPortValue_t)
+    (Changed & ((Level & Dio_IrqRising[Port]) | (~Level & Dio_IrqFalling[Port])));
+
+  Dio_IrqCache[Port] = Level;
+  if(Events != 0)
+    {
+      Dio_IrqPush(Port, Events, Level);
+    }
+}
+
+DIO_ISR(DIO_PCINT0_VECTOR, Dio_IrqPcint0)
+{
+  Dio_IrqPortChange(DIO_PORTB);
+}
+
+DIO_ISR(DIO_PCINT1_VECTOR, Dio_IrqPcint1)
+{
+  Dio_IrqPortChange(DIO_PORTC);
+}
+
+DIO_ISR(DIO_PCINT2_VECTOR, Dio_IrqPcint2)
+{
+  Dio_IrqPortChange(DIO_PORTD);
+}
+
+/*********************************************************************
+* Function : Dio_IrqInit()
+*//**
+* \b Description:
+* This function is used to enable the pin change interrupts of the<br>
+* channels of an interrupt table. The banks of the ports without an<br>
+* interrupt driven channel are disabled, the event queue and the overflow<br>
+* counter are cleared.<br>
+* PRE-CONDITION: Dio_Init has been called <br>
+* PRE-CONDITION: The table has DIO_IRQ_CHANNELS rows <br>
+* POST-CONDITION: The edges of the channels are queued as events once<br>
+* the global interrupts are enabled.<br>
+* @param Config is a pointer to the interrupt table
+* @return void
+*
+* \b Example:
+* @code
+* Dio_IrqInit(Dio_IrqConfigGet());
+* sei();
+* @endcode
+* @see Dio_IrqEventsRead
+**********************************************************************/
+void
+Dio_IrqInit(const DioIrqConfig_t * const Config)
+{
+  DioPortValue_t Enabled[DIO_NUMBER_OF_PORTS] = { 0 };
+  uint8_t Banks = 0;
+  uint8_t Sreg;
+
+  DIO_CRITICAL_ENTER(Sreg);
+
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      Dio_IrqRising[Port] = 0;
+      Dio_IrqFalling[Port] = 0;
+    }
+
+  for (uint8_t Row = 0; Row < DIO_IRQ_CHANNELS; Row++)
+    {
+      const DioPort_t Port = DIO_CHANNEL_PORT(Config[Row].Channel);
+      const DioPortValue_t PinMask = DIO_CHANNEL_MASK(Config[Row].Channel);
+
+      Enabled[Port] |= PinMask;
+      if(Config[Row].Edge != DIO_IRQ_FALLING)
+        {
+          Dio_IrqRising[Port] |= PinMask;
+        }
+      if(Config[Row].Edge != DIO_IRQ_RISING)
+        {
+          Dio_IrqFalling[Port] |= PinMask;
+        }
+    }
+
+  Dio_IrqHead = 0;
+  Dio_IrqTail = 0;
+  Dio_IrqOverflows = 0;
+
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      Dio_IrqCache[Port] = DIO_REG_READ((volatile uint8_t *)DIO_PIN_ADDRESS(Port));
+      DIO_REG_WRITE((volatile uint8_t *)DIO_PCMSK_ADDRESS(Port), Enabled[Port]);
+      if(Enabled[Port] != 0)
+        {
+          Banks |= (uint8_t)(1U << Port);
+        }
+    }
+
+  DIO_ISR_CONNECT(DIO_PCINT0_VECTOR, Dio_IrqPcint0);
+  DIO_ISR_CONNECT(DIO_PCINT1_VECTOR, Dio_IrqPcint1);
+  DIO_ISR_CONNECT(DIO_PCINT2_VECTOR, Dio_IrqPcint2);
+
+  // Drop the changes flagged before the cache was sampled
+  DIO_REG_WRITE((volatile uint8_t *)PCIFR, Banks);
+  DIO_REG_WRITE((volatile uint8_t *)PCICR, Banks);
+
+  DIO_CRITICAL_EXIT(Sreg);
+}
+
+/*********************************************************************
+* Function : Dio_IrqEventsRead()
+*//**
+* \b Description:
+* This function is used to drain up to Max events from the event queue,<br>
+* oldest first. It is called from the main loop; the interrupts keep<br>
+* queueing events while it runs.<br>
+* PRE-CONDITION: Dio_IrqInit has been called <br>
+* POST-CONDITION: The returned events are removed from the queue.<br>
+* @param Events receives the events
+* @param Max is the number of entries of Events
+* @return The number of events written to Events
+*
+* \b Example:
+* @code
+* DioIrqEvent_t Events[8];
+* uint8_t Count = Dio_IrqEventsRead(Events, 8);
+* for (uint8_t i = 0; i < Count; i++) { ... }
+* @endcode
+* @see Dio_IrqOverflowsGet
+**********************************************************************/
+uint8_t
+Dio_IrqEventsRead(DioIrqEvent_t * const Events, uint8_t Max)
+{
+  const uint8_t Head = Dio_IrqHead;
+  uint8_t Tail = Dio_IrqTail;
+  uint8_t Count = 0;
+
+  // Read the entries only after the head that published them
+  DIO_MEMORY_BARRIER();
+
+  while(Tail != Head && Count < Max)
+    {
+      Events[Count] = Dio_IrqQueue[Tail];
+      Count++;
+      Tail = (uint8_t)((Tail + 1U) & DIO_IRQ_QUEUE_MASK);
+    }
+
+  // Free the entries only after they are copied
+  DIO_MEMORY_BARRIER();
+  Dio_IrqTail = Tail;
+
+  return Count;
+}
+
+/*********************************************************************
+* Function : Dio_IrqOverflowsGet()
+*//**
+* \b Description:
+* This function is used to get the number of events lost because the<br>
+* event queue was full since Dio_IrqInit.<br>
+* PRE-CONDITION: Dio_IrqInit has been called <br>
+* @return The number of lost events
+*
+* \b Example:
+* @code
+* if(Dio_IrqOverflowsGet() != 0) { ... }
+* @endcode
+* @see Dio_IrqEventsRead
+**********************************************************************/
+uint16_t
+Dio_IrqOverflowsGet(void)
+{
+  uint16_t Overflows;
+  uint8_t Sreg;
+
+  // The 16-bit counter is read in two halves, keep the interrupts out
+  DIO_CRITICAL_ENTER(Sreg);
+  Overflows = Dio_IrqOverflows;
+  DIO_CRITICAL_EXIT(Sreg);
+
+  return Overflows;
+}
+/*************** END OF FUNCTIONS ********************************/
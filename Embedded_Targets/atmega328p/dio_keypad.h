@@ -0,0 +1,58 @@
+/**
+ * @file dio_keypad.h
+ * @author Mohamed Hassanin
+ * @brief The interface definition for the dio matrix keypad scanner.
+ * A scan selects each row of the keypad matrix with one masked write to
+ * the direction register of its port (the row PORTx bits are LOW, so the
+ * selected row is driven LOW and the others float) and samples all the
+ * columns of a port with one read, so a full scan costs O(rows) register
+ * accesses. The keys are debounced with vertical counters, kept in a key
+ * bitmap and reported as press and release events through a queue.
+ * @version 0.1
+ * @date 2021-01-12
+*/
+#ifndef DIO_KEYPAD_H_
+#define DIO_KEYPAD_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_cfg.h" /**< For dio configuration */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the number of keys of the keypad.
+*/
+#define DIO_KEYPAD_KEYS (DIO_KEYPAD_ROWS * DIO_KEYPAD_COLUMNS)
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+* Defines a key event of the queue.
+*/
+typedef struct
+{
+	uint8_t Key; /**< The key, row * DIO_KEYPAD_COLUMNS + column */
+	uint8_t Pressed; /**< 1 when the key was pressed, 0 when released */
+}DioKeypadEvent_t;
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void Dio_KeypadInit(const DioKeypadConfig_t * const Config);
+void Dio_KeypadScan(void);
+uint8_t Dio_KeypadIsPressed(uint8_t Key);
+void Dio_KeypadBitmapGet(uint8_t * const Bitmap);
+uint8_t Dio_KeypadEventRead(DioKeypadEvent_t * const Event);
+uint16_t Dio_KeypadOverflowsGet(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* DIO_KEYPAD_H_*/
+/*************** END OF FILE ********************************/
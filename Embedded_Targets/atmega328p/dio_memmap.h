@@ -1,16 +1,79 @@
 #ifndef DIO_MEMMAP_H
 #define DIO_MEMMAP_H
 
-#define DIO_UPPER_BOUND_ADDRESS 0x0025
-#define PORTD	0x002B	
-#define DDRD	0x002A	
-#define PIND	0x0029	
-#define PORTC	0x0028	
-#define DDRC	0x0027	
-#define PINC	0x0026	
-#define PORTB	0x0025	
-#define DDRB	0x0024	
-#define PINB	0x0023	
-#define DIO_LOWER_BOUND_ADDRESS 0x0023
-
-#endif
\ No newline at end of file
+#ifdef DIO_SIM
+/* Host build, the registers live in the simulated register file */
+#include "dio_sim.h"
+#define DIO_REGISTER(Address)	DIO_SIM_REGISTER(Address)
+#define DIO_REG_READ(Register)	DioSim_RegRead(Register)
+#define DIO_REG_WRITE(Register, Value)	DioSim_RegWrite((Register), (Value))
+#define DIO_FLASH
+#define DIO_FLASH_READ_BYTE(Address)	(*(Address))
+#define DIO_INTERRUPTS_DISABLE()	DioSim_InterruptsDisable()
+#define DIO_ISR(Vector, Handler)	static void Handler(void)
+#define DIO_ISR_CONNECT(Vector, Handler)	DioSim_VectorSet((Vector), (Handler))
+#define DIO_DELAY_CYCLES(Cycles)	DioSim_Delay(Cycles)
+#else
+#include <avr/pgmspace.h>
+#define DIO_FLASH	PROGMEM
+#define DIO_FLASH_READ_BYTE(Address)	pgm_read_byte(Address)
+#define DIO_REGISTER(Address)	(Address)
+#define DIO_REG_READ(Register)	(*(Register))
+#define DIO_REG_WRITE(Register, Value)	(*(Register) = (Value))
+#define DIO_INTERRUPTS_DISABLE()	__asm__ __volatile__ ("cli" ::: "memory")
+/* Interrupt service routine of vector number Vector, Handler names it on the host */
+#define DIO_ISR(Vector, Handler)	DIO_ISR_VECTOR(Vector)
+#define DIO_ISR_VECTOR(Vector) \
+  void __vector_##Vector(void) __attribute__ ((signal, used, externally_visible)); \
+  void __vector_##Vector(void)
+#define DIO_ISR_CONNECT(Vector, Handler)	((void)0)
+/* Busy waits a constant number of CPU cycles */
+#define DIO_DELAY_CYCLES(Cycles)	__builtin_avr_delay_cycles(Cycles)
+#endif
+
+/* Keeps the compiler from moving memory accesses across this point */
+#define DIO_MEMORY_BARRIER()	__asm__ __volatile__ ("" ::: "memory")
+
+/* Writing a logic one to a PINx bit toggles the PORTx bit */
+#define DIO_PIN_WRITE_TOGGLE	1
+
+#define DIO_UPPER_BOUND_ADDRESS DIO_REGISTER(0x002B)
+#define PORTD	DIO_REGISTER(0x002B)
+#define DDRD	DIO_REGISTER(0x002A)
+#define PIND	DIO_REGISTER(0x0029)
+#define PORTC	DIO_REGISTER(0x0028)
+#define DDRC	DIO_REGISTER(0x0027)
+#define PINC	DIO_REGISTER(0x0026)
+#define PORTB	DIO_REGISTER(0x0025)
+#define DDRB	DIO_REGISTER(0x0024)
+#define PINB	DIO_REGISTER(0x0023)
+#define DIO_LOWER_BOUND_ADDRESS DIO_REGISTER(0x0023)
+
+/* Register addresses by port index (DioPort_t), folded for a constant Port */
+#define DIO_PIN_ADDRESS(Port)	(PINB + 3U * (Port))
+#define DIO_DDR_ADDRESS(Port)	(DDRB + 3U * (Port))
+#define DIO_PORT_ADDRESS(Port)	(PORTB + 3U * (Port))
+
+/* Status register, bit 7 is the global interrupt enable flag */
+#define SREG	DIO_REGISTER(0x005F)
+
+/* Critical section, saves SREG and disables interrupts until it is restored */
+#define DIO_CRITICAL_ENTER(Sreg) \
+  do { (Sreg) = DIO_REG_READ((volatile uint8_t *)SREG); \
+       DIO_INTERRUPTS_DISABLE(); } while (0)
+#define DIO_CRITICAL_EXIT(Sreg) \
+  do { __asm__ __volatile__ ("" ::: "memory"); \
+       DIO_REG_WRITE((volatile uint8_t *)SREG, (Sreg)); } while (0)
+
+/* Pin change interrupts, bank n covers the channels of port n (DioPort_t) */
+#define PCICR	DIO_REGISTER(0x0068)
+#define PCIFR	DIO_REGISTER(0x003B)
+#define PCMSK0	DIO_REGISTER(0x006B)
+#define DIO_PCMSK_ADDRESS(Port)	(PCMSK0 + (Port))
+
+/* Interrupt vector numbers */
+#define DIO_PCINT0_VECTOR	3
+#define DIO_PCINT1_VECTOR	4
+#define DIO_PCINT2_VECTOR	5
+
+#endif
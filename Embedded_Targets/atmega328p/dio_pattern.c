@@ -0,0 +1,319 @@
+/**
+ * @file dio_pattern.c
+ * @author Mohamed Hassanin
+ * @brief The implementation for the dio pattern playback.
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_pattern.h" /* For this modules definitions */
+#include "dio.h" /* For the port interface */
+#include "dio_memmap.h" /* For the critical section */
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The channels the pattern is played on, the ring buffer of the samples
+* and the number of ticks per sample.
+*/
+static DioPort_t Dio_PatternPort;
+static DioPortValue_t Dio_PatternMask;
+static DioPortValue_t * Dio_PatternBuffer;
+static uint16_t Dio_PatternLength;
+static uint16_t Dio_PatternPeriod;
+/**
+* The state of the tick: the ticks until the next sample and the ring
+* position of the next sample to play.
+*/
+static uint16_t Dio_PatternCountdown;
+static uint16_t Dio_PatternReadIndex;
+/**
+* The ring position of the next sample filled by the producer.
+*/
+static uint16_t Dio_PatternWriteIndex;
+/**
+* The number of samples played, written by the tick only, and the number
+* of samples queued, written by the producer only. Their difference is
+* the number of samples in the ring.
+*/
+static volatile uint16_t Dio_PatternRead;
+static volatile uint16_t Dio_PatternWritten;
+/**
+* The number of samples missed because the ring was empty.
+*/
+static volatile uint16_t Dio_PatternUnderruns;
+/**
+* Set while the pattern plays, and when the producer has no more samples.
+*/
+static volatile uint8_t Dio_PatternPlaying;
+static volatile uint8_t Dio_PatternEnding;
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/*********************************************************************
+* Function : Dio_PatternPlay()
+*//**
+* \b Description:
+* This function is used to start playing a pattern on the masked<br>
+* channels of a port. Buffer holds the first Length samples and is then<br>
+* used as the ring buffer of the pattern, refilled by Dio_PatternFill as<br>
+* the samples are played. The first sample is written by the next tick.<br>
+* The pattern replaces the one playing, if any.<br>
+* PRE-CONDITION: The masked channels are configured as OUTPUT <br>
+* PRE-CONDITION: Length > 0 and Period > 0 <br>
+* POST-CONDITION: Dio_PatternTick plays a sample every Period ticks.<br>
+* @param Port is the DioPort_t that represents the port
+* @param Mask selects the channels of the port, bit n for channel n
+* @param Buffer holds the first samples, it must stay valid while playing
+* @param Length is the number of samples of Buffer
+* @param Period is the number of ticks per sample
+* @return void
+*
+* \b Example:
+* @code
+* static DioPortValue_t Wave[64];
+* Wave_Generate(Wave, 64);
+* Dio_PatternPlay(DIO_PORTB, 0x0F, Wave, 64, 1);
+* @endcode
+* @see Dio_PatternFill
+**********************************************************************/
+void
+Dio_PatternPlay(DioPort_t Port, DioPortValue_t Mask,
+                DioPortValue_t * const Buffer, uint16_t Length,
+                uint16_t Period)
+{
+  uint8_t Sreg;
+
+  if(Length == 0 || Period == 0)
+    {
+      //TODO: implement your error handling method
+      return;
+    }
+
+  DIO_CRITICAL_ENTER(Sreg);
+  Dio_PatternPort = Port;
+  Dio_PatternMask = Mask;
+  Dio_PatternBuffer = Buffer;
+  Dio_PatternLength = Length;
+  Dio_PatternPeriod = Period;
+  Dio_PatternCountdown = 1;
+  Dio_PatternReadIndex = 0;
+  Dio_PatternWriteIndex = 0;
+  Dio_PatternRead = 0;
+  Dio_PatternWritten = Length;
+  Dio_PatternUnderruns = 0;
+  Dio_PatternEnding = 0;
+  Dio_PatternPlaying = 1;
+  DIO_CRITICAL_EXIT(Sreg);
+}
+
+/*********************************************************************
+* Function : Dio_PatternFill()
+*//**
+* \b Description:
+* This function is used to queue samples behind the samples of the<br>
+* pattern. The samples are copied to the free entries of the ring, the<br>
+* ones that do not fit are left to the next call.<br>
+* PRE-CONDITION: Dio_PatternPlay has been called <br>
+* PRE-CONDITION: Dio_PatternEnd has not been called since <br>
+* POST-CONDITION: The copied samples are played after the queued ones.<br>
+* @param Samples is the samples to queue
+* @param Count is the number of samples
+* @return The number of samples queued
+*
+* \b Example:
+* @code
+* Sent += Dio_PatternFill(&Wave[Sent], Total - Sent);
+* @endcode
+* @see Dio_PatternPlay
+**********************************************************************/
+uint16_t
+Dio_PatternFill(const DioPortValue_t * const Samples, uint16_t Count)
+{
+  uint16_t Written;
+  uint16_t Free;
+  uint8_t Sreg;
+
+  // The 16-bit counters are accessed in two halves, keep the tick out
+  DIO_CRITICAL_ENTER(Sreg);
+  Written = Dio_PatternWritten;
+  Free = (uint16_t)(Dio_PatternLength - (uint16_t)(Written - Dio_PatternRead));
+  DIO_CRITICAL_EXIT(Sreg);
+
+  if(Count > Free)
+    {
+      Count = Free;
+    }
+
+  for (uint16_t Sample = 0; Sample < Count; Sample++)
+    {
+      Dio_PatternBuffer[Dio_PatternWriteIndex] = Samples[Sample];
+      Dio_PatternWriteIndex++;
+      if(Dio_PatternWriteIndex == Dio_PatternLength)
+        {
+          Dio_PatternWriteIndex = 0;
+        }
+    }
+
+  // The samples are published only after they are copied
+  DIO_CRITICAL_ENTER(Sreg);
+  Dio_PatternWritten = (uint16_t)(Written + Count);
+  DIO_CRITICAL_EXIT(Sreg);
+
+  return Count;
+}
+
+/*********************************************************************
+* Function : Dio_PatternEnd()
+*//**
+* \b Description:
+* This function is used to mark the end of the pattern: the playback<br>
+* stops after the queued samples, without counting an underrun.<br>
+* PRE-CONDITION: Dio_PatternPlay has been called <br>
+* POST-CONDITION: Dio_PatternIsPlaying returns zero once the queued<br>
+* samples have been played.<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_PatternPlay(DIO_PORTB, 0xFF, Frame, 16, 4);
+* Dio_PatternEnd();
+* while(Dio_PatternIsPlaying()) { }
+* @endcode
+* @see Dio_PatternIsPlaying
+**********************************************************************/
+void
+Dio_PatternEnd(void)
+{
+  Dio_PatternEnding = 1;
+}
+
+/*********************************************************************
+* Function : Dio_PatternStop()
+*//**
+* \b Description:
+* This function is used to stop the playback at once. The channels keep<br>
+* the last sample played.<br>
+* POST-CONDITION: No sample is played until the next Dio_PatternPlay.<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_PatternStop();
+* @endcode
+* @see Dio_PatternPlay
+**********************************************************************/
+void
+Dio_PatternStop(void)
+{
+  Dio_PatternPlaying = 0;
+}
+
+/*********************************************************************
+* Function : Dio_PatternIsPlaying()
+*//**
+* \b Description:
+* This function is used to know whether the pattern is playing.<br>
+* @return 1 while the pattern plays, else 0
+*
+* \b Example:
+* @code
+* while(Dio_PatternIsPlaying()) { }
+* @endcode
+* @see Dio_PatternEnd
+**********************************************************************/
+uint8_t
+Dio_PatternIsPlaying(void)
+{
+  return Dio_PatternPlaying;
+}
+
+/*********************************************************************
+* Function : Dio_PatternUnderrunsGet()
+*//**
+* \b Description:
+* This function is used to get the number of samples that were due while<br>
+* the ring was empty since Dio_PatternPlay.<br>
+* @return The number of underruns
+*
+* \b Example:
+* @code
+* if(Dio_PatternUnderrunsGet() != 0) { ... }
+* @endcode
+* @see Dio_PatternFill
+**********************************************************************/
+uint16_t
+Dio_PatternUnderrunsGet(void)
+{
+  uint16_t Underruns;
+  uint8_t Sreg;
+
+  DIO_CRITICAL_ENTER(Sreg);
+  Underruns = Dio_PatternUnderruns;
+  DIO_CRITICAL_EXIT(Sreg);
+
+  return Underruns;
+}
+
+/*********************************************************************
+* Function : Dio_PatternTick()
+*//**
+* \b Description:
+* This function is used to advance the pattern playback by one tick.<br>
+* Every Period ticks the next sample is written to the masked channels<br>
+* with one Dio_PortWriteMaskedIsr. The other ticks only count down.<br>
+* PRE-CONDITION: Called from a periodic timer interrupt <br>
+* POST-CONDITION: The due sample is played, or an underrun is counted.<br>
+* @return void
+*
+* \b Example:
+* @code
+* ISR(TIMER0_COMPA_vect)
+* {
+*   Dio_PatternTick();
+* }
+* @endcode
+* @see Dio_PatternPlay
+**********************************************************************/
+void
+Dio_PatternTick(void)
+{
+  if(Dio_PatternPlaying == 0)
+    {
+      return;
+    }
+
+  Dio_PatternCountdown--;
+  if(Dio_PatternCountdown != 0)
+    {
+      return;
+    }
+  Dio_PatternCountdown = Dio_PatternPeriod;
+
+  if(Dio_PatternRead == Dio_PatternWritten)
+    {
+      if(Dio_PatternEnding != 0)
+        {
+          Dio_PatternPlaying = 0;
+        }
+      else
+        {
+          Dio_PatternUnderruns++;
+        }
+      return;
+    }
+
+  Dio_PortWriteMaskedIsr(Dio_PatternPort, Dio_PatternMask,
+                         Dio_PatternBuffer[Dio_PatternReadIndex]);
+
+  Dio_PatternReadIndex++;
+  if(Dio_PatternReadIndex == Dio_PatternLength)
+    {
+      Dio_PatternReadIndex = 0;
+    }
+  Dio_PatternRead++;
+}
+/*************** END OF FUNCTIONS ********************************/
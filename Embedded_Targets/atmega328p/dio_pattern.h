@@ -0,0 +1,43 @@
+/**
+ * @file dio_pattern.h
+ * @author Mohamed Hassanin
+ * @brief The interface definition for the dio pattern playback.
+ * A pattern is a stream of port values played out on the masked channels
+ * of a port, one sample every Period ticks, from a ring buffer owned by
+ * the application. The tick writes each sample with a single masked
+ * write to the port, while the producer refills the ring with
+ * Dio_PatternFill. A sample that is due while the ring is empty is an
+ * underrun: the port keeps its value and the underrun is counted.
+ * @version 0.1
+ * @date 2021-01-12
+*/
+#ifndef DIO_PATTERN_H_
+#define DIO_PATTERN_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_cfg.h" /**< For dio configuration */
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void Dio_PatternPlay(DioPort_t Port, DioPortValue_t Mask,
+                     DioPortValue_t * const Buffer, uint16_t Length,
+                     uint16_t Period);
+uint16_t Dio_PatternFill(const DioPortValue_t * const Samples, uint16_t Count);
+void Dio_PatternEnd(void);
+void Dio_PatternStop(void);
+uint8_t Dio_PatternIsPlaying(void);
+uint16_t Dio_PatternUnderrunsGet(void);
+void Dio_PatternTick(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* DIO_PATTERN_H_*/
+/*************** END OF FILE ********************************/
@@ -0,0 +1,107 @@
+/** 
+ * @file dio_pin.h
+ * @author Mohamed Hassanin
+ * @brief Compile-time channel access for the dio.
+ * This header resolves a constant DioChannel_t to its register address and
+ * bit at compile time, so that with optimization enabled (-Os, -O2) every
+ * access reduces to one or two instructions instead of a call into dio.c:
+ * - DIO_PIN_HIGH / DIO_PIN_LOW: sbi / cbi on PORTx
+ * - DIO_PIN_OUTPUT / DIO_PIN_INPUT: sbi / cbi on DDRx
+ * - DIO_PIN_READ: sbis / sbic on PINx (or in + bit test)
+ * - DIO_PIN_TOGGLE: ldi + out on PINx, the hardware toggles PORTx
+ * The single instruction accesses (sbi, cbi) are atomic, they are safe
+ * against ISRs writing the same port without a critical section. A channel
+ * that is only known at run time goes through Dio_ChannelWriteAtomic and
+ * Dio_SetChannelDirectionAtomic instead.
+ * The channels are the same DioChannel_t used by dio.h, so both interfaces
+ * can be mixed on the same port.
+ * @version 0.1
+ * @date 2021-01-12
+*/
+#ifndef DIO_PIN_H_
+#define DIO_PIN_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio.h" /**< For the dio definitions */
+#include "dio_memmap.h" /**< For Hardware definitions */
+/**********************************************************************
+* Preprocessor Macros
+**********************************************************************/
+/**
+* Pointers to the registers of the port of a channel.
+*/
+#define DIO_PIN_REG(Channel) \
+  ((volatile uint8_t *)DIO_PIN_ADDRESS((Channel) / DIO_CHANNELS_PER_PORT))
+#define DIO_DDR_REG(Channel) \
+  ((volatile uint8_t *)DIO_DDR_ADDRESS((Channel) / DIO_CHANNELS_PER_PORT))
+#define DIO_PORT_REG(Channel) \
+  ((volatile uint8_t *)DIO_PORT_ADDRESS((Channel) / DIO_CHANNELS_PER_PORT))
+/**
+* The bit of a channel in its port registers.
+*/
+#define DIO_PIN_BIT(Channel) \
+  ((uint8_t)(1U << ((Channel) % DIO_CHANNELS_PER_PORT)))
+
+#define DIO_PIN_HIGH(Channel) \
+  DIO_REG_WRITE(DIO_PORT_REG(Channel), DIO_REG_READ(DIO_PORT_REG(Channel)) | DIO_PIN_BIT(Channel))
+#define DIO_PIN_LOW(Channel) \
+  DIO_REG_WRITE(DIO_PORT_REG(Channel), DIO_REG_READ(DIO_PORT_REG(Channel)) & (uint8_t)~DIO_PIN_BIT(Channel))
+#define DIO_PIN_WRITE(Channel, State) \
+  (((State) == DIO_STATE_HIGH) ? DIO_PIN_HIGH(Channel) : DIO_PIN_LOW(Channel))
+#define DIO_PIN_READ(Channel) \
+  ((DIO_REG_READ(DIO_PIN_REG(Channel)) & DIO_PIN_BIT(Channel)) ? DIO_STATE_HIGH : DIO_STATE_LOW)
+#define DIO_PIN_TOGGLE(Channel) \
+  DIO_REG_WRITE(DIO_PIN_REG(Channel), DIO_PIN_BIT(Channel))
+
+#define DIO_PIN_OUTPUT(Channel) \
+  DIO_REG_WRITE(DIO_DDR_REG(Channel), DIO_REG_READ(DIO_DDR_REG(Channel)) | DIO_PIN_BIT(Channel))
+#define DIO_PIN_INPUT(Channel) \
+  DIO_REG_WRITE(DIO_DDR_REG(Channel), DIO_REG_READ(DIO_DDR_REG(Channel)) & (uint8_t)~DIO_PIN_BIT(Channel))
+#define DIO_PIN_DIRECTION(Channel, Direction) \
+  (((Direction) == DIO_DIR_OUTPUT) ? DIO_PIN_OUTPUT(Channel) : DIO_PIN_INPUT(Channel))
+
+#ifdef __cplusplus
+/**********************************************************************
+* Class Templates
+**********************************************************************/
+namespace Dio
+{
+/**
+* Defines a channel resolved at compile time. The class holds no data,
+* every member expands to the DIO_PIN_* macro of the channel.
+*
+* \b Example:
+* @code
+* typedef Dio::Pin<PORTB_5> Led;
+* Led::Output();
+* Led::Toggle();
+* Dio_ChannelWrite(Led::Channel, DIO_STATE_LOW); // Same pin through dio.h
+* @endcode
+*/
+template <DioChannel_t PinChannel>
+struct Pin
+{
+  static_assert(PinChannel < DIO_CHANNEL_MAX, "Channel is not on this device");
+
+  static const DioChannel_t Channel = PinChannel; /**< The I/O pin */
+
+  static inline void High(void) { DIO_PIN_HIGH(PinChannel); }
+  static inline void Low(void) { DIO_PIN_LOW(PinChannel); }
+  static inline void Write(DioState_t State) { DIO_PIN_WRITE(PinChannel, State); }
+  static inline DioState_t Read(void) { return DIO_PIN_READ(PinChannel); }
+  static inline void Toggle(void) { DIO_PIN_TOGGLE(PinChannel); }
+
+  static inline void Output(void) { DIO_PIN_OUTPUT(PinChannel); }
+  static inline void Input(void) { DIO_PIN_INPUT(PinChannel); }
+  static inline void SetDirection(DioDirection_t Direction)
+  {
+    DIO_PIN_DIRECTION(PinChannel, Direction);
+  }
+};
+} // namespace Dio
+#endif
+
+#endif /* DIO_PIN_H_*/
+/*************** END OF FILE ********************************/
@@ -11,43 +11,205 @@
 #include <inttypes.h>
 #include "dio.h" /* For this modules definitions */
 #include "dio_memmap.h" /* For Hardware definitions */
+#include "dio_inline.h" /* For the port register tables */
 /**********************************************************************
-* Module Variable Definitions
+* Preprocessor Macros
 **********************************************************************/
 /**
-* Defines a table of pointers to the peripheral input register on the
-* microcontroller.
+* Initializer of the channel lookup table entry of a channel.
 */
-static const volatile uint8_t * const Dio_PortsIn[DIO_NUMBER_OF_PORTS] =
-{ 
-  (volatile uint8_t*)PINA,
-  (volatile uint8_t*)PINB,
-  (volatile uint8_t*)PINC,
-  (volatile uint8_t*)PIND
-};
+#define DIO_CHANNEL_MAP(Channel) \
+  { (uint8_t)DIO_CHANNEL_PORT(Channel), DIO_CHANNEL_MASK(Channel) }
+/**
+* Fetches the port and the mask of a channel from the channel lookup table.
+*/
+#if DIO_CHANNEL_MAP_FLASH == STD_ON
+#define DIO_CHANNEL_MAP_SECTION DIO_FLASH
+#define DIO_CHANNEL_MAP_PORT(Channel) \
+  DIO_FLASH_READ_BYTE(&Dio_ChannelMap[(Channel)].Port)
+#define DIO_CHANNEL_MAP_MASK(Channel) \
+  ((DioPortValue_t)DIO_FLASH_READ_BYTE(&Dio_ChannelMap[(Channel)].Mask))
+#else
+#define DIO_CHANNEL_MAP_SECTION
+#define DIO_CHANNEL_MAP_PORT(Channel) (Dio_ChannelMap[(Channel)].Port)
+#define DIO_CHANNEL_MAP_MASK(Channel) (Dio_ChannelMap[(Channel)].Mask)
+#endif
+#if DIO_INSTRUMENT == STD_ON
+/**
+* Counts a call of an API entry point, the register accesses that follow
+* are counted for it.
+*/
+#define DIO_STATS_CALL(Api) \
+  (Dio_StatsApi = (Api), Dio_Stats.ApiCalls[(Api)]++)
+/**
+* Counts a call for a channel.
+*/
+#define DIO_STATS_CHANNEL(Channel) (Dio_Stats.ChannelCalls[(Channel)]++)
+/**
+* Accesses a register of Port, counted for the port and the current API.
+*/
+#define DIO_READ(Port, Register) \
+  (Dio_Stats.PortAccess[(Port)].Reads++, \
+   Dio_Stats.ApiAccess[Dio_StatsApi].Reads++, DIO_REG_READ(Register))
+#define DIO_WRITE(Port, Register, Value) \
+  (Dio_Stats.PortAccess[(Port)].Writes++, \
+   Dio_Stats.ApiAccess[Dio_StatsApi].Writes++, DIO_REG_WRITE((Register), (Value)))
+#else
+#define DIO_STATS_CALL(Api) ((void)0)
+#define DIO_STATS_CHANNEL(Channel) ((void)0)
+#define DIO_READ(Port, Register) DIO_REG_READ(Register)
+#define DIO_WRITE(Port, Register, Value) DIO_REG_WRITE((Register), (Value))
+#endif
+/**
+* The mask of all the channels of a port.
+*/
+#define DIO_PORT_ALL ((DioPortValue_t)~(DioPortValue_t)0)
 /**
-* Defines a table of pointers to the peripheral data direction register
-on
-* the microcontroller.
+* Replaces the channels of Mask in a port register with Bits, a subset of
+* Mask, by a read-modify-write.
 */
-static uint8_t volatile * const Dio_PortsDir[DIO_NUMBER_OF_PORTS] =
+#define DIO_UPDATE_PLAIN(Port, Register, Mask, Bits) \
+  DIO_WRITE((Port), (Register), \
+            (DioPortValue_t)((DIO_READ((Port), (Register)) & ~(Mask)) | (Bits)))
+/**
+* The same with the interrupts disabled, so that a write of an ISR to the
+* register cannot be lost between the read and the write. Register, Mask
+* and Bits are computed before the critical section, which compiles to
+* in Sreg, SREG / cli / ld / and / or / st / out SREG, Sreg. The
+* interrupts are disabled from the cli to the out that restores SREG:
+* 5 instructions and 7 cycles (ld and st take 2 cycles, and, or and out
+* take 1), 4 instructions and 6 cycles for a channel, whose Bits of 0 or
+* Mask leave only the and or the or. The counts are the timings of the
+* AVR instruction set for the sequence, without DIO_INSTRUMENT, whose
+* counters add to it. dio_bench budgets the 2 register accesses of the
+* window (masked_per_op), so that one more access in it fails the run.
+*/
+#define DIO_UPDATE_ATOMIC(Port, Register, Mask, Bits) \
+  do { \
+    uint8_t Sreg; /* Saved interrupt state */ \
+    DIO_CRITICAL_ENTER(Sreg); \
+    DIO_UPDATE_PLAIN((Port), (Register), (Mask), (Bits)); \
+    DIO_CRITICAL_EXIT(Sreg); \
+  } while (0)
+/**
+* The read-modify-write of the default API.
+*/
+#if DIO_ATOMIC == STD_ON
+#define DIO_UPDATE(Port, Register, Mask, Bits) \
+  DIO_UPDATE_ATOMIC((Port), (Register), (Mask), (Bits))
+#else
+#define DIO_UPDATE(Port, Register, Mask, Bits) \
+  DIO_UPDATE_PLAIN((Port), (Register), (Mask), (Bits))
+#endif
+#if DIO_SHADOW == STD_ON
+/**
+* While a batch is open, records a write of the masked channels of a port
+* in a shadow register and returns from the calling function.
+*/
+#define DIO_BATCH_RETURN(Shadow, Port, Mask, Bits) \
+  do { \
+    if(Dio_BatchDepth != 0) \
+      { \
+        (Shadow)[(Port)].Data = (DioPortValue_t) \
+          (((Shadow)[(Port)].Data & ~(Mask)) | ((Bits) & (Mask))); \
+        (Shadow)[(Port)].Dirty |= (Mask); \
+        return; \
+      } \
+  } while (0)
+#else
+#define DIO_BATCH_RETURN(Shadow, Port, Mask, Bits) ((void)0)
+#endif
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+* Defines an entry of the channel lookup table.
+*/
+typedef struct
 {
-  (volatile uint8_t*)DDRA,
-  (volatile uint8_t*)DDRB,
-  (volatile uint8_t*)DDRC,
-  (volatile uint8_t*)DDRD
-};
+  uint8_t Port; /**< The port index of the channel */
+  DioPortValue_t Mask; /**< The bit of the channel in its port registers */
+}DioChannelMap_t;
 
+#if DIO_SHADOW == STD_ON
 /**
-* Defines a table of pointers to the Port Data Output Register
+* Defines a shadow register: the bits written during the batch and the
+* channels they cover.
 */
-static uint8_t volatile * const Dio_PortsOut[DIO_NUMBER_OF_PORTS] =
+typedef struct
 {
-  (volatile uint8_t*)PORTA,
-  (volatile uint8_t*)PORTB,
-  (volatile uint8_t*)PORTC,
-  (volatile uint8_t*)PORTD
+  DioPortValue_t Data; /**< The written bits */
+  DioPortValue_t Dirty; /**< The channels written since the last commit */
+}DioShadow_t;
+#endif
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* Defines the channel lookup table, indexed by DioChannel_t. It is resolved
+* at build time so that a channel access costs one table fetch instead of
+* a divide, a modulo and a shift loop.
+*/
+static const DioChannelMap_t Dio_ChannelMap[DIO_CHANNEL_MAX] DIO_CHANNEL_MAP_SECTION =
+{
+  DIO_CHANNEL_MAP(PORTA_0),
+  DIO_CHANNEL_MAP(PORTA_1),
+  DIO_CHANNEL_MAP(PORTA_2),
+  DIO_CHANNEL_MAP(PORTA_3),
+  DIO_CHANNEL_MAP(PORTA_4),
+  DIO_CHANNEL_MAP(PORTA_5),
+  DIO_CHANNEL_MAP(PORTA_6),
+  DIO_CHANNEL_MAP(PORTA_7),
+  DIO_CHANNEL_MAP(PORTB_0),
+  DIO_CHANNEL_MAP(PORTB_1),
+  DIO_CHANNEL_MAP(PORTB_2),
+  DIO_CHANNEL_MAP(PORTB_3),
+  DIO_CHANNEL_MAP(PORTB_4),
+  DIO_CHANNEL_MAP(PORTB_5),
+  DIO_CHANNEL_MAP(PORTB_6),
+  DIO_CHANNEL_MAP(PORTB_7),
+  DIO_CHANNEL_MAP(PORTC_0),
+  DIO_CHANNEL_MAP(PORTC_1),
+  DIO_CHANNEL_MAP(PORTC_2),
+  DIO_CHANNEL_MAP(PORTC_3),
+  DIO_CHANNEL_MAP(PORTC_4),
+  DIO_CHANNEL_MAP(PORTC_5),
+  DIO_CHANNEL_MAP(PORTC_6),
+  DIO_CHANNEL_MAP(PORTC_7),
+  DIO_CHANNEL_MAP(PORTD_0),
+  DIO_CHANNEL_MAP(PORTD_1),
+  DIO_CHANNEL_MAP(PORTD_2),
+  DIO_CHANNEL_MAP(PORTD_3),
+  DIO_CHANNEL_MAP(PORTD_4),
+  DIO_CHANNEL_MAP(PORTD_5),
+  DIO_CHANNEL_MAP(PORTD_6),
+  DIO_CHANNEL_MAP(PORTD_7)
 };
+
+#if DIO_SHADOW == STD_ON
+/**
+* The shadow registers of the data output and data direction registers of
+* each port.
+*/
+static DioShadow_t Dio_ShadowOut[DIO_NUMBER_OF_PORTS];
+static DioShadow_t Dio_ShadowDir[DIO_NUMBER_OF_PORTS];
+
+/**
+* The nesting depth of the open batches, 0 outside a batch.
+*/
+static uint8_t Dio_BatchDepth;
+#endif
+#if DIO_INSTRUMENT == STD_ON
+/**
+* Holds the call and register access counters of the module.
+*/
+static DioStats_t Dio_Stats;
+
+/**
+* The API entry point that owns the register accesses being counted.
+*/
+static DioApi_t Dio_StatsApi;
+#endif
 /**********************************************************************
 * Function Definitions
 **********************************************************************/
@@ -76,36 +238,175 @@ static uint8_t volatile * const Dio_PortsOut[DIO_NUMBER_OF_PORTS] =
 void 
 Dio_Init(const DioConfig_t * Config)
 {
+  DioPortValue_t Configured[DIO_NUMBER_OF_PORTS] = { 0 }; // Channels in the table
+  DioPortValue_t Direction[DIO_NUMBER_OF_PORTS] = { 0 }; // Output channels
+  DioPortValue_t Data[DIO_NUMBER_OF_PORTS] = { 0 }; // Outputs driven high, pulled up inputs
+  DioPortValue_t Mask = 0; // Pin Mask
   uint8_t PortNumber = 0; // Port Number
-  uint8_t Position = 0; // Pin Number
 
-  // Loop through all pins, set the data register bit and the data-direction
-  // register bit according to the dio configuration table values
-  for (uint8_t i = 0; i < DIO_CHANNEL_MAX; i++)
+  DIO_STATS_CALL(DIO_API_INIT);
+
+  // Fold the dio configuration table into per-port masks so that every
+  // register is accessed once instead of once per channel
+  for (uint16_t i = 0; i < DIO_CHANNEL_MAX; i++)
     {
-      PortNumber = Config[i].Channel / DIO_CHANNELS_PER_PORT;
-      Position = Config[i].Channel % DIO_CHANNELS_PER_PORT;
+      PortNumber = DIO_CHANNEL_MAP_PORT(Config[i].Channel);
+      Mask = DIO_CHANNEL_MAP_MASK(Config[i].Channel);
+
+      Configured[PortNumber] |= Mask;
+      DIO_STATS_CHANNEL(Config[i].Channel);
 
       if(Config[i].Direction == DIO_DIR_OUTPUT)
         {
-          *Dio_PortsDir[PortNumber] |= 1UL << Position;
+          Direction[PortNumber] |= Mask;
 
           if(Config[i].Data == DIO_STATE_HIGH)
             {
-              *Dio_PortsOut[PortNumber] |= (1UL << Position);
-            }
-          else
-            {
-              *Dio_PortsOut[PortNumber] &= ~(1UL << Position);
+              Data[PortNumber] |= Mask;
             }
         }
-      else
+      else if(Config[i].Pullup == DIO_PULLUP_ENABLED)
         {
-          *Dio_PortsDir[PortNumber] &= ~(1UL << Position);
+          Data[PortNumber] |= Mask;
+        }
+    }
+
+  // Commit the masks, the data register is written before the data-direction
+  // register so that outputs are driven at their configured level as soon as
+  // they are enabled. The data register bit of an input is its pull-up, so
+  // pull-ups are applied in the same pass.
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      if(Configured[Port] != 0)
+        {
+          DIO_WRITE(Port, Dio_PortsOut[Port],
+                    (DIO_READ(Port, Dio_PortsOut[Port]) & ~Configured[Port]) | Data[Port]);
+          DIO_WRITE(Port, Dio_PortsDir[Port],
+                    (DIO_READ(Port, Dio_PortsDir[Port]) & ~Configured[Port]) | Direction[Port]);
         }
     }
 }
 
+/*********************************************************************
+* Function : Dio_InitPorts()
+*//**
+* \b Description:
+* This function is used to initialize the Dio from the packed<br>
+* configuration defined in dio_cfg module. Each port is set up with one<br>
+* write of its data register and one write of its data-direction<br>
+* register, without reading them: the work is O(ports) and every channel<br>
+* of a port takes its configured state. The data register is written<br>
+* first, so that outputs are driven at their configured level as soon as<br>
+* they are enabled.<br>
+* PRE-CONDITION: The packed configuration has DIO_NUMBER_OF_PORTS rows <br>
+* PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
+* POST-CONDITION: The DIO peripheral is set up with the configuration settings.<br>
+* @param Config is a pointer to the packed configuration, indexed by
+* DioPort_t.
+* @return void
+*
+* \b Example:
+* @code
+* Dio_InitPorts(Dio_PortConfigGet());
+* @endcode
+* @see Dio_PortConfigGet
+**********************************************************************/
+void
+Dio_InitPorts(const DioPortConfig_t * const Config)
+{
+  DIO_STATS_CALL(DIO_API_INIT_PORTS);
+
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      DIO_WRITE(Port, Dio_PortsOut[Port], Config[Port].Data | Config[Port].Pullup);
+      DIO_WRITE(Port, Dio_PortsDir[Port], Config[Port].Direction);
+    }
+}
+
+/*********************************************************************
+* Function : Dio_ApplyProfile()
+*//**
+* \b Description:
+* This function is used to switch the Dio to a pin configuration profile<br>
+* of the dio_cfg module. The data and data-direction registers of each<br>
+* port are read and compared with the profile, and only the registers<br>
+* that differ are written, once each. The order of the writes avoids<br>
+* glitches: outputs released to INPUT at a new level are released before<br>
+* the data register changes, and inputs enabled as OUTPUT are enabled<br>
+* after it, so no pin is ever driven at a level that is neither its old<br>
+* nor its new one. A port that does both takes one extra direction write.<br>
+* With DIO_ATOMIC the reads and the writes of each port run in a critical<br>
+* section, so that an ISR writing the port cannot be overwritten by the<br>
+* data read before it.<br>
+* PRE-CONDITION: Id < DIO_PROFILE_MAX <br>
+* PRE-CONDITION: No batch is open, the profile is written to the ports <br>
+* POST-CONDITION: Every channel is in the state of the profile.<br>
+* @param Id is the profile to apply
+* @return void
+*
+* \b Example:
+* @code
+* Dio_ApplyProfile(DIO_PROFILE_SLEEP);
+* Sleep_Enter();
+* @endcode
+* @see Dio_ProfileConfigGet
+**********************************************************************/
+void
+Dio_ApplyProfile(DioProfileId_t Id)
+{
+  const DioPortConfig_t * Profile;
+
+  DIO_STATS_CALL(DIO_API_APPLY_PROFILE);
+
+  if(Id >= DIO_PROFILE_MAX)
+    {
+      //TODO: implement your error handling method
+      return;
+    }
+#if DIO_SHADOW == STD_ON
+  if(Dio_BatchDepth != 0)
+    {
+      //TODO: implement your error handling method
+      return;
+    }
+#endif
+  Profile = Dio_ProfileConfigGet(Id);
+
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      const DioPortValue_t Data = Profile[Port].Data | Profile[Port].Pullup;
+      DioPortValue_t Changed;
+      DioPortValue_t Direction;
+      DioPortValue_t Released; // The outputs that become inputs at a new level
+#if DIO_ATOMIC == STD_ON
+      uint8_t Sreg; // Saved interrupt state
+
+      DIO_CRITICAL_ENTER(Sreg);
+#endif
+      Changed = DIO_READ(Port, Dio_PortsOut[Port]) ^ Data;
+      Direction = DIO_READ(Port, Dio_PortsDir[Port]);
+      Released = Direction & ~Profile[Port].Direction & Changed;
+
+      if(Released != 0)
+        {
+          Direction &= ~Released;
+          DIO_WRITE(Port, Dio_PortsDir[Port], Direction);
+        }
+      if(Changed != 0)
+        {
+          DIO_WRITE(Port, Dio_PortsOut[Port], Data);
+        }
+      if(Direction != Profile[Port].Direction)
+        {
+          DIO_WRITE(Port, Dio_PortsDir[Port], Profile[Port].Direction);
+        }
+#if DIO_ATOMIC == STD_ON
+      DIO_CRITICAL_EXIT(Sreg);
+#endif
+    }
+}
+
+#if DIO_INLINE == STD_OFF
 /**********************************************************************
 * Function : Dio_ChannelRead()
 *//**
@@ -127,12 +428,15 @@ Dio_Init(const DioConfig_t * Config)
 DioState_t 
 Dio_ChannelRead(DioChannel_t Channel)
 {
-  /* Read the port associated with the desired pin */
-  DioState_t PortState = (DioState_t)*Dio_PortsIn[Channel / DIO_CHANNELS_PER_PORT];
-  /* Determine the port bit associated with this channel */
-  DioState_t PinMask = (DioState_t)(1UL << (Channel % DIO_CHANNELS_PER_PORT));
+  uint8_t PortNumber = DIO_CHANNEL_MAP_PORT(Channel); // Port Number
+  DioPortValue_t PinMask = DIO_CHANNEL_MAP_MASK(Channel); // Pin Mask
+
+  DIO_STATS_CALL(DIO_API_CHANNEL_READ);
+  DIO_STATS_CHANNEL(Channel);
+
   /* Mask the port state with the pin and return the DioPinState */
-  return ((PortState & PinMask) ? DIO_STATE_HIGH : DIO_STATE_LOW);
+  return ((DIO_READ(PortNumber, Dio_PortsIn[PortNumber]) & PinMask)
+          ? DIO_STATE_HIGH : DIO_STATE_LOW);
 }
 
 /**********************************************************************
@@ -160,13 +464,22 @@ Dio_ChannelRead(DioChannel_t Channel)
 void 
 Dio_ChannelWrite(DioChannel_t Channel, DioState_t State)
 {
+  uint8_t PortNumber = DIO_CHANNEL_MAP_PORT(Channel); // Port Number
+  DioPortValue_t PinMask = DIO_CHANNEL_MAP_MASK(Channel); // Pin Mask
+  uint8_t volatile * const Register = Dio_PortsOut[PortNumber];
+
+  DIO_STATS_CALL(DIO_API_CHANNEL_WRITE);
+  DIO_STATS_CHANNEL(Channel);
+  DIO_BATCH_RETURN(Dio_ShadowOut, PortNumber, PinMask,
+                   (State == DIO_STATE_HIGH) ? PinMask : 0);
+
   if (State == DIO_STATE_HIGH)
     {
-      *Dio_PortsOut[Channel/DIO_CHANNELS_PER_PORT] |= (1UL<<(Channel % DIO_CHANNELS_PER_PORT));
+      DIO_UPDATE(PortNumber, Register, PinMask, PinMask);
     }
   else
     {
-      *Dio_PortsOut[Channel/DIO_CHANNELS_PER_PORT] &= ~(1UL<<(Channel % DIO_CHANNELS_PER_PORT));
+      DIO_UPDATE(PortNumber, Register, PinMask, 0);
     }
 }
 
@@ -189,17 +502,586 @@ Dio_ChannelWrite(DioChannel_t Channel, DioState_t State)
 void 
 Dio_SetChannelDirection(DioChannel_t Channel, DioDirection_t Direction)
 {
-  uint16_t PortNumber = Channel / DIO_CHANNELS_PER_PORT;
-  uint16_t Position = Channel % DIO_CHANNELS_PER_PORT;
+  uint8_t PortNumber = DIO_CHANNEL_MAP_PORT(Channel); // Port Number
+  DioPortValue_t PinMask = DIO_CHANNEL_MAP_MASK(Channel); // Pin Mask
+  uint8_t volatile * const Register = Dio_PortsDir[PortNumber];
+
+  DIO_STATS_CALL(DIO_API_SET_CHANNEL_DIRECTION);
+  DIO_STATS_CHANNEL(Channel);
+  DIO_BATCH_RETURN(Dio_ShadowDir, PortNumber, PinMask,
+                   (Direction == DIO_DIR_OUTPUT) ? PinMask : 0);
+
+  if(Direction == DIO_DIR_OUTPUT)
+    {
+      DIO_UPDATE(PortNumber, Register, PinMask, PinMask);
+    }
+  else
+    {
+      DIO_UPDATE(PortNumber, Register, PinMask, 0);
+    }
+}
+#endif
+
+/**********************************************************************
+* Function : Dio_ChannelWriteAtomic()
+*//**
+* \b Description:
+* This function is used to write the state of a channel (pin) like<br>
+* Dio_ChannelWrite, with the read-modify-write of the port register in a<br>
+* critical section, so that it is safe against ISRs writing the same<br>
+* port. The interrupts are only disabled for the read-modify-write: ld,<br>
+* or (and to clear), st and the out that restores SREG, 4 instructions<br>
+* and 6 cycles. While a batch is open, the write is recorded in the<br>
+* shadow like Dio_ChannelWrite.<br>
+* PRE-CONDITION: The channel is configured as OUTPUT <br>
+* PRE-CONDITION: The channel is within the maximum DioChannel_t definition <br>
+* POST-CONDITION: The channel state will be State <br>
+* @param Channel is the pin to write using the DioChannel_t enum definition <br>
+* @param State is HIGH or LOW as defined in the DioState_t enum <br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_ChannelWriteAtomic(PORTA_5, DIO_STATE_HIGH); // The timer ISR drives the port too
+* @endcode
+* @see Dio_ChannelWrite
+**********************************************************************/
+void
+Dio_ChannelWriteAtomic(DioChannel_t Channel, DioState_t State)
+{
+  uint8_t PortNumber = DIO_CHANNEL_MAP_PORT(Channel); // Port Number
+  DioPortValue_t PinMask = DIO_CHANNEL_MAP_MASK(Channel); // Pin Mask
+  uint8_t volatile * const Register = Dio_PortsOut[PortNumber];
+
+  DIO_STATS_CALL(DIO_API_CHANNEL_WRITE);
+  DIO_STATS_CHANNEL(Channel);
+  DIO_BATCH_RETURN(Dio_ShadowOut, PortNumber, PinMask,
+                   (State == DIO_STATE_HIGH) ? PinMask : 0);
+
+  if (State == DIO_STATE_HIGH)
+    {
+      DIO_UPDATE_ATOMIC(PortNumber, Register, PinMask, PinMask);
+    }
+  else
+    {
+      DIO_UPDATE_ATOMIC(PortNumber, Register, PinMask, 0);
+    }
+}
+
+/**********************************************************************
+* Function : Dio_SetChannelDirectionAtomic()
+*//**
+* \b Description:
+* This function is used to set the direction of a channel like<br>
+* Dio_SetChannelDirection, with the read-modify-write of the direction<br>
+* register in a critical section, so that it is safe against ISRs<br>
+* writing the same port. The interrupts are only disabled for the<br>
+* read-modify-write: ld, or (and for an input), st and the out that<br>
+* restores SREG, 4 instructions and 6 cycles. While a batch is open, the<br>
+* direction is recorded in the shadow like Dio_SetChannelDirection.<br>
+* PRE-CONDITION: The channel is within the maximum DioChannel_t definition <br>
+* POST-CONDITION: The direction of the channel is changed.<br>
+* @param Channel is the pin from the DioChannel_t that is to be modified. <br>
+* @param Direction is INPUT or OUTPUT
+* @return void
+*
+* \b Example:
+* @code
+* Dio_SetChannelDirectionAtomic(PORTA_5, DIO_DIR_OUTPUT);
+* @endcode
+* @see Dio_SetChannelDirection
+**********************************************************************/
+void
+Dio_SetChannelDirectionAtomic(DioChannel_t Channel, DioDirection_t Direction)
+{
+  uint8_t PortNumber = DIO_CHANNEL_MAP_PORT(Channel); // Port Number
+  DioPortValue_t PinMask = DIO_CHANNEL_MAP_MASK(Channel); // Pin Mask
+  uint8_t volatile * const Register = Dio_PortsDir[PortNumber];
+
+  DIO_STATS_CALL(DIO_API_SET_CHANNEL_DIRECTION);
+  DIO_STATS_CHANNEL(Channel);
+  DIO_BATCH_RETURN(Dio_ShadowDir, PortNumber, PinMask,
+                   (Direction == DIO_DIR_OUTPUT) ? PinMask : 0);
+
   if(Direction == DIO_DIR_OUTPUT)
     {
-      *Dio_PortsDir[PortNumber] |= (1UL << Position);
+      DIO_UPDATE_ATOMIC(PortNumber, Register, PinMask, PinMask);
     }
   else
     {
-      *Dio_PortsDir[PortNumber] &= ~(1UL << Position);
+      DIO_UPDATE_ATOMIC(PortNumber, Register, PinMask, 0);
+    }
+}
+
+/**********************************************************************
+* Function : Dio_PortWriteMaskedAtomic()
+*//**
+* \b Description:
+* This function is used to write the channels of a port selected by Mask<br>
+* like Dio_PortWriteMasked, with the read-modify-write of the port<br>
+* register in a critical section, so that it is safe against ISRs writing<br>
+* the other channels of the port. The interrupts are only disabled for<br>
+* the read-modify-write: ld, and, or, st and the out that restores SREG,<br>
+* 5 instructions and 7 cycles. While a batch is open, the write is<br>
+* recorded in the shadow like Dio_PortWriteMasked.<br>
+* PRE-CONDITION: The masked channels are configured as OUTPUT <br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition <br>
+* POST-CONDITION: The masked channels take their bit of Value.<br>
+* @param Port is the DioPort_t that represents the port
+* @param Mask selects the channels to write, bit n for channel n
+* @param Value is the new state of the masked channels
+* @return void
+*
+* \b Example:
+* @code
+* Dio_PortWriteMaskedAtomic(DIO_PORTA, 0x0F, 0x05);
+* @endcode
+* @see Dio_PortWriteMasked
+**********************************************************************/
+void
+Dio_PortWriteMaskedAtomic(DioPort_t Port, DioPortValue_t Mask, DioPortValue_t Value)
+{
+  DIO_STATS_CALL(DIO_API_PORT_WRITE_MASKED);
+  DIO_BATCH_RETURN(Dio_ShadowOut, Port, Mask, Value);
+
+  DIO_UPDATE_ATOMIC(Port, Dio_PortsOut[Port], Mask, Value & Mask);
+}
+
+/**********************************************************************
+* Function : Dio_PortRead()
+*//**
+* \b Description:
+* This function is used to read the state of all the channels of a port<br>
+* with a single access to the port input register.<br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition <br>
+* POST-CONDITION: The port state is returned.<br>
+* @param Port is the DioPort_t that represents the port
+* @return The state of the port, bit n holds the state of channel n.
+*
+* \b Example:
+* @code
+* DioPortValue_t Bus = Dio_PortRead(DIO_PORTD);
+* @endcode
+* @see Dio_ChannelRead
+**********************************************************************/
+DioPortValue_t
+Dio_PortRead(DioPort_t Port)
+{
+  DIO_STATS_CALL(DIO_API_PORT_READ);
+
+  return DIO_READ(Port, Dio_PortsIn[Port]);
+}
+
+/**********************************************************************
+* Function : Dio_PortWrite()
+*//**
+* \b Description:
+* This function is used to write the state of all the channels of a port<br>
+* with a single write to the port data output register.<br>
+* PRE-CONDITION: The port channels are configured as OUTPUT <br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition <br>
+* POST-CONDITION: The port data output register will be Value <br>
+* @param Port is the port to write using the DioPort_t enum definition <br>
+* @param Value is the new state of the port, bit n for channel n <br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_PortWrite(DIO_PORTD, 0xA5);
+* @endcode
+* @see Dio_PortWriteMasked
+**********************************************************************/
+void
+Dio_PortWrite(DioPort_t Port, DioPortValue_t Value)
+{
+  DIO_STATS_CALL(DIO_API_PORT_WRITE);
+  DIO_BATCH_RETURN(Dio_ShadowOut, Port, DIO_PORT_ALL, Value);
+
+  DIO_WRITE(Port, Dio_PortsOut[Port], Value);
+}
+
+/**********************************************************************
+* Function : Dio_PortWriteMasked()
+*//**
+* \b Description:
+* This function is used to write the state of a subset of the channels<br>
+* of a port. Only the channels selected by Mask are changed, with a single<br>
+* read-modify-write of the port data output register.<br>
+* PRE-CONDITION: The masked channels are configured as OUTPUT <br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition <br>
+* POST-CONDITION: The masked channels state will be Value <br>
+* @param Port is the port to write using the DioPort_t enum definition <br>
+* @param Mask selects the channels to modify, bit n for channel n <br>
+* @param Value is the new state of the selected channels <br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_PortWriteMasked(DIO_PORTD, 0x0F, 0x05); // Lower nibble = 0101
+* @endcode
+* @see Dio_PortWrite
+**********************************************************************/
+void
+Dio_PortWriteMasked(DioPort_t Port, DioPortValue_t Mask, DioPortValue_t Value)
+{
+  DIO_STATS_CALL(DIO_API_PORT_WRITE_MASKED);
+  DIO_BATCH_RETURN(Dio_ShadowOut, Port, Mask, Value);
+
+  DIO_UPDATE(Port, Dio_PortsOut[Port], Mask, Value & Mask);
+}
+
+/**********************************************************************
+* Function : Dio_PortWriteMaskedIsr()
+*//**
+* \b Description:
+* This function is used to write the channels of a port selected by Mask<br>
+* like Dio_PortWriteMasked, from an interrupt. The write always goes to<br>
+* the port: an interrupt that runs while the main loop has a batch open<br>
+* is not deferred to its commit, and does not touch the shadow. A channel<br>
+* also written by the open batch takes its batched state at the commit.<br>
+* PRE-CONDITION: The masked channels are configured as OUTPUT <br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition <br>
+* POST-CONDITION: The masked channels state will be Value <br>
+* @param Port is the port to write using the DioPort_t enum definition <br>
+* @param Mask selects the channels to modify, bit n for channel n <br>
+* @param Value is the new state of the selected channels <br>
+* @return void
+*
+* \b Example:
+* @code
+* ISR(TIMER0_COMPA_vect)
+* {
+*   Dio_PortWriteMaskedIsr(DIO_PORTD, 0x0F, Frame);
+* }
+* @endcode
+* @see Dio_PortWriteMasked
+**********************************************************************/
+void
+Dio_PortWriteMaskedIsr(DioPort_t Port, DioPortValue_t Mask, DioPortValue_t Value)
+{
+  DIO_STATS_CALL(DIO_API_PORT_WRITE_MASKED);
+
+  DIO_UPDATE(Port, Dio_PortsOut[Port], Mask, Value & Mask);
+}
+
+/**********************************************************************
+* Function : Dio_GroupRead()
+*//**
+* \b Description:
+* This function is used to read the value of a group of contiguous <br>
+* channels with a single read of the port input register.<br>
+* PRE-CONDITION: The group is within one port <br>
+* POST-CONDITION: The group value is returned.<br>
+* @param Group is the group to read, from the group table of dio_cfg
+* @return The value of the group, bit 0 is the first channel of the group.
+*
+* \b Example:
+* @code
+* DioPortValue_t Nibble = Dio_GroupRead(&Dio_GroupConfigGet()[DIO_GROUP_LCD_DATA]);
+* @endcode
+* @see Dio_GroupWrite
+**********************************************************************/
+DioPortValue_t
+Dio_GroupRead(const DioGroup_t * const Group)
+{
+  DIO_STATS_CALL(DIO_API_GROUP_READ);
+
+  return (DioPortValue_t)((DIO_READ(Group->Port, Dio_PortsIn[Group->Port])
+                           & Group->Mask) >> Group->Shift);
+}
+
+/**********************************************************************
+* Function : Dio_GroupWrite()
+*//**
+* \b Description:
+* This function is used to write the value of a group of contiguous <br>
+* channels with a single read-modify-write of the port data output <br>
+* register. The other channels of the port are not changed.<br>
+* PRE-CONDITION: The group channels are configured as OUTPUT <br>
+* PRE-CONDITION: The group is within one port <br>
+* POST-CONDITION: The group channels state will be Value <br>
+* @param Group is the group to write, from the group table of dio_cfg
+* @param Value is the new value, bit 0 is the first channel of the group.<br>
+* Bits beyond the group width are ignored.
+* @return void
+*
+* \b Example:
+* @code
+* Dio_GroupWrite(&Dio_GroupConfigGet()[DIO_GROUP_LCD_DATA], 0x3);
+* @endcode
+* @see Dio_GroupRead
+**********************************************************************/
+void
+Dio_GroupWrite(const DioGroup_t * const Group, DioPortValue_t Value)
+{
+  DIO_STATS_CALL(DIO_API_GROUP_WRITE);
+  DIO_BATCH_RETURN(Dio_ShadowOut, Group->Port, Group->Mask,
+                   (DioPortValue_t)(Value << Group->Shift));
+
+  DIO_UPDATE(Group->Port, Dio_PortsOut[Group->Port], Group->Mask,
+             (Value << Group->Shift) & Group->Mask);
+}
+
+/**************************************************************************
+* Function : Dio_SetPortDirection()
+*//**
+* \b Description:
+* This function is used to set the direction of all the channels of a <br>
+* port with a single write to the data direction register.<br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition <br>
+* POST-CONDITION: The direction of the port channels is changed.<br>
+* @param Port is the port from the DioPort_t that is to be modified. <br>
+* @param Direction is the new direction, bit n set makes channel n OUTPUT<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_SetPortDirection(DIO_PORTD, 0xFF); // All channels OUTPUT
+* @endcode
+* @see Dio_SetChannelDirection
+**********************************************************************/
+void
+Dio_SetPortDirection(DioPort_t Port, DioPortValue_t Direction)
+{
+  DIO_STATS_CALL(DIO_API_SET_PORT_DIRECTION);
+  DIO_BATCH_RETURN(Dio_ShadowDir, Port, DIO_PORT_ALL, Direction);
+
+  DIO_WRITE(Port, Dio_PortsDir[Port], Direction);
+}
+
+/**************************************************************************
+* Function : Dio_SetPortDirectionMasked()
+*//**
+* \b Description:
+* This function is used to set the direction of a subset of the channels<br>
+* of a port with a single read-modify-write of the data direction register.<br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition <br>
+* POST-CONDITION: The direction of the masked channels is changed.<br>
+* @param Port is the port from the DioPort_t that is to be modified. <br>
+* @param Mask selects the channels to modify, bit n for channel n <br>
+* @param Direction is the new direction, bit n set makes channel n OUTPUT<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_SetPortDirectionMasked(DIO_PORTD, 0xF0, 0xF0); // Upper nibble OUTPUT
+* @endcode
+* @see Dio_SetPortDirection
+**********************************************************************/
+void
+Dio_SetPortDirectionMasked(DioPort_t Port, DioPortValue_t Mask,
+                           DioPortValue_t Direction)
+{
+  DIO_STATS_CALL(DIO_API_SET_PORT_DIRECTION_MASKED);
+  DIO_BATCH_RETURN(Dio_ShadowDir, Port, Mask, Direction);
+
+  DIO_UPDATE(Port, Dio_PortsDir[Port], Mask, Direction & Mask);
+}
+
+/**********************************************************************
+* Function : Dio_SetPortDirectionMaskedIsr()
+*//**
+* \b Description:
+* This function is used to set the direction of the channels of a port<br>
+* selected by Mask like Dio_SetPortDirectionMasked, from an interrupt.<br>
+* The write always goes to the port and does not touch the shadow, like<br>
+* Dio_PortWriteMaskedIsr.<br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition <br>
+* POST-CONDITION: The direction of the masked channels is changed.<br>
+* @param Port is the port from the DioPort_t that is to be modified. <br>
+* @param Mask selects the channels to modify, bit n for channel n <br>
+* @param Direction is the new direction, bit n set makes channel n OUTPUT<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_SetPortDirectionMaskedIsr(DIO_PORTD, 0x0F, 0x00); // Release the rows
+* @endcode
+* @see Dio_SetPortDirectionMasked
+**********************************************************************/
+void
+Dio_SetPortDirectionMaskedIsr(DioPort_t Port, DioPortValue_t Mask,
+                              DioPortValue_t Direction)
+{
+  DIO_STATS_CALL(DIO_API_SET_PORT_DIRECTION_MASKED);
+
+  DIO_UPDATE(Port, Dio_PortsDir[Port], Mask, Direction & Mask);
+}
+
+#if DIO_SHADOW == STD_ON
+/**********************************************************************
+* Function : Dio_ShadowFlush()
+*//**
+* \b Description:
+* Writes the dirty channels of a shadow register to its port register:
+* a plain write when all the channels are dirty, else a single
+* read-modify-write that keeps the other channels.
+**********************************************************************/
+static void
+Dio_ShadowFlush(uint8_t Port, DioPortValue_t volatile * const Register,
+                DioShadow_t * const Shadow)
+{
+  (void)Port; // Counted by the instrumentation only
+
+  if(Shadow->Dirty == DIO_PORT_ALL)
+    {
+      DIO_WRITE(Port, Register, Shadow->Data);
+    }
+  else if(Shadow->Dirty != 0)
+    {
+      DIO_UPDATE(Port, Register, Shadow->Dirty, Shadow->Data & Shadow->Dirty);
+    }
+  Shadow->Dirty = 0;
+}
+
+/**********************************************************************
+* Function : Dio_BeginBatch()
+*//**
+* \b Description:
+* This function is used to open a batch of writes. Until the matching<br>
+* Dio_Commit, the channel, port and group writes and the direction<br>
+* changes of this module only update the shadow registers in RAM, so the<br>
+* pins keep their state and observers never see a partial update. The<br>
+* reads still return the pins. Batches nest, the outermost Dio_Commit<br>
+* writes the ports.<br>
+* PRE-CONDITION: The writes of the batch are made from one context. The<br>
+* interrupts write the ports with Dio_PortWriteMaskedIsr and<br>
+* Dio_SetPortDirectionMaskedIsr, which bypass the shadow <br>
+* PRE-CONDITION: Dio_ApplyProfile is not called while the batch is open <br>
+* POST-CONDITION: The writes are deferred to Dio_Commit.<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_BeginBatch();
+* Dio_ChannelWrite(PORTB_0, DIO_STATE_HIGH);
+* Dio_ChannelWrite(PORTB_1, DIO_STATE_LOW);
+* Dio_SetChannelDirection(PORTB_1, DIO_DIR_OUTPUT);
+* Dio_Commit();
+* @endcode
+* @see Dio_Commit
+**********************************************************************/
+void
+Dio_BeginBatch(void)
+{
+  Dio_BatchDepth++;
+}
+
+/**********************************************************************
+* Function : Dio_Commit()
+*//**
+* \b Description:
+* This function is used to close a batch of writes. Closing the<br>
+* outermost batch writes every dirty register once, the data output<br>
+* register of a port before its data direction register, so that new<br>
+* outputs are driven at their batched level as soon as they are enabled.<br>
+* Registers without batched writes are not accessed.<br>
+* PRE-CONDITION: Dio_BeginBatch has been called <br>
+* POST-CONDITION: The ports hold the batched writes.<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_BeginBatch();
+* Dio_PortWriteMasked(DIO_PORTB, 0x0F, 0x05);
+* Dio_ChannelWrite(PORTB_7, DIO_STATE_HIGH);
+* Dio_Commit(); // One write to the port
+* @endcode
+* @see Dio_BeginBatch
+**********************************************************************/
+void
+Dio_Commit(void)
+{
+  if(Dio_BatchDepth == 0)
+    {
+      //TODO: implement your error handling method
+      return;
+    }
+
+  Dio_BatchDepth--;
+  if(Dio_BatchDepth != 0)
+    {
+      return;
+    }
+
+  DIO_STATS_CALL(DIO_API_COMMIT);
+
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      Dio_ShadowFlush(Port, Dio_PortsOut[Port], &Dio_ShadowOut[Port]);
+      Dio_ShadowFlush(Port, Dio_PortsDir[Port], &Dio_ShadowDir[Port]);
     }
 }
+#endif
+
+#if DIO_INSTRUMENT == STD_ON
+/**********************************************************************
+* Function : Dio_StatsGet()
+*//**
+* \b Description:
+* This function is used to get a snapshot of the instrumentation counters:<br>
+* the calls and register accesses of each API entry point, the register <br>
+* accesses of each port and the calls made for each channel. <br>
+* PRE-CONDITION: DIO_INSTRUMENT is STD_ON <br>
+* POST-CONDITION: Stats holds a copy of the counters.<br>
+* @param Stats receives the counters
+* @return void
+*
+* \b Example:
+* @code
+* DioStats_t Stats;
+* Dio_StatsGet(&Stats);
+* @endcode
+* @see Dio_StatsReset
+**********************************************************************/
+void
+Dio_StatsGet(DioStats_t * const Stats)
+{
+  *Stats = Dio_Stats;
+}
+
+/**********************************************************************
+* Function : Dio_StatsReset()
+*//**
+* \b Description:
+* This function is used to clear the instrumentation counters.<br>
+* PRE-CONDITION: DIO_INSTRUMENT is STD_ON <br>
+* POST-CONDITION: All the counters are zero.<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_StatsReset();
+* @endcode
+* @see Dio_StatsGet
+**********************************************************************/
+void
+Dio_StatsReset(void)
+{
+  Dio_Stats = (DioStats_t){ 0 };
+}
+
+/**********************************************************************
+* Function : Dio_StatsPortOf()
+*//**
+* \b Description:
+* Finds the port of a register accessed through the register interface,
+* DIO_NUMBER_OF_PORTS is returned for a register outside the port tables.
+**********************************************************************/
+static uint8_t
+Dio_StatsPortOf(const volatile uint8_t * const Address)
+{
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      if(Address == Dio_PortsIn[Port] || Address == Dio_PortsDir[Port]
+         || Address == Dio_PortsOut[Port])
+        {
+          return Port;
+        }
+    }
+  return DIO_NUMBER_OF_PORTS;
+}
+#endif
 
 /**************************************************************************
 * Function : Dio_RegisterWrite()
@@ -225,12 +1107,14 @@ Dio_SetChannelDirection(DioChannel_t Channel, DioDirection_t Direction)
 void 
 Dio_RegisterWrite(uint8_t volatile * const Address, uint8_t Value)
 {
+  DIO_STATS_CALL(DIO_API_REGISTER_WRITE);
+
   if(!((uint8_t *)DIO_LOWER_BOUND_ADDRESS <= Address
       && Address <= (uint8_t *)DIO_UPPER_BOUND_ADDRESS))
     {
       //TODO: implement your error handling method
     }
-  *Address = Value;
+  DIO_WRITE(Dio_StatsPortOf(Address), Address, Value);
 }
 /**********************************************************************
 * Function : Dio_RegisterRead()
@@ -255,13 +1139,15 @@ Dio_RegisterWrite(uint8_t volatile * const Address, uint8_t Value)
 const volatile uint8_t 
 Dio_RegisterRead(const volatile uint8_t * const Address)
 {
+  DIO_STATS_CALL(DIO_API_REGISTER_READ);
+
   if(!((uint8_t *)DIO_LOWER_BOUND_ADDRESS <= Address
       && Address <= (uint8_t *)DIO_UPPER_BOUND_ADDRESS))
     {
       //TODO: implement your error handling method
       return 0x0;
     }
-  return *Address;
+  return DIO_READ(Dio_StatsPortOf(Address), Address);
 }
 
 /*************** END OF FUNCTIONS ********************************/
@@ -14,6 +14,9 @@
 **********************************************************************/
 #include <inttypes.h>
 #include "dio_cfg.h" /**< For dio configuration */
+#if DIO_INLINE == STD_ON
+#include "dio_inline.h" /**< For the inline fast path */
+#endif
 /**********************************************************************
 * Function Prototypes
 **********************************************************************/
@@ -22,15 +25,46 @@ extern "C"{
 #endif
 
 void Dio_Init(const DioConfig_t * const Config);
+void Dio_InitPorts(const DioPortConfig_t * const Config);
+void Dio_ApplyProfile(DioProfileId_t Id);
 
+#if DIO_INLINE == STD_OFF
 DioState_t Dio_ChannelRead(DioChannel_t Channel);
 void Dio_ChannelWrite(DioChannel_t Channel, DioState_t State);
 
 void Dio_SetChannelDirection(DioChannel_t Channel, DioDirection_t Direction);
+#endif
+void Dio_ChannelWriteAtomic(DioChannel_t Channel, DioState_t State);
+void Dio_SetChannelDirectionAtomic(DioChannel_t Channel, DioDirection_t Direction);
+void Dio_PortWriteMaskedAtomic(DioPort_t Port, DioPortValue_t Mask, DioPortValue_t Value);
+
+DioPortValue_t Dio_PortRead(DioPort_t Port);
+void Dio_PortWrite(DioPort_t Port, DioPortValue_t Value);
+void Dio_PortWriteMasked(DioPort_t Port, DioPortValue_t Mask, DioPortValue_t Value);
+void Dio_PortWriteMaskedIsr(DioPort_t Port, DioPortValue_t Mask, DioPortValue_t Value);
+
+DioPortValue_t Dio_GroupRead(const DioGroup_t * const Group);
+void Dio_GroupWrite(const DioGroup_t * const Group, DioPortValue_t Value);
+
+void Dio_SetPortDirection(DioPort_t Port, DioPortValue_t Direction);
+void Dio_SetPortDirectionMasked(DioPort_t Port, DioPortValue_t Mask,
+                                DioPortValue_t Direction);
+void Dio_SetPortDirectionMaskedIsr(DioPort_t Port, DioPortValue_t Mask,
+                                   DioPortValue_t Direction);
 
 void Dio_RegisterWrite(uint8_t volatile * const Address, uint8_t Value);
 const volatile uint8_t Dio_RegisterRead(const volatile uint8_t * const Address);
 
+#if DIO_SHADOW == STD_ON
+void Dio_BeginBatch(void);
+void Dio_Commit(void);
+#endif
+
+#if DIO_INSTRUMENT == STD_ON
+void Dio_StatsGet(DioStats_t * const Stats);
+void Dio_StatsReset(void);
+#endif
+
 
 #ifdef __cplusplus
 } // extern "C"
@@ -0,0 +1,703 @@
+/**
+ * @file dio_bb.c
+ * @author Mohamed Hassanin
+ * @brief The implementation for the dio bit-banged serial protocols.
+ * Every bit of a byte is expanded in place by a macro, with the pins and
+ * the delays known at build time, so a bit compiles to the register
+ * accesses of its pins and the cycle delays between them. The sequences
+ * whose timing is set by the slave side (1-Wire slots, UART frames) run
+ * with the interrupts disabled.
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_bb.h" /* For this modules definitions */
+#include "dio_pin.h" /* For the compile time pin access */
+#include "dio_memmap.h" /* For the delays and the critical section */
+/**********************************************************************
+* Preprocessor Macros
+**********************************************************************/
+/**
+* Drives an open drain line: PULL takes it LOW, RELEASE lets the pull-up
+* take it HIGH. The PORTx bit of the line stays LOW.
+*/
+#define DIO_BB_PULL(Channel)	DIO_PIN_OUTPUT(Channel)
+#define DIO_BB_RELEASE(Channel)	DIO_PIN_INPUT(Channel)
+
+#if DIO_BB_SPI == STD_ON
+/**
+* Shifts out bit Bit of Out on MOSI and shifts in MISO to In, mode 0:
+* MISO is sampled on the rising edge of SCK.
+*/
+#define DIO_BB_SPI_BIT(Bit) \
+  do { \
+    if(Out & (1U << (Bit))) \
+      { \
+        DIO_PIN_HIGH(DIO_BB_SPI_MOSI); \
+      } \
+    else \
+      { \
+        DIO_PIN_LOW(DIO_BB_SPI_MOSI); \
+      } \
+    DIO_DELAY_CYCLES(DIO_BB_SPI_HALF_CYCLES); \
+    DIO_PIN_HIGH(DIO_BB_SPI_SCK); \
+    if(DIO_PIN_READ(DIO_BB_SPI_MISO) == DIO_STATE_HIGH) \
+      { \
+        In |= (uint8_t)(1U << (Bit)); \
+      } \
+    DIO_DELAY_CYCLES(DIO_BB_SPI_HALF_CYCLES); \
+    DIO_PIN_LOW(DIO_BB_SPI_SCK); \
+  } while (0)
+#endif
+
+#if DIO_BB_I2C == STD_ON
+/**
+* Sets SDA to bit Bit of Byte and clocks it out.
+*/
+#define DIO_BB_I2C_WRITE_BIT(Bit) \
+  do { \
+    if(Byte & (1U << (Bit))) \
+      { \
+        DIO_BB_RELEASE(DIO_BB_I2C_SDA); \
+      } \
+    else \
+      { \
+        DIO_BB_PULL(DIO_BB_I2C_SDA); \
+      } \
+    DIO_DELAY_CYCLES(DIO_BB_I2C_HALF_CYCLES); \
+    Dio_BbI2cSclRelease(); \
+    DIO_DELAY_CYCLES(DIO_BB_I2C_HALF_CYCLES); \
+    DIO_BB_PULL(DIO_BB_I2C_SCL); \
+  } while (0)
+/**
+* Clocks in SDA to bit Bit of Byte, SDA must be released.
+*/
+#define DIO_BB_I2C_READ_BIT(Bit) \
+  do { \
+    DIO_DELAY_CYCLES(DIO_BB_I2C_HALF_CYCLES); \
+    Dio_BbI2cSclRelease(); \
+    if(DIO_PIN_READ(DIO_BB_I2C_SDA) == DIO_STATE_HIGH) \
+      { \
+        Byte |= (uint8_t)(1U << (Bit)); \
+      } \
+    DIO_DELAY_CYCLES(DIO_BB_I2C_HALF_CYCLES); \
+    DIO_BB_PULL(DIO_BB_I2C_SCL); \
+  } while (0)
+#endif
+
+#if DIO_BB_ONEWIRE == STD_ON
+/**
+* Writes bit Bit of Byte in a 70 us time slot: a 1 is a 6 us LOW pulse,
+* a 0 is a 60 us LOW pulse. The slave samples the line 15 to 60 us after
+* the falling edge, so only the pulse runs with the interrupts disabled.
+*/
+#define DIO_BB_ONEWIRE_WRITE_BIT(Bit) \
+  do { \
+    uint8_t Sreg; \
+    DIO_CRITICAL_ENTER(Sreg); \
+    DIO_BB_PULL(DIO_BB_ONEWIRE_PIN); \
+    if(Byte & (1U << (Bit))) \
+      { \
+        DIO_DELAY_CYCLES(DIO_BB_US(6)); \
+        DIO_BB_RELEASE(DIO_BB_ONEWIRE_PIN); \
+        DIO_CRITICAL_EXIT(Sreg); \
+        DIO_DELAY_CYCLES(DIO_BB_US(64)); \
+      } \
+    else \
+      { \
+        DIO_DELAY_CYCLES(DIO_BB_US(60)); \
+        DIO_BB_RELEASE(DIO_BB_ONEWIRE_PIN); \
+        DIO_CRITICAL_EXIT(Sreg); \
+        DIO_DELAY_CYCLES(DIO_BB_US(10)); \
+      } \
+  } while (0)
+/**
+* Reads bit Bit of Byte in a 70 us time slot: a 6 us LOW pulse starts the
+* slot, and the line is sampled 15 us after the falling edge.
+*/
+#define DIO_BB_ONEWIRE_READ_BIT(Bit) \
+  do { \
+    uint8_t Sreg; \
+    DIO_CRITICAL_ENTER(Sreg); \
+    DIO_BB_PULL(DIO_BB_ONEWIRE_PIN); \
+    DIO_DELAY_CYCLES(DIO_BB_US(6)); \
+    DIO_BB_RELEASE(DIO_BB_ONEWIRE_PIN); \
+    DIO_DELAY_CYCLES(DIO_BB_US(9)); \
+    if(DIO_PIN_READ(DIO_BB_ONEWIRE_PIN) == DIO_STATE_HIGH) \
+      { \
+        Byte |= (uint8_t)(1U << (Bit)); \
+      } \
+    DIO_CRITICAL_EXIT(Sreg); \
+    DIO_DELAY_CYCLES(DIO_BB_US(55)); \
+  } while (0)
+#endif
+
+#if DIO_BB_UART == STD_ON
+/**
+* The cycles of a bit, less the cycles of the pin access of the bit.
+*/
+#define DIO_BB_UART_BIT_CYCLES \
+  ((uint32_t)(DIO_BB_F_CPU / DIO_BB_UART_BAUD - DIO_BB_UART_BIT_OVERHEAD))
+/**
+* Sends bit 0 of Frame on TX for a bit time, then shifts the next bit of
+* Frame in place. The level is written without a branch and each bit of
+* the frame runs the same code, so a HIGH and a LOW bit, the start bit
+* and the stop bit all last the same time.
+*/
+#define DIO_BB_UART_TX_BIT() \
+  do { \
+    DIO_REG_WRITE(DIO_PORT_REG(DIO_BB_UART_TX), \
+                  (uint8_t)((DIO_REG_READ(DIO_PORT_REG(DIO_BB_UART_TX)) \
+                             & (uint8_t)~DIO_PIN_BIT(DIO_BB_UART_TX)) \
+                            | ((uint8_t)-(uint8_t)(Frame & 1U) \
+                               & DIO_PIN_BIT(DIO_BB_UART_TX)))); \
+    Frame >>= 1; \
+    DIO_DELAY_CYCLES(DIO_BB_UART_BIT_CYCLES); \
+  } while (0)
+/**
+* Samples RX to bit Bit of Byte, then waits for the middle of the next bit.
+*/
+#define DIO_BB_UART_RX_BIT(Bit) \
+  do { \
+    if(DIO_PIN_READ(DIO_BB_UART_RX) == DIO_STATE_HIGH) \
+      { \
+        Value |= (uint8_t)(1U << (Bit)); \
+      } \
+    DIO_DELAY_CYCLES(DIO_BB_UART_BIT_CYCLES); \
+  } while (0)
+#endif
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+#if DIO_BB_SPI == STD_ON
+/*********************************************************************
+* Function : Dio_BbSpiInit()
+*//**
+* \b Description:
+* This function is used to set up the SPI pins: SCK and MOSI are LOW<br>
+* outputs, MISO is an input.<br>
+* POST-CONDITION: The SPI bus is idle in mode 0.<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_BbSpiInit();
+* @endcode
+* @see Dio_BbSpiTransfer
+**********************************************************************/
+void
+Dio_BbSpiInit(void)
+{
+  DIO_PIN_LOW(DIO_BB_SPI_SCK);
+  DIO_PIN_LOW(DIO_BB_SPI_MOSI);
+  DIO_PIN_OUTPUT(DIO_BB_SPI_SCK);
+  DIO_PIN_OUTPUT(DIO_BB_SPI_MOSI);
+  DIO_PIN_INPUT(DIO_BB_SPI_MISO);
+}
+
+/*********************************************************************
+* Function : Dio_BbSpiTransfer()
+*//**
+* \b Description:
+* This function is used to exchange a byte with the slave, MSB first.<br>
+* The slave select is driven by the application.<br>
+* PRE-CONDITION: Dio_BbSpiInit has been called <br>
+* POST-CONDITION: SCK is LOW.<br>
+* @param Out is the byte sent on MOSI
+* @return The byte received on MISO
+*
+* \b Example:
+* @code
+* DIO_PIN_LOW(PORTB_4);
+* Status = Dio_BbSpiTransfer(0x05);
+* DIO_PIN_HIGH(PORTB_4);
+* @endcode
+* @see Dio_BbSpiTransferBuffer
+**********************************************************************/
+uint8_t
+Dio_BbSpiTransfer(uint8_t Out)
+{
+  uint8_t In = 0;
+
+  DIO_BB_SPI_BIT(7);
+  DIO_BB_SPI_BIT(6);
+  DIO_BB_SPI_BIT(5);
+  DIO_BB_SPI_BIT(4);
+  DIO_BB_SPI_BIT(3);
+  DIO_BB_SPI_BIT(2);
+  DIO_BB_SPI_BIT(1);
+  DIO_BB_SPI_BIT(0);
+
+  return In;
+}
+
+/*********************************************************************
+* Function : Dio_BbSpiTransferBuffer()
+*//**
+* \b Description:
+* This function is used to exchange a block of bytes with the slave.<br>
+* PRE-CONDITION: Dio_BbSpiInit has been called <br>
+* POST-CONDITION: SCK is LOW.<br>
+* @param Out is the bytes to send, or NULL to send 0xFF
+* @param In receives the bytes, or NULL to discard them
+* @param Length is the number of bytes
+* @return void
+*
+* \b Example:
+* @code
+* uint8_t Rx[4];
+* Dio_BbSpiTransferBuffer(NULL, Rx, 4);
+* @endcode
+* @see Dio_BbSpiTransfer
+**********************************************************************/
+void
+Dio_BbSpiTransferBuffer(const uint8_t * const Out, uint8_t * const In,
+                        uint16_t Length)
+{
+  for (uint16_t Index = 0; Index < Length; Index++)
+    {
+      const uint8_t Byte = Dio_BbSpiTransfer(Out ? Out[Index] : 0xFFU);
+
+      if(In)
+        {
+          In[Index] = Byte;
+        }
+    }
+}
+#endif
+
+#if DIO_BB_I2C == STD_ON
+/**********************************************************************
+* Function : Dio_BbI2cSclRelease()
+*//**
+* \b Description:
+* Releases SCL and waits while a slave stretches the clock, at most
+* DIO_BB_I2C_STRETCH_POLLS samples.
+**********************************************************************/
+static inline void
+Dio_BbI2cSclRelease(void)
+{
+  uint16_t Polls = DIO_BB_I2C_STRETCH_POLLS;
+
+  DIO_BB_RELEASE(DIO_BB_I2C_SCL);
+  while(DIO_PIN_READ(DIO_BB_I2C_SCL) == DIO_STATE_LOW && Polls != 0)
+    {
+      Polls--;
+    }
+}
+
+/*********************************************************************
+* Function : Dio_BbI2cInit()
+*//**
+* \b Description:
+* This function is used to set up the I2C pins as released open drain<br>
+* lines. The direction is changed before the PORTx bit, so the lines<br>
+* are never driven HIGH.<br>
+* POST-CONDITION: The I2C bus is idle.<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_BbI2cInit();
+* @endcode
+* @see Dio_BbI2cStart
+**********************************************************************/
+void
+Dio_BbI2cInit(void)
+{
+  DIO_BB_RELEASE(DIO_BB_I2C_SCL);
+  DIO_BB_RELEASE(DIO_BB_I2C_SDA);
+  DIO_PIN_LOW(DIO_BB_I2C_SCL);
+  DIO_PIN_LOW(DIO_BB_I2C_SDA);
+}
+
+/*********************************************************************
+* Function : Dio_BbI2cStart()
+*//**
+* \b Description:
+* This function is used to send a start, or a repeated start, condition:<br>
+* SDA falls while SCL is HIGH.<br>
+* PRE-CONDITION: Dio_BbI2cInit has been called <br>
+* POST-CONDITION: SCL and SDA are LOW.<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_BbI2cStart();
+* Ack = Dio_BbI2cWrite(0x50 << 1);
+* @endcode
+* @see Dio_BbI2cStop
+**********************************************************************/
+void
+Dio_BbI2cStart(void)
+{
+  DIO_BB_RELEASE(DIO_BB_I2C_SDA);
+  DIO_DELAY_CYCLES(DIO_BB_I2C_HALF_CYCLES);
+  Dio_BbI2cSclRelease();
+  DIO_DELAY_CYCLES(DIO_BB_I2C_HALF_CYCLES);
+  DIO_BB_PULL(DIO_BB_I2C_SDA);
+  DIO_DELAY_CYCLES(DIO_BB_I2C_HALF_CYCLES);
+  DIO_BB_PULL(DIO_BB_I2C_SCL);
+}
+
+/*********************************************************************
+* Function : Dio_BbI2cStop()
+*//**
+* \b Description:
+* This function is used to send a stop condition: SDA rises while SCL<br>
+* is HIGH.<br>
+* PRE-CONDITION: Dio_BbI2cStart has been called <br>
+* POST-CONDITION: The I2C bus is idle.<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_BbI2cStop();
+* @endcode
+* @see Dio_BbI2cStart
+**********************************************************************/
+void
+Dio_BbI2cStop(void)
+{
+  DIO_BB_PULL(DIO_BB_I2C_SDA);
+  DIO_DELAY_CYCLES(DIO_BB_I2C_HALF_CYCLES);
+  Dio_BbI2cSclRelease();
+  DIO_DELAY_CYCLES(DIO_BB_I2C_HALF_CYCLES);
+  DIO_BB_RELEASE(DIO_BB_I2C_SDA);
+  DIO_DELAY_CYCLES(DIO_BB_I2C_HALF_CYCLES);
+}
+
+/*********************************************************************
+* Function : Dio_BbI2cWrite()
+*//**
+* \b Description:
+* This function is used to send a byte, MSB first, and to clock in the<br>
+* acknowledge of the slave.<br>
+* PRE-CONDITION: Dio_BbI2cStart has been called <br>
+* POST-CONDITION: SCL is LOW and SDA is released.<br>
+* @param Byte is the byte to send
+* @return 1 when the slave acknowledged the byte, else 0
+*
+* \b Example:
+* @code
+* Dio_BbI2cStart();
+* if(Dio_BbI2cWrite(0x50 << 1) == 0) { ... }
+* @endcode
+* @see Dio_BbI2cRead
+**********************************************************************/
+uint8_t
+Dio_BbI2cWrite(uint8_t Byte)
+{
+  DIO_BB_I2C_WRITE_BIT(7);
+  DIO_BB_I2C_WRITE_BIT(6);
+  DIO_BB_I2C_WRITE_BIT(5);
+  DIO_BB_I2C_WRITE_BIT(4);
+  DIO_BB_I2C_WRITE_BIT(3);
+  DIO_BB_I2C_WRITE_BIT(2);
+  DIO_BB_I2C_WRITE_BIT(1);
+  DIO_BB_I2C_WRITE_BIT(0);
+
+  // The acknowledge is a LOW SDA on the ninth clock
+  DIO_BB_RELEASE(DIO_BB_I2C_SDA);
+  Byte = 0;
+  DIO_BB_I2C_READ_BIT(0);
+
+  return (uint8_t)(Byte ^ 1U);
+}
+
+/*********************************************************************
+* Function : Dio_BbI2cRead()
+*//**
+* \b Description:
+* This function is used to receive a byte, MSB first, and to send the<br>
+* acknowledge of the master.<br>
+* PRE-CONDITION: The slave has been addressed for a read <br>
+* POST-CONDITION: SCL is LOW and SDA is released.<br>
+* @param Ack is 1 to acknowledge the byte, 0 for the last byte
+* @return The byte received
+*
+* \b Example:
+* @code
+* High = Dio_BbI2cRead(1);
+* Low = Dio_BbI2cRead(0);
+* Dio_BbI2cStop();
+* @endcode
+* @see Dio_BbI2cWrite
+**********************************************************************/
+uint8_t
+Dio_BbI2cRead(uint8_t Ack)
+{
+  uint8_t Byte = 0;
+  uint8_t Received;
+
+  DIO_BB_RELEASE(DIO_BB_I2C_SDA);
+  DIO_BB_I2C_READ_BIT(7);
+  DIO_BB_I2C_READ_BIT(6);
+  DIO_BB_I2C_READ_BIT(5);
+  DIO_BB_I2C_READ_BIT(4);
+  DIO_BB_I2C_READ_BIT(3);
+  DIO_BB_I2C_READ_BIT(2);
+  DIO_BB_I2C_READ_BIT(1);
+  DIO_BB_I2C_READ_BIT(0);
+  Received = Byte;
+
+  // The acknowledge is a LOW SDA on the ninth clock
+  Byte = (Ack != 0) ? 0U : 1U;
+  DIO_BB_I2C_WRITE_BIT(0);
+  DIO_BB_RELEASE(DIO_BB_I2C_SDA);
+
+  return Received;
+}
+#endif
+
+#if DIO_BB_ONEWIRE == STD_ON
+/*********************************************************************
+* Function : Dio_BbOneWireInit()
+*//**
+* \b Description:
+* This function is used to set up the 1-Wire pin as a released open<br>
+* drain line.<br>
+* POST-CONDITION: The 1-Wire bus is idle.<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_BbOneWireInit();
+* @endcode
+* @see Dio_BbOneWireReset
+**********************************************************************/
+void
+Dio_BbOneWireInit(void)
+{
+  DIO_BB_RELEASE(DIO_BB_ONEWIRE_PIN);
+  DIO_PIN_LOW(DIO_BB_ONEWIRE_PIN);
+}
+
+/*********************************************************************
+* Function : Dio_BbOneWireReset()
+*//**
+* \b Description:
+* This function is used to send the reset pulse, 480 us LOW, and to<br>
+* sample the presence pulse of the slaves 70 us after the release.<br>
+* PRE-CONDITION: Dio_BbOneWireInit has been called <br>
+* POST-CONDITION: The slaves wait for a ROM command.<br>
+* @return 1 when a slave answered, else 0
+*
+* \b Example:
+* @code
+* if(Dio_BbOneWireReset())
+*   {
+*     Dio_BbOneWireWrite(0xCC);
+*     Dio_BbOneWireWrite(0x44);
+*   }
+* @endcode
+* @see Dio_BbOneWireWrite
+**********************************************************************/
+uint8_t
+Dio_BbOneWireReset(void)
+{
+  uint8_t Presence;
+  uint8_t Sreg;
+
+  DIO_BB_PULL(DIO_BB_ONEWIRE_PIN);
+  DIO_DELAY_CYCLES(DIO_BB_US(480));
+
+  DIO_CRITICAL_ENTER(Sreg);
+  DIO_BB_RELEASE(DIO_BB_ONEWIRE_PIN);
+  DIO_DELAY_CYCLES(DIO_BB_US(70));
+  Presence = (DIO_PIN_READ(DIO_BB_ONEWIRE_PIN) == DIO_STATE_LOW) ? 1U : 0U;
+  DIO_CRITICAL_EXIT(Sreg);
+
+  DIO_DELAY_CYCLES(DIO_BB_US(410));
+
+  return Presence;
+}
+
+/*********************************************************************
+* Function : Dio_BbOneWireWrite()
+*//**
+* \b Description:
+* This function is used to send a byte, LSB first.<br>
+* PRE-CONDITION: Dio_BbOneWireReset has been called <br>
+* POST-CONDITION: The line is released.<br>
+* @param Byte is the byte to send
+* @return void
+*
+* \b Example:
+* @code
+* Dio_BbOneWireWrite(0xCC);
+* @endcode
+* @see Dio_BbOneWireRead
+**********************************************************************/
+void
+Dio_BbOneWireWrite(uint8_t Byte)
+{
+  DIO_BB_ONEWIRE_WRITE_BIT(0);
+  DIO_BB_ONEWIRE_WRITE_BIT(1);
+  DIO_BB_ONEWIRE_WRITE_BIT(2);
+  DIO_BB_ONEWIRE_WRITE_BIT(3);
+  DIO_BB_ONEWIRE_WRITE_BIT(4);
+  DIO_BB_ONEWIRE_WRITE_BIT(5);
+  DIO_BB_ONEWIRE_WRITE_BIT(6);
+  DIO_BB_ONEWIRE_WRITE_BIT(7);
+}
+
+/*********************************************************************
+* Function : Dio_BbOneWireRead()
+*//**
+* \b Description:
+* This function is used to receive a byte, LSB first.<br>
+* PRE-CONDITION: Dio_BbOneWireReset has been called <br>
+* POST-CONDITION: The line is released.<br>
+* @return The byte received
+*
+* \b Example:
+* @code
+* Dio_BbOneWireWrite(0xBE);
+* Low = Dio_BbOneWireRead();
+* @endcode
+* @see Dio_BbOneWireWrite
+**********************************************************************/
+uint8_t
+Dio_BbOneWireRead(void)
+{
+  uint8_t Byte = 0;
+
+  DIO_BB_ONEWIRE_READ_BIT(0);
+  DIO_BB_ONEWIRE_READ_BIT(1);
+  DIO_BB_ONEWIRE_READ_BIT(2);
+  DIO_BB_ONEWIRE_READ_BIT(3);
+  DIO_BB_ONEWIRE_READ_BIT(4);
+  DIO_BB_ONEWIRE_READ_BIT(5);
+  DIO_BB_ONEWIRE_READ_BIT(6);
+  DIO_BB_ONEWIRE_READ_BIT(7);
+
+  return Byte;
+}
+#endif
+
+#if DIO_BB_UART == STD_ON
+/*********************************************************************
+* Function : Dio_BbUartInit()
+*//**
+* \b Description:
+* This function is used to set up the UART pins: TX is a HIGH output,<br>
+* RX is an input with its pull-up enabled.<br>
+* POST-CONDITION: The line is idle.<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_BbUartInit();
+* @endcode
+* @see Dio_BbUartWrite
+**********************************************************************/
+void
+Dio_BbUartInit(void)
+{
+  DIO_PIN_HIGH(DIO_BB_UART_TX);
+  DIO_PIN_OUTPUT(DIO_BB_UART_TX);
+  DIO_PIN_INPUT(DIO_BB_UART_RX);
+  DIO_PIN_HIGH(DIO_BB_UART_RX);
+}
+
+/*********************************************************************
+* Function : Dio_BbUartWrite()
+*//**
+* \b Description:
+* This function is used to send a frame: a start bit, the byte LSB<br>
+* first and a stop bit. The interrupts are disabled for the frame, about<br>
+* 1 ms at 9600 baud.<br>
+* PRE-CONDITION: Dio_BbUartInit has been called <br>
+* POST-CONDITION: The line is idle.<br>
+* @param Byte is the byte to send
+* @return void
+*
+* \b Example:
+* @code
+* for (const char *Text = "hello\n"; *Text; Text++)
+*   {
+*     Dio_BbUartWrite((uint8_t)*Text);
+*   }
+* @endcode
+* @see Dio_BbUartRead
+**********************************************************************/
+void
+Dio_BbUartWrite(uint8_t Byte)
+{
+  // The start bit (0), the byte LSB first and the stop bit (1)
+  uint16_t Frame = (uint16_t)(((uint16_t)Byte << 1) | 0x200U);
+  uint8_t Sreg;
+
+  DIO_CRITICAL_ENTER(Sreg);
+  DIO_BB_UART_TX_BIT();
+  DIO_BB_UART_TX_BIT();
+  DIO_BB_UART_TX_BIT();
+  DIO_BB_UART_TX_BIT();
+  DIO_BB_UART_TX_BIT();
+  DIO_BB_UART_TX_BIT();
+  DIO_BB_UART_TX_BIT();
+  DIO_BB_UART_TX_BIT();
+  DIO_BB_UART_TX_BIT();
+  DIO_BB_UART_TX_BIT();
+  DIO_CRITICAL_EXIT(Sreg);
+}
+
+/*********************************************************************
+* Function : Dio_BbUartRead()
+*//**
+* \b Description:
+* This function is used to receive a frame. It polls RX for the start<br>
+* bit, then samples each bit in its middle with the interrupts disabled.<br>
+* PRE-CONDITION: Dio_BbUartInit has been called <br>
+* POST-CONDITION: The stop bit has been sampled.<br>
+* @param Byte receives the byte
+* @param Polls is the number of RX samples to wait for the start bit
+* @return 1 when a frame with a valid stop bit was received, else 0
+*
+* \b Example:
+* @code
+* uint8_t Command;
+* if(Dio_BbUartRead(&Command, 10000U)) { ... }
+* @endcode
+* @see Dio_BbUartWrite
+**********************************************************************/
+uint8_t
+Dio_BbUartRead(uint8_t * const Byte, uint16_t Polls)
+{
+  uint8_t Value = 0;
+  uint8_t Stop;
+  uint8_t Sreg;
+
+  while(DIO_PIN_READ(DIO_BB_UART_RX) == DIO_STATE_HIGH)
+    {
+      if(Polls == 0)
+        {
+          return 0;
+        }
+      Polls--;
+    }
+
+  DIO_CRITICAL_ENTER(Sreg);
+  // From the start bit edge to the middle of the first data bit
+  DIO_DELAY_CYCLES(DIO_BB_UART_BIT_CYCLES + DIO_BB_UART_BIT_CYCLES / 2U);
+  DIO_BB_UART_RX_BIT(0);
+  DIO_BB_UART_RX_BIT(1);
+  DIO_BB_UART_RX_BIT(2);
+  DIO_BB_UART_RX_BIT(3);
+  DIO_BB_UART_RX_BIT(4);
+  DIO_BB_UART_RX_BIT(5);
+  DIO_BB_UART_RX_BIT(6);
+  DIO_BB_UART_RX_BIT(7);
+  Stop = (uint8_t)DIO_PIN_READ(DIO_BB_UART_RX);
+  DIO_CRITICAL_EXIT(Sreg);
+
+  *Byte = Value;
+
+  return (Stop == DIO_STATE_HIGH) ? 1U : 0U;
+}
+#endif
+/*************** END OF FUNCTIONS ********************************/
@@ -0,0 +1,61 @@
+/**
+ * @file dio_bb.h
+ * @author Mohamed Hassanin
+ * @brief The interface definition for the dio bit-banged serial protocols:
+ * SPI master, I2C master, 1-Wire master and UART. The pins of dio_bb_cfg.h
+ * are resolved at build time to register accesses by dio_pin.h, and the
+ * byte loops are unrolled, so a bit costs a few instructions instead of
+ * calls into dio.c. The open drain lines of I2C and 1-Wire keep their
+ * PORTx bit LOW and are driven by their DDRx bit: OUTPUT pulls the line
+ * LOW, INPUT releases it to the pull-up resistor.
+ * @version 0.1
+ * @date 2021-01-12
+*/
+#ifndef DIO_BB_H_
+#define DIO_BB_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_bb_cfg.h" /**< For the bit-bang configuration */
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#if DIO_BB_SPI == STD_ON
+void Dio_BbSpiInit(void);
+uint8_t Dio_BbSpiTransfer(uint8_t Out);
+void Dio_BbSpiTransferBuffer(const uint8_t * const Out, uint8_t * const In,
+                             uint16_t Length);
+#endif
+
+#if DIO_BB_I2C == STD_ON
+void Dio_BbI2cInit(void);
+void Dio_BbI2cStart(void);
+void Dio_BbI2cStop(void);
+uint8_t Dio_BbI2cWrite(uint8_t Byte);
+uint8_t Dio_BbI2cRead(uint8_t Ack);
+#endif
+
+#if DIO_BB_ONEWIRE == STD_ON
+void Dio_BbOneWireInit(void);
+uint8_t Dio_BbOneWireReset(void);
+void Dio_BbOneWireWrite(uint8_t Byte);
+uint8_t Dio_BbOneWireRead(void);
+#endif
+
+#if DIO_BB_UART == STD_ON
+void Dio_BbUartInit(void);
+void Dio_BbUartWrite(uint8_t Byte);
+uint8_t Dio_BbUartRead(uint8_t * const Byte, uint16_t Polls);
+#endif
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* DIO_BB_H_*/
+/*************** END OF FILE ********************************/
@@ -0,0 +1,88 @@
+/**
+ * @file dio_bb_cfg.h
+ * @author Mohamed Hassanin
+ * @brief The configuration of the dio bit-banged serial protocols.
+ * The pins are constant DioChannel_t, resolved at build time to their
+ * registers and bits by dio_pin.h. The delays are in CPU cycles and come
+ * on top of the cycles of the pin accesses, 0 runs a protocol at the I/O
+ * limit of the target.
+ * @version 0.1
+ * @date 2021-01-12
+ */
+#ifndef DIO_BB_CFG_H_
+#define DIO_BB_CFG_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include "dio_cfg.h" /**< For the channels */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the CPU clock in Hz, the time base of the protocol delays.
+*/
+#ifdef F_CPU
+#define DIO_BB_F_CPU F_CPU
+#else
+#define DIO_BB_F_CPU 16000000UL
+#endif
+/**
+* Converts microseconds to CPU cycles.
+*/
+#define DIO_BB_US(Us) ((uint32_t)((DIO_BB_F_CPU / 1000000UL) * (Us)))
+
+/**
+ * Enables the SPI master (mode 0, MSB first).
+ */
+#define DIO_BB_SPI STD_ON
+#define DIO_BB_SPI_SCK PORTB_7
+#define DIO_BB_SPI_MOSI PORTB_5
+#define DIO_BB_SPI_MISO PORTB_6
+/**
+ * The delay of each half of the SPI clock.
+ */
+#define DIO_BB_SPI_HALF_CYCLES 0U
+
+/**
+ * Enables the I2C master. SCL and SDA are open drain, they need external
+ * pull-up resistors.
+ */
+#define DIO_BB_I2C STD_ON
+#define DIO_BB_I2C_SCL PORTC_2
+#define DIO_BB_I2C_SDA PORTC_3
+/**
+ * The delay of each half of the I2C clock, 100 kHz.
+ */
+#define DIO_BB_I2C_HALF_CYCLES (DIO_BB_F_CPU / 200000UL)
+/**
+ * The number of SCL samples a slave may stretch the clock for.
+ */
+#define DIO_BB_I2C_STRETCH_POLLS 1000U
+
+/**
+ * Enables the 1-Wire master. The pin is open drain, it needs an external
+ * pull-up resistor.
+ */
+#define DIO_BB_ONEWIRE STD_ON
+#define DIO_BB_ONEWIRE_PIN PORTD_7
+
+/**
+ * Enables the UART (8 data bits, no parity, 1 stop bit).
+ */
+#define DIO_BB_UART STD_ON
+#define DIO_BB_UART_TX PORTD_1
+#define DIO_BB_UART_RX PORTD_0
+#define DIO_BB_UART_BAUD 9600UL
+/**
+ * The cycles of the pin access of a bit, deducted from the bit delay.
+ * The host simulation counts a cycle per register access: a bit reads and
+ * writes PORTx, and with 2 its write trace shows every bit of a frame at
+ * exactly F_CPU / BAUD cycles (dio_test_bb.c). On the MCU the masking and
+ * the shift of the frame add a few cycles per bit, well within the
+ * tolerance of a UART receiver at 9600 baud; count them in the listing of
+ * the build to trim them as well.
+ */
+#define DIO_BB_UART_BIT_OVERHEAD 2U
+
+#endif /* DIO_BB_CFG_H_*/
+/************************* END OF FILE ********************************/
@@ -13,6 +13,129 @@
 /*********************************************************************
 * Module Variable Definitions
 **********************************************************************/
+/**
+* The following list contains the configuration data for each
+* digital input/output peripheral channel (pin). Each row represents a 
+* single pin: X(Port, Channel, Direction, Data, Pullup). The list is expanded
+* into the two formats of the configuration below, so they always agree.
+* Each pin belongs to one module, the inputs are configured as inputs:
+*   PORTA: 0-1 PWM, 2-3 unused, 4-7 keypad columns
+*   PORTB: 0-1 and 3-4 keypad rows, 2 interrupt (INT2), 5-7 SPI (dio_bb)
+*   PORTC: 0-1 PWM, 2-3 I2C (dio_bb), 4-7 LCD
+*   PORTD: 0-1 UART (dio_bb), 2 interrupt (INT0), 3 unused, 4-5 debounced
+*          buttons, 6 unused, 7 1-Wire (dio_bb)
+*/
+#define DIO_CONFIG_TABLE(X, Port) \
+  X(Port, PORTA_0, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTA_1, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTA_2, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTA_3, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTA_4, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTA_5, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTA_6, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTA_7, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTB_0, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTB_1, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTB_2, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTB_3, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTB_4, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTB_5, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTB_6, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTB_7, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_0, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_1, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_2, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_3, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_4, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_5, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_6, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_7, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTD_0, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTD_1, DIO_DIR_OUTPUT, DIO_STATE_HIGH, DIO_PULLUP_DISABLED) \
+  X(Port, PORTD_2, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTD_3, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTD_4, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTD_5, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTD_6, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTD_7, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED)
+
+/**
+* The channels of the sleep profile, in the DIO_CONFIG_TABLE format: every
+* channel INPUT with its pull-up, so that no input floats and no output
+* draws current.
+*/
+#define DIO_SLEEP_TABLE(X, Port) \
+  X(Port, PORTA_0, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTA_1, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTA_2, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTA_3, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTA_4, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTA_5, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTA_6, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTA_7, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTB_0, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTB_1, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTB_2, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTB_3, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTB_4, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTB_5, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTB_6, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTB_7, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTC_0, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTC_1, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTC_2, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTC_3, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTC_4, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTC_5, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTC_6, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTC_7, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTD_0, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTD_1, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTD_2, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTD_3, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTD_4, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTD_5, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTD_6, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED) \
+  X(Port, PORTD_7, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_ENABLED)
+
+/**
+* The channels of the safe profile, in the DIO_CONFIG_TABLE format: every
+* channel INPUT and floating, the reset state of the ports.
+*/
+#define DIO_SAFE_TABLE(X, Port) \
+  X(Port, PORTA_0, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTA_1, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTA_2, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTA_3, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTA_4, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTA_5, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTA_6, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTA_7, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTB_0, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTB_1, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTB_2, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTB_3, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTB_4, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTB_5, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTB_6, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTB_7, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_0, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_1, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_2, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_3, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_4, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_5, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_6, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTC_7, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTD_0, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTD_1, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTD_2, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTD_3, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTD_4, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTD_5, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTD_6, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  X(Port, PORTD_7, DIO_DIR_INPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED)
+
 /**
 * The following array contains the configuration data for each
 * digital input/output peripheral channel (pin). Each row represents a 
@@ -22,38 +145,112 @@
 */
 static const DioConfig_t DioConfig[] =
 {
-  { PORTA_0, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTA_1, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTA_2, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTA_3, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTA_4, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTA_5, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTA_6, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTA_7, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTB_0, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTB_1, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTB_2, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTB_3, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTB_4, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTB_5, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTB_6, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTB_7, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTC_0, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTC_1, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTC_2, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTC_3, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTC_4, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTC_5, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTC_6, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTC_7, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTD_0, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTD_1, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTD_2, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTD_3, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTD_4, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTD_5, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTD_6, DIO_DIR_OUTPUT, DIO_STATE_LOW },
-  { PORTD_7, DIO_DIR_OUTPUT, DIO_STATE_LOW }
+  DIO_CONFIG_TABLE(DIO_CONFIG_ROW, 0)
+};
+
+/**
+* The following array contains the packed configuration, one row per port
+* indexed by DioPort_t, folded from the same list at build time. It is
+* read in by Dio_InitPorts, which writes each port register once. Its 3
+* masks per port replace the DioConfig_t row of each channel.
+*/
+static const DioPortConfig_t DioPortConfig[DIO_NUMBER_OF_PORTS] =
+{
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORTA),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORTB),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORTC),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORTD),
+};
+
+/**
+* The following array contains the pin configuration profiles, indexed by
+* DioProfileId_t, each one packed as one row per port (DioPortConfig_t).
+* Each profile is built from its channel list with DIO_PORT_CONFIG.
+* Dio_ApplyProfile switches to a profile by
+* writing only the port registers that differ from it.
+*/
+static const DioPortConfig_t DioProfiles[DIO_PROFILE_MAX][DIO_NUMBER_OF_PORTS] =
+{
+  [DIO_PROFILE_ACTIVE] =
+  {
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORTA),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORTB),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORTC),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORTD),
+  },
+  [DIO_PROFILE_SLEEP] =
+  {
+    DIO_PORT_CONFIG(DIO_SLEEP_TABLE, DIO_PORTA),
+    DIO_PORT_CONFIG(DIO_SLEEP_TABLE, DIO_PORTB),
+    DIO_PORT_CONFIG(DIO_SLEEP_TABLE, DIO_PORTC),
+    DIO_PORT_CONFIG(DIO_SLEEP_TABLE, DIO_PORTD),
+  },
+  [DIO_PROFILE_SAFE] =
+  {
+    DIO_PORT_CONFIG(DIO_SAFE_TABLE, DIO_PORTA),
+    DIO_PORT_CONFIG(DIO_SAFE_TABLE, DIO_PORTB),
+    DIO_PORT_CONFIG(DIO_SAFE_TABLE, DIO_PORTC),
+    DIO_PORT_CONFIG(DIO_SAFE_TABLE, DIO_PORTD),
+  },
+};
+
+/**
+* The following array contains the channel groups, indexed by DioGroupId_t.
+* Each group is a set of contiguous channels of one port that is written
+* and read as a single value by Dio_GroupWrite and Dio_GroupRead.
+*/
+static const DioGroup_t DioGroups[DIO_GROUP_MAX] =
+{
+  [DIO_GROUP_LCD_DATA] = DIO_GROUP(PORTC_4, 4U),
+};
+
+/**
+* The following array contains the debounced channels, one row per port.
+* Each row is sampled once per Dio_DebounceTick.
+*/
+static const DioDebounceConfig_t DioDebounceConfig[DIO_DEBOUNCE_PORTS] =
+{
+  { DIO_PORTD, 0x30, 0x30 },
+};
+
+/**
+* The following array contains the channels of the software PWM. The
+* position of a channel in the table is its index in Dio_PwmDutySet.
+*/
+static const DioChannel_t DioPwmChannels[DIO_PWM_CHANNELS] =
+{
+  PORTA_0, PORTA_1, PORTC_0, PORTC_1
+};
+
+/**
+* The following array contains the interrupt driven channels. Only the
+* external interrupt channels can be used: PORTD_2 (INT0), PORTD_3 (INT1)
+* and PORTB_2 (INT2).
+*/
+static const DioIrqConfig_t DioIrqConfig[DIO_IRQ_CHANNELS] =
+{
+  { PORTD_2, DIO_IRQ_FALLING },
+  { PORTB_2, DIO_IRQ_BOTH },
+};
+
+/**
+* The following arrays contain the channels of the keypad matrix. The
+* rows of one port are selected with one write to the direction register,
+* the columns of one port are sampled with one read of the input register.
+*/
+static const DioChannel_t DioKeypadRows[DIO_KEYPAD_ROWS] =
+{
+  PORTB_0, PORTB_1, PORTB_3, PORTB_4
+};
+
+static const DioChannel_t DioKeypadColumns[DIO_KEYPAD_COLUMNS] =
+{
+  PORTA_4, PORTA_5, PORTA_6, PORTA_7
+};
+
+static const DioKeypadConfig_t DioKeypadConfig =
+{
+  DioKeypadRows, DioKeypadColumns
 };
 /**********************************************************************
 * Function Definitions
@@ -83,4 +280,154 @@ Dio_ConfigGet(void)
   */
   return (const DioConfig_t *)DioConfig;
 }
+
+/**********************************************************************
+* Function : Dio_PortConfigGet()
+*//**
+* \b Description:
+* This function is used to get the packed configuration of the Dio <br>
+* POST-CONDITION: A constant pointer to the first member of the
+* packed configuration will be returned. <br>
+* @return A pointer to the packed configuration of DIO_NUMBER_OF_PORTS
+* rows.
+*
+* \b Example:
+* @code
+* Dio_InitPorts(Dio_PortConfigGet());
+* @endcode
+* @see Dio_InitPorts
+**********************************************************************/
+const DioPortConfig_t *
+Dio_PortConfigGet(void)
+{
+  return DioPortConfig;
+}
+
+/**********************************************************************
+* Function : Dio_ProfileConfigGet()
+*//**
+* \b Description:
+* This function is used to get a pin configuration profile of the Dio <br>
+* PRE-CONDITION: Id < DIO_PROFILE_MAX <br>
+* POST-CONDITION: A constant pointer to the first port of the profile
+* will be returned. <br>
+* @param Id is the profile
+* @return A pointer to the DIO_NUMBER_OF_PORTS rows of the profile.
+*
+* \b Example:
+* @code
+* Dio_InitPorts(Dio_ProfileConfigGet(DIO_PROFILE_SLEEP));
+* @endcode
+* @see Dio_ApplyProfile
+**********************************************************************/
+const DioPortConfig_t *
+Dio_ProfileConfigGet(DioProfileId_t Id)
+{
+  return DioProfiles[Id];
+}
+
+/**********************************************************************
+* Function : Dio_GroupConfigGet()
+*//**
+* \b Description:
+* This function is used to get the channel group table of the Dio <br>
+* POST-CONDITION: A constant pointer to the first member of the
+* group table will be returned. <br>
+* @return A pointer to the group table, indexed by DioGroupId_t.
+*
+* \b Example:
+* @code
+* const DioGroup_t *Groups = Dio_GroupConfigGet();
+* Dio_GroupWrite(&Groups[DIO_GROUP_LCD_DATA], 0x3);
+* @endcode
+* @see Dio_GroupWrite
+**********************************************************************/
+const DioGroup_t *
+Dio_GroupConfigGet(void)
+{
+  return DioGroups;
+}
+
+/**********************************************************************
+* Function : Dio_DebounceConfigGet()
+*//**
+* \b Description:
+* This function is used to get the debounce table of the Dio <br>
+* POST-CONDITION: A constant pointer to the first member of the
+* debounce table will be returned. <br>
+* @return A pointer to the debounce table of DIO_DEBOUNCE_PORTS rows.
+*
+* \b Example:
+* @code
+* Dio_DebounceInit(Dio_DebounceConfigGet());
+* @endcode
+* @see Dio_DebounceInit
+**********************************************************************/
+const DioDebounceConfig_t *
+Dio_DebounceConfigGet(void)
+{
+  return DioDebounceConfig;
+}
+
+/**********************************************************************
+* Function : Dio_PwmConfigGet()
+*//**
+* \b Description:
+* This function is used to get the software PWM channel table of the Dio <br>
+* POST-CONDITION: A constant pointer to the first member of the
+* PWM channel table will be returned. <br>
+* @return A pointer to the PWM channel table of DIO_PWM_CHANNELS rows.
+*
+* \b Example:
+* @code
+* Dio_PwmInit(Dio_PwmConfigGet());
+* @endcode
+* @see Dio_PwmInit
+**********************************************************************/
+const DioChannel_t *
+Dio_PwmConfigGet(void)
+{
+  return DioPwmChannels;
+}
+
+/**********************************************************************
+* Function : Dio_IrqConfigGet()
+*//**
+* \b Description:
+* This function is used to get the interrupt table of the Dio <br>
+* POST-CONDITION: A constant pointer to the first member of the
+* interrupt table will be returned. <br>
+* @return A pointer to the interrupt table of DIO_IRQ_CHANNELS rows.
+*
+* \b Example:
+* @code
+* Dio_IrqInit(Dio_IrqConfigGet());
+* @endcode
+* @see Dio_IrqInit
+**********************************************************************/
+const DioIrqConfig_t *
+Dio_IrqConfigGet(void)
+{
+  return DioIrqConfig;
+}
+/**********************************************************************
+* Function : Dio_KeypadConfigGet()
+*//**
+* \b Description:
+* This function is used to get the keypad matrix of the Dio <br>
+* POST-CONDITION: A constant pointer to the keypad matrix will be<br>
+* returned. <br>
+* @return A pointer to the keypad matrix.
+*
+* \b Example:
+* @code
+* Dio_KeypadInit(Dio_KeypadConfigGet());
+* @endcode
+* @see Dio_KeypadInit
+**********************************************************************/
+const DioKeypadConfig_t *
+Dio_KeypadConfigGet(void)
+{
+  return &DioKeypadConfig;
+}
 /************************ END OF FILE ********************************/
@@ -0,0 +1,271 @@
+/**
+ * @file dio_edge.c
+ * @author Mohamed Hassanin
+ * @brief The implementation for the dio edge detection.
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include <stddef.h>
+#include "dio_edge.h" /* For this modules definitions */
+#include "dio.h" /* For the port interface */
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The snapshot of the last scan and the channels that rose and fell
+* between the last two scans, per port.
+*/
+static DioPortValue_t Dio_EdgeSnapshot[DIO_NUMBER_OF_PORTS];
+static DioPortValue_t Dio_EdgeRising[DIO_NUMBER_OF_PORTS];
+static DioPortValue_t Dio_EdgeFalling[DIO_NUMBER_OF_PORTS];
+/**
+* The channels with a callback for the rising and the falling edge, per
+* port, and the callback of each channel.
+*/
+static DioPortValue_t Dio_EdgeRisingEnabled[DIO_NUMBER_OF_PORTS];
+static DioPortValue_t Dio_EdgeFallingEnabled[DIO_NUMBER_OF_PORTS];
+static DioEdgeCallback_t Dio_EdgeCallbacks[DIO_CHANNEL_MAX];
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/*********************************************************************
+* Function : Dio_EdgeInit()
+*//**
+* \b Description:
+* This function is used to initialize the edge detection. The ports are<br>
+* sampled into the first snapshot and all the callbacks are removed.<br>
+* PRE-CONDITION: Dio_Init has been called <br>
+* POST-CONDITION: The next Dio_ScanChanges reports the changes since<br>
+* this call.<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_Init(Dio_ConfigGet());
+* Dio_EdgeInit();
+* @endcode
+* @see Dio_ScanChanges
+**********************************************************************/
+void
+Dio_EdgeInit(void)
+{
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      Dio_EdgeSnapshot[Port] = Dio_PortRead((DioPort_t)Port);
+      Dio_EdgeRising[Port] = 0;
+      Dio_EdgeFalling[Port] = 0;
+      Dio_EdgeRisingEnabled[Port] = 0;
+      Dio_EdgeFallingEnabled[Port] = 0;
+    }
+
+  for (uint16_t Channel = 0; Channel < DIO_CHANNEL_MAX; Channel++)
+    {
+      Dio_EdgeCallbacks[Channel] = NULL;
+    }
+}
+
+/*********************************************************************
+* Function : Dio_EdgeRegister()
+*//**
+* \b Description:
+* This function is used to register the callback of the edges of a<br>
+* channel, it replaces the previous callback of the channel. A callback<br>
+* registered with DIO_EDGE_NONE or NULL is removed.<br>
+* PRE-CONDITION: Dio_EdgeInit has been called <br>
+* PRE-CONDITION: The channel is within the maximum DioChannel_t definition<br>
+* PRE-CONDITION: The edge is within the maximum DioEdge_t definition<br>
+* POST-CONDITION: Dio_ScanChanges calls the callback on the edges.<br>
+* @param Channel is the DioChannel_t that represents a pin
+* @param Edge is the edges the callback is called for
+* @param Callback is the function called on the edges
+* @return void
+*
+* \b Example:
+* @code
+* Dio_EdgeRegister(PORTD_2, DIO_EDGE_FALLING, Button_Pressed);
+* @endcode
+* @see Dio_ScanChanges
+**********************************************************************/
+void
+Dio_EdgeRegister(DioChannel_t Channel, DioEdge_t Edge,
+                 DioEdgeCallback_t Callback)
+{
+  const DioPort_t Port = DIO_CHANNEL_PORT(Channel);
+  const DioPortValue_t PinMask = DIO_CHANNEL_MASK(Channel);
+
+  if(Callback == NULL)
+    {
+      Edge = DIO_EDGE_NONE;
+    }
+
+  Dio_EdgeCallbacks[Channel] = Callback;
+
+  if(Edge == DIO_EDGE_RISING || Edge == DIO_EDGE_BOTH)
+    {
+      Dio_EdgeRisingEnabled[Port] |= PinMask;
+    }
+  else
+    {
+      Dio_EdgeRisingEnabled[Port] &= (DioPortValue_t)~PinMask;
+    }
+
+  if(Edge == DIO_EDGE_FALLING || Edge == DIO_EDGE_BOTH)
+    {
+      Dio_EdgeFallingEnabled[Port] |= PinMask;
+    }
+  else
+    {
+      Dio_EdgeFallingEnabled[Port] &= (DioPortValue_t)~PinMask;
+    }
+}
+
+/*********************************************************************
+* Function : Dio_ScanChanges()
+*//**
+* \b Description:
+* This function is used to detect the edges of all the channels.<br>
+* All the ports are read back to back into a new snapshot before any is<br>
+* compared, then the rising and falling masks of each port are computed<br>
+* against the previous snapshot. The callbacks of the channels that<br>
+* changed on a registered edge are called, in channel order, after the<br>
+* masks of every port have been updated.<br>
+* PRE-CONDITION: Dio_EdgeInit has been called <br>
+* POST-CONDITION: The snapshot, rising and falling masks are updated and<br>
+* the callbacks of the edges are called.<br>
+* @return The number of ports with a changed channel
+*
+* \b Example:
+* @code
+* while(1)
+* {
+*   if(Dio_ScanChanges() != 0) { ... }
+* }
+* @endcode
+* @see Dio_EdgeRegister
+**********************************************************************/
+uint8_t
+Dio_ScanChanges(void)
+{
+  DioPortValue_t Sample[DIO_NUMBER_OF_PORTS];
+  DioPortValue_t Pending[DIO_NUMBER_OF_PORTS];
+  uint8_t ChangedPorts = 0;
+  uint8_t Dispatch = 0;
+
+  // Sample all the ports first so the snapshot is coherent
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      Sample[Port] = Dio_PortRead((DioPort_t)Port);
+    }
+
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      const DioPortValue_t Changed = (DioPortValue_t)(Sample[Port] ^ Dio_EdgeSnapshot[Port]);
+
+      Dio_EdgeSnapshot[Port] = Sample[Port];
+      Dio_EdgeRising[Port] = (DioPortValue_t)(Changed & Sample[Port]);
+      Dio_EdgeFalling[Port] = (DioPortValue_t)(Changed & ~Sample[Port]);
+      Pending[Port] = (DioPortValue_t)((Dio_EdgeRising[Port] & Dio_EdgeRisingEnabled[Port])
+                                       | (Dio_EdgeFalling[Port] & Dio_EdgeFallingEnabled[Port]));
+      ChangedPorts += (Changed != 0);
+      Dispatch |= (Pending[Port] != 0);
+    }
+
+  if(Dispatch == 0)
+    {
+      return ChangedPorts;
+    }
+
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      const DioChannel_t First = (DioChannel_t)(Port * DIO_CHANNELS_PER_PORT);
+
+      for (uint8_t Bit = 0; Pending[Port] != 0; Bit++)
+        {
+          const DioPortValue_t PinMask = (DioPortValue_t)((DioPortValue_t)1U << Bit);
+
+          if(Pending[Port] & PinMask)
+            {
+              Pending[Port] &= (DioPortValue_t)~PinMask;
+              Dio_EdgeCallbacks[First + Bit]((DioChannel_t)(First + Bit),
+                (Sample[Port] & PinMask) ? DIO_STATE_HIGH : DIO_STATE_LOW);
+            }
+        }
+    }
+
+  return ChangedPorts;
+}
+
+/*********************************************************************
+* Function : Dio_EdgeSnapshotGet()
+*//**
+* \b Description:
+* This function is used to get the state of the channels of a port in<br>
+* the snapshot of the last scan. The snapshots of all the ports are<br>
+* sampled together, unlike consecutive Dio_ChannelRead calls.<br>
+* PRE-CONDITION: Dio_EdgeInit has been called <br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition<br>
+* @param Port is the DioPort_t that represents the port
+* @return The port value of the last snapshot
+*
+* \b Example:
+* @code
+* DioPortValue_t Inputs = Dio_EdgeSnapshotGet(DIO_PORTB);
+* @endcode
+* @see Dio_ScanChanges
+**********************************************************************/
+DioPortValue_t
+Dio_EdgeSnapshotGet(DioPort_t Port)
+{
+  return Dio_EdgeSnapshot[Port];
+}
+
+/*********************************************************************
+* Function : Dio_EdgeRisingGet()
+*//**
+* \b Description:
+* This function is used to get the channels of a port that rose (went<br>
+* from low to high) between the last two scans.<br>
+* PRE-CONDITION: Dio_EdgeInit has been called <br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition<br>
+* @param Port is the DioPort_t that represents the port
+* @return The mask of the rising channels of the port
+*
+* \b Example:
+* @code
+* if(Dio_EdgeRisingGet(DIO_PORTB) & DIO_CHANNEL_MASK(PORTB_1)) { ... }
+* @endcode
+* @see Dio_EdgeFallingGet
+**********************************************************************/
+DioPortValue_t
+Dio_EdgeRisingGet(DioPort_t Port)
+{
+  return Dio_EdgeRising[Port];
+}
+
+/*********************************************************************
+* Function : Dio_EdgeFallingGet()
+*//**
+* \b Description:
+* This function is used to get the channels of a port that fell (went<br>
+* from high to low) between the last two scans.<br>
+* PRE-CONDITION: Dio_EdgeInit has been called <br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition<br>
+* @param Port is the DioPort_t that represents the port
+* @return The mask of the falling channels of the port
+*
+* \b Example:
+* @code
+* if(Dio_EdgeFallingGet(DIO_PORTB) & DIO_CHANNEL_MASK(PORTB_1)) { ... }
+* @endcode
+* @see Dio_EdgeRisingGet
+**********************************************************************/
+DioPortValue_t
+Dio_EdgeFallingGet(DioPort_t Port)
+{
+  return Dio_EdgeFalling[Port];
+}
+/*************** END OF FUNCTIONS ********************************/
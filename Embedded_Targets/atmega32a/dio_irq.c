@@ -0,0 +1,328 @@
+/**
+ * @file dio_irq.c
+ * @author Mohamed Hassanin
+ * @brief The implementation for the dio interrupt driven inputs on the
+ * external interrupts INT0, INT1 and INT2 of the ATmega32A. Each external
+ * interrupt belongs to a single channel and senses its edges in hardware,
+ * so its vector alone names the channel that changed. INT2 senses a
+ * single edge, both edges are sensed by arming it for the edge away from
+ * the level sampled by each interrupt.
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_irq.h" /* For this modules definitions */
+#include "dio_memmap.h" /* For Hardware definitions */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+#if (DIO_IRQ_QUEUE_SIZE & (DIO_IRQ_QUEUE_SIZE - 1U)) != 0 || DIO_IRQ_QUEUE_SIZE > 128U
+#error "DIO_IRQ_QUEUE_SIZE must be a power of two of at most 128"
+#endif
+/**
+* Wraps an index of the event queue.
+*/
+#define DIO_IRQ_QUEUE_MASK (DIO_IRQ_QUEUE_SIZE - 1U)
+/**
+* The enable bits of the external interrupts in GICR, their flags in GIFR
+* are at the same positions.
+*/
+#define DIO_IRQ_INT0 0x40U
+#define DIO_IRQ_INT1 0x80U
+#define DIO_IRQ_INT2 0x20U
+#define DIO_IRQ_INT_ALL (DIO_IRQ_INT0 | DIO_IRQ_INT1 | DIO_IRQ_INT2)
+/**
+* The sense control bits of INT0 and INT1 in MCUCR, and of INT2 in MCUCSR.
+*/
+#define DIO_IRQ_ISC0_SHIFT 0U
+#define DIO_IRQ_ISC1_SHIFT 2U
+#define DIO_IRQ_ISC_MASK 0x03U
+#define DIO_IRQ_ISC2 0x40U
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The event queue. The head is written by the interrupts only and the
+* tail by Dio_IrqEventsRead only.
+*/
+static DioIrqEvent_t Dio_IrqQueue[DIO_IRQ_QUEUE_SIZE];
+static volatile uint8_t Dio_IrqHead;
+static volatile uint8_t Dio_IrqTail;
+/**
+* The number of events lost because the queue was full.
+*/
+static volatile uint16_t Dio_IrqOverflows;
+/**
+* The sense control of INT0 and INT1 for each DioIrqEdge_t.
+*/
+static const uint8_t Dio_IrqSense[DIO_IRQ_EDGE_MAX] =
+{
+  0x03, /* DIO_IRQ_RISING */
+  0x02, /* DIO_IRQ_FALLING */
+  0x01, /* DIO_IRQ_BOTH, any logical change */
+};
+/**
+* Set when INT2 senses both edges.
+*/
+static uint8_t Dio_IrqInt2Both;
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : Dio_IrqPush()
+*//**
+* \b Description:
+* Appends an event to the queue, or counts an overflow when it is full.
+* Called from the interrupts only.
+**********************************************************************/
+static inline void
+Dio_IrqPush(uint8_t Port, DioPortValue_t Changed, DioPortValue_t Level)
+{
+  const uint8_t Head = Dio_IrqHead;
+  const uint8_t Next = (uint8_t)((Head + 1U) & DIO_IRQ_QUEUE_MASK);
+
+  if(Next == Dio_IrqTail)
+    {
+      Dio_IrqOverflows++;
+      return;
+    }
+
+  Dio_IrqQueue[Head].Port = Port;
+  Dio_IrqQueue[Head].Changed = Changed;
+  Dio_IrqQueue[Head].Level = Level;
+  // Publish the entry only after it is written
+  DIO_MEMORY_BARRIER();
+  Dio_IrqHead = Next;
+}
+
+/**********************************************************************
+* Function : Dio_IrqInt2Arm()
+*//**
+* \b Description:
+* Arms INT2 for the edge away from Level. A change of ISC2 can raise a
+* false interrupt, so INT2 is disabled meanwhile and its flag is cleared.
+**********************************************************************/
+static inline void
+Dio_IrqInt2Arm(DioPortValue_t Level)
+{
+  const uint8_t Gicr = DIO_REG_READ((volatile uint8_t *)GICR);
+  uint8_t Mcucsr = (uint8_t)(DIO_REG_READ((volatile uint8_t *)MCUCSR) & ~DIO_IRQ_ISC2);
+
+  if((Level & DIO_CHANNEL_MASK(PORTB_2)) == 0)
+    {
+      Mcucsr |= DIO_IRQ_ISC2;
+    }
+
+  DIO_REG_WRITE((volatile uint8_t *)GICR, (uint8_t)(Gicr & ~DIO_IRQ_INT2));
+  DIO_REG_WRITE((volatile uint8_t *)MCUCSR, Mcucsr);
+  DIO_REG_WRITE((volatile uint8_t *)GIFR, DIO_IRQ_INT2);
+  DIO_REG_WRITE((volatile uint8_t *)GICR, Gicr);
+}
+
+DIO_ISR(DIO_INT0_VECTOR, Dio_IrqInt0)
+{
+  Dio_IrqPush(DIO_PORTD, DIO_CHANNEL_MASK(PORTD_2),
+              DIO_REG_READ((volatile uint8_t *)PIND));
+}
+
+DIO_ISR(DIO_INT1_VECTOR, Dio_IrqInt1)
+{
+  Dio_IrqPush(DIO_PORTD, DIO_CHANNEL_MASK(PORTD_3),
+              DIO_REG_READ((volatile uint8_t *)PIND));
+}
+
+DIO_ISR(DIO_INT2_VECTOR, Dio_IrqInt2)
+{
+  DioPortValue_t Level = DIO_REG_READ((volatile uint8_t *)PINB);
+
+  Dio_IrqPush(DIO_PORTB, DIO_CHANNEL_MASK(PORTB_2), Level);
+
+  // Re-arm for the opposite edge, an edge missed while arming is found by
+  // sampling the channel again
+  while(Dio_IrqInt2Both != 0)
+    {
+      DioPortValue_t Now;
+
+      Dio_IrqInt2Arm(Level);
+      Now = DIO_REG_READ((volatile uint8_t *)PINB);
+      if(((Now ^ Level) & DIO_CHANNEL_MASK(PORTB_2)) == 0)
+        {
+          break;
+        }
+      Level = Now;
+      Dio_IrqPush(DIO_PORTB, DIO_CHANNEL_MASK(PORTB_2), Level);
+    }
+}
+
+/*********************************************************************
+* Function : Dio_IrqInit()
+*//**
+* \b Description:
+* This function is used to enable the external interrupts of the<br>
+* channels of an interrupt table. The external interrupts without an<br>
+* interrupt driven channel are disabled, the event queue and the overflow<br>
+* counter are cleared.<br>
+* PRE-CONDITION: Dio_Init has been called <br>
+* PRE-CONDITION: The table has DIO_IRQ_CHANNELS rows of the channels<br>
+* PORTD_2 (INT0), PORTD_3 (INT1) and PORTB_2 (INT2) <br>
+* POST-CONDITION: The edges of the channels are queued as events once<br>
+* the global interrupts are enabled.<br>
+* @param Config is a pointer to the interrupt table
+* @return void
+*
+* \b Example:
+* @code
+* Dio_IrqInit(Dio_IrqConfigGet());
+* sei();
+* @endcode
+* @see Dio_IrqEventsRead
+**********************************************************************/
+void
+Dio_IrqInit(const DioIrqConfig_t * const Config)
+{
+  uint8_t Enabled = 0;
+  uint8_t Mcucr;
+  uint8_t Mcucsr;
+  uint8_t Sreg;
+
+  DIO_CRITICAL_ENTER(Sreg);
+
+  // The sense controls are changed with the external interrupts disabled
+  DIO_REG_WRITE((volatile uint8_t *)GICR,
+                (uint8_t)(DIO_REG_READ((volatile uint8_t *)GICR) & ~DIO_IRQ_INT_ALL));
+  Mcucr = DIO_REG_READ((volatile uint8_t *)MCUCR);
+  Mcucsr = (uint8_t)(DIO_REG_READ((volatile uint8_t *)MCUCSR) & ~DIO_IRQ_ISC2);
+  Dio_IrqInt2Both = 0;
+
+  for (uint8_t Row = 0; Row < DIO_IRQ_CHANNELS; Row++)
+    {
+      const DioIrqEdge_t Edge = Config[Row].Edge;
+
+      switch (Config[Row].Channel)
+        {
+        case PORTD_2:
+          Enabled |= DIO_IRQ_INT0;
+          Mcucr = (uint8_t)((Mcucr & ~(DIO_IRQ_ISC_MASK << DIO_IRQ_ISC0_SHIFT))
+                            | (Dio_IrqSense[Edge] << DIO_IRQ_ISC0_SHIFT));
+          break;
+        case PORTD_3:
+          Enabled |= DIO_IRQ_INT1;
+          Mcucr = (uint8_t)((Mcucr & ~(DIO_IRQ_ISC_MASK << DIO_IRQ_ISC1_SHIFT))
+                            | (Dio_IrqSense[Edge] << DIO_IRQ_ISC1_SHIFT));
+          break;
+        case PORTB_2:
+          Enabled |= DIO_IRQ_INT2;
+          if(Edge == DIO_IRQ_RISING)
+            {
+              Mcucsr |= DIO_IRQ_ISC2;
+            }
+          else if(Edge == DIO_IRQ_BOTH)
+            {
+              Dio_IrqInt2Both = 1;
+              if((DIO_REG_READ((volatile uint8_t *)PINB) & DIO_CHANNEL_MASK(PORTB_2)) == 0)
+                {
+                  Mcucsr |= DIO_IRQ_ISC2;
+                }
+            }
+          break;
+        default:
+          //TODO: implement your error handling method
+          break;
+        }
+    }
+
+  Dio_IrqHead = 0;
+  Dio_IrqTail = 0;
+  Dio_IrqOverflows = 0;
+
+  DIO_ISR_CONNECT(DIO_INT0_VECTOR, Dio_IrqInt0);
+  DIO_ISR_CONNECT(DIO_INT1_VECTOR, Dio_IrqInt1);
+  DIO_ISR_CONNECT(DIO_INT2_VECTOR, Dio_IrqInt2);
+
+  DIO_REG_WRITE((volatile uint8_t *)MCUCR, Mcucr);
+  DIO_REG_WRITE((volatile uint8_t *)MCUCSR, Mcucsr);
+  // Drop the edges flagged before the sense controls were set
+  DIO_REG_WRITE((volatile uint8_t *)GIFR, DIO_IRQ_INT_ALL);
+  DIO_REG_WRITE((volatile uint8_t *)GICR,
+                (uint8_t)(DIO_REG_READ((volatile uint8_t *)GICR) | Enabled));
+
+  DIO_CRITICAL_EXIT(Sreg);
+}
+
+/*********************************************************************
+* Function : Dio_IrqEventsRead()
+*//**
+* \b Description:
+* This function is used to drain up to Max events from the event queue,<br>
+* oldest first. It is called from the main loop; the interrupts keep<br>
+* queueing events while it runs.<br>
+* PRE-CONDITION: Dio_IrqInit has been called <br>
+* POST-CONDITION: The returned events are removed from the queue.<br>
+* @param Events receives the events
+* @param Max is the number of entries of Events
+* @return The number of events written to Events
+*
+* \b Example:
+* @code
+* DioIrqEvent_t Events[8];
+* uint8_t Count = Dio_IrqEventsRead(Events, 8);
+* for (uint8_t i = 0; i < Count; i++) { ... }
+* @endcode
+* @see Dio_IrqOverflowsGet
+**********************************************************************/
+uint8_t
+Dio_IrqEventsRead(DioIrqEvent_t * const Events, uint8_t Max)
+{
+  const uint8_t Head = Dio_IrqHead;
+  uint8_t Tail = Dio_IrqTail;
+  uint8_t Count = 0;
+
+  // Read the entries only after the head that published them
+  DIO_MEMORY_BARRIER();
+
+  while(Tail != Head && Count < Max)
+    {
+      Events[Count] = Dio_IrqQueue[Tail];
+      Count++;
+      Tail = (uint8_t)((Tail + 1U) & DIO_IRQ_QUEUE_MASK);
+    }
+
+  // Free the entries only after they are copied
+  DIO_MEMORY_BARRIER();
+  Dio_IrqTail = Tail;
+
+  return Count;
+}
+
+/*********************************************************************
+* Function : Dio_IrqOverflowsGet()
+*//**
+* \b Description:
+* This function is used to get the number of events lost because the<br>
+* event queue was full since Dio_IrqInit.<br>
+* PRE-CONDITION: Dio_IrqInit has been called <br>
+* @return The number of lost events
+*
+* \b Example:
+* @code
+* if(Dio_IrqOverflowsGet() != 0) { ... }
+* @endcode
+* @see Dio_IrqEventsRead
+**********************************************************************/
+uint16_t
+Dio_IrqOverflowsGet(void)
+{
+  uint16_t Overflows;
+  uint8_t Sreg;
+
+  // The 16-bit counter is read in two halves, keep the interrupts out
+  DIO_CRITICAL_ENTER(Sreg);
+  Overflows = Dio_IrqOverflows;
+  DIO_CRITICAL_EXIT(Sreg);
+
+  return Overflows;
+}
+/*************** END OF FUNCTIONS ********************************/
@@ -0,0 +1,49 @@
+/**
+ * @file dio_irq.h
+ * @author Mohamed Hassanin
+ * @brief The interface definition for the dio interrupt driven inputs.
+ * The interrupts of the channels of the interrupt table capture their
+ * edges as events in a single-producer/single-consumer queue: the
+ * interrupts only write its head and Dio_IrqEventsRead only writes its
+ * tail, so neither side locks the other out. The main loop drains the
+ * events in batches; the events that find the queue full are counted as
+ * overflows.
+ * @version 0.1
+ * @date 2021-01-12
+*/
+#ifndef DIO_IRQ_H_
+#define DIO_IRQ_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_cfg.h" /**< For dio configuration */
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+* Defines an event captured by an interrupt.
+*/
+typedef struct
+{
+	uint8_t Port; /**< The DioPort_t of the channels */
+	DioPortValue_t Changed; /**< The channels of the port that raised the event */
+	DioPortValue_t Level; /**< The port level sampled by the interrupt */
+}DioIrqEvent_t;
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void Dio_IrqInit(const DioIrqConfig_t * const Config);
+uint8_t Dio_IrqEventsRead(DioIrqEvent_t * const Events, uint8_t Max);
+uint16_t Dio_IrqOverflowsGet(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* DIO_IRQ_H_*/
+/*************** END OF FILE ********************************/
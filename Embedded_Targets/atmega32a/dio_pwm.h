@@ -0,0 +1,46 @@
+/**
+ * @file dio_pwm.h
+ * @author Mohamed Hassanin
+ * @brief The interface definition for the dio software PWM.
+ * The duty cycles of the channels of the PWM table are compiled into a
+ * timeline of frames: the tick of each frame in the period and the value
+ * of the PWM channels of every port from that tick on. A tick only
+ * writes the ports when it reaches the next frame, with one masked write
+ * per port whatever the number of channels. The timelines are double
+ * buffered, new duty cycles take effect at the start of a period.
+ * @version 0.1
+ * @date 2021-01-12
+*/
+#ifndef DIO_PWM_H_
+#define DIO_PWM_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_cfg.h" /**< For dio configuration */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the period of the software PWM in ticks, the duty cycle of a
+* channel that is always HIGH.
+*/
+#define DIO_PWM_PERIOD ((uint16_t)((1UL << DIO_PWM_BITS) - 1U))
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void Dio_PwmInit(const DioChannel_t * const Channels);
+void Dio_PwmDutySet(uint8_t Index, uint16_t Duty);
+void Dio_PwmCommit(void);
+void Dio_PwmTick(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* DIO_PWM_H_*/
+/*************** END OF FILE ********************************/
@@ -0,0 +1,204 @@
+/** 
+ * @file dio_set.c
+ * @author Mohamed Hassanin
+ * @brief The implementation for the dio channel sets.
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_set.h" /* For this modules definitions */
+#include "dio.h" /* For the port interface */
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/*********************************************************************
+* Function : Dio_ChannelSetCompile()
+*//**
+* \b Description:
+* This function is used to compile a list of channels into a channel set.<br>
+* Channel n of the list is bit n of the packed value used by <br>
+* Dio_ChannelSetWrite and Dio_ChannelSetRead. The channels are grouped <br>
+* by port, and a port whose channels map to the packed value by a single <br>
+* shift is marked linear so that it is converted without a loop.<br>
+* PRE-CONDITION: Count <= DIO_SET_CHANNELS_MAX <br>
+* PRE-CONDITION: The channels are distinct and within the maximum <br>
+* DioChannel_t definition <br>
+* POST-CONDITION: Set holds the plan of the channel list.<br>
+* @param Set is the channel set to compile
+* @param Channels is the list of channels
+* @param Count is the number of channels of the list
+* @return void
+*
+* \b Example:
+* @code
+* static const DioChannel_t Word[] = { PORTB_0, PORTC_3, PORTD_7 };
+* static DioChannelSet_t WordSet;
+* Dio_ChannelSetCompile(&WordSet, Word, 3);
+* @endcode
+* @see Dio_ChannelSetWrite
+**********************************************************************/
+void
+Dio_ChannelSetCompile(DioChannelSet_t * const Set,
+                      const DioChannel_t * const Channels, uint8_t Count)
+{
+  uint8_t Entry = 0; // Next entry of the channel maps
+
+  if(Count > DIO_SET_CHANNELS_MAX)
+    {
+      //TODO: implement your error handling method
+      Count = DIO_SET_CHANNELS_MAX;
+    }
+
+  Set->PortCount = 0;
+
+  // Walk the ports in order and append the channels of each port, so the
+  // channel maps of a port are contiguous
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      DioSetPort_t * const SetPort = &Set->Ports[Set->PortCount];
+
+      SetPort->Port = (DioPort_t)Port;
+      SetPort->Mask = 0;
+      SetPort->First = Entry;
+      SetPort->Count = 0;
+      SetPort->Linear = 1;
+      SetPort->Shift = 0;
+
+      for (uint8_t Bit = 0; Bit < Count; Bit++)
+        {
+          if(DIO_CHANNEL_PORT(Channels[Bit]) != Port)
+            {
+              continue;
+            }
+
+          int8_t Shift = (int8_t)((Channels[Bit] % DIO_CHANNELS_PER_PORT) - Bit);
+
+          if(SetPort->Count == 0)
+            {
+              SetPort->Shift = Shift;
+            }
+          else if(SetPort->Shift != Shift)
+            {
+              SetPort->Linear = 0;
+            }
+
+          Set->Bit[Entry] = Bit;
+          Set->PinMask[Entry] = DIO_CHANNEL_MASK(Channels[Bit]);
+          SetPort->Mask |= Set->PinMask[Entry];
+          SetPort->Count++;
+          Entry++;
+        }
+
+      if(SetPort->Count != 0)
+        {
+          Set->PortCount++;
+        }
+    }
+}
+
+/*********************************************************************
+* Function : Dio_ChannelSetWrite()
+*//**
+* \b Description:
+* This function is used to write all the channels of a channel set, with<br>
+* one read-modify-write of the data output register per touched port.<br>
+* The ports are written one after the other, in port order.<br>
+* PRE-CONDITION: The set is compiled by Dio_ChannelSetCompile <br>
+* PRE-CONDITION: The channels of the set are configured as OUTPUT <br>
+* POST-CONDITION: Channel n of the set is at the state of bit n of Bits.<br>
+* @param Set is the channel set to write
+* @param Bits is the packed value, bit n for channel n of the set
+* @return void
+*
+* \b Example:
+* @code
+* Dio_ChannelSetWrite(&WordSet, 0x5); // PORTB_0 and PORTD_7 high
+* @endcode
+* @see Dio_ChannelSetRead
+**********************************************************************/
+void
+Dio_ChannelSetWrite(const DioChannelSet_t * const Set, uint32_t Bits)
+{
+  for (uint8_t i = 0; i < Set->PortCount; i++)
+    {
+      const DioSetPort_t * const SetPort = &Set->Ports[i];
+      uint32_t Value = 0; // The port bits of the set
+
+      if(SetPort->Linear)
+        {
+          Value = (SetPort->Shift >= 0) ? (Bits << SetPort->Shift)
+                                        : (Bits >> -SetPort->Shift);
+        }
+      else
+        {
+          for (uint8_t Entry = SetPort->First;
+               Entry < SetPort->First + SetPort->Count; Entry++)
+            {
+              if((Bits >> Set->Bit[Entry]) & 1UL)
+                {
+                  Value |= Set->PinMask[Entry];
+                }
+            }
+        }
+
+      Dio_PortWriteMasked(SetPort->Port, SetPort->Mask, (DioPortValue_t)Value);
+    }
+}
+
+/*********************************************************************
+* Function : Dio_ChannelSetRead()
+*//**
+* \b Description:
+* This function is used to read all the channels of a channel set. The <br>
+* touched ports are read back to back, one read per port, before the <br>
+* packed value is built, so the result is a coherent sample.<br>
+* PRE-CONDITION: The set is compiled by Dio_ChannelSetCompile <br>
+* POST-CONDITION: The packed state of the set is returned.<br>
+* @param Set is the channel set to read
+* @return The packed value, bit n for channel n of the set
+*
+* \b Example:
+* @code
+* uint32_t Word = Dio_ChannelSetRead(&WordSet);
+* @endcode
+* @see Dio_ChannelSetWrite
+**********************************************************************/
+uint32_t
+Dio_ChannelSetRead(const DioChannelSet_t * const Set)
+{
+  DioPortValue_t Sample[DIO_NUMBER_OF_PORTS]; // The port states
+  uint32_t Bits = 0; // The packed value
+
+  for (uint8_t i = 0; i < Set->PortCount; i++)
+    {
+      Sample[i] = Dio_PortRead(Set->Ports[i].Port);
+    }
+
+  for (uint8_t i = 0; i < Set->PortCount; i++)
+    {
+      const DioSetPort_t * const SetPort = &Set->Ports[i];
+      uint32_t Value = Sample[i] & SetPort->Mask;
+
+      if(SetPort->Linear)
+        {
+          Bits |= (SetPort->Shift >= 0) ? (Value >> SetPort->Shift)
+                                        : (Value << -SetPort->Shift);
+        }
+      else
+        {
+          for (uint8_t Entry = SetPort->First;
+               Entry < SetPort->First + SetPort->Count; Entry++)
+            {
+              if(Value & Set->PinMask[Entry])
+                {
+                  Bits |= 1UL << Set->Bit[Entry];
+                }
+            }
+        }
+    }
+  return Bits;
+}
+/*************** END OF FUNCTIONS ********************************/
@@ -0,0 +1,72 @@
+/** 
+ * @file dio_set.h
+ * @author Mohamed Hassanin
+ * @brief The interface definition for the dio channel sets.
+ * A channel set is a list of arbitrary channels, spread over any ports,
+ * that is compiled once into a plan holding per-port masks and the
+ * position of every channel in a packed value. The set is then written
+ * with at most one read-modify-write per port and read with at most one
+ * read per port.
+ * @version 0.1
+ * @date 2021-01-12
+*/
+#ifndef DIO_SET_H_
+#define DIO_SET_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_cfg.h" /**< For dio configuration */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the maximum number of channels of a set, the width of the
+* packed value.
+*/
+#define DIO_SET_CHANNELS_MAX 32U
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+* Defines the part of a channel set on one port.
+*/
+typedef struct
+{
+	DioPort_t Port; /**< The port */
+	DioPortValue_t Mask; /**< The channels of the set in the port */
+	uint8_t First; /**< The first entry of the port in the channel maps */
+	uint8_t Count; /**< The number of channels of the set in the port */
+	uint8_t Linear; /**< Packed bits map to the port bits by a shift */
+	int8_t Shift; /**< The shift from the packed value to the port */
+}DioSetPort_t;
+
+/**
+* Defines a compiled channel set (plan). The channel maps are sorted by
+* port, entry n maps packed bit Bit[n] to the port bits PinMask[n].
+*/
+typedef struct
+{
+	uint8_t PortCount; /**< The number of ports touched by the set */
+	DioSetPort_t Ports[DIO_NUMBER_OF_PORTS]; /**< The touched ports */
+	uint8_t Bit[DIO_SET_CHANNELS_MAX]; /**< Position in the packed value */
+	DioPortValue_t PinMask[DIO_SET_CHANNELS_MAX]; /**< Mask in the port */
+}DioChannelSet_t;
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void Dio_ChannelSetCompile(DioChannelSet_t * const Set,
+                           const DioChannel_t * const Channels, uint8_t Count);
+void Dio_ChannelSetWrite(const DioChannelSet_t * const Set, uint32_t Bits);
+uint32_t Dio_ChannelSetRead(const DioChannelSet_t * const Set);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* DIO_SET_H_*/
+/*************** END OF FILE ********************************/
@@ -0,0 +1,675 @@
+/** 
+ * @file dio_bench.c
+ * @author Mohamed Hassanin
+ * @brief Benchmarks of the dio interface on the host simulation.
+ * Every benchmark reports the host time per operation and the number of
+ * register reads and writes per operation counted by the simulation, and
+ * the accesses made with the interrupts disabled. The
+ * register counts do not depend on the host, they are checked against the
+ * budgets of dio_bench_budget.csv so that an extra register access on a
+ * hot path fails the run. The time is informational, it includes the
+ * simulation overhead and is only comparable between runs on one host.
+ *
+ * \b Example (from Embedded_Targets):
+ * @code
+ * gcc -O2 -DDIO_SIM -DDIO_BENCH_TARGET=\"atmega328p\" -Iatmega328p \
+ *     -Ihost_sim atmega328p/dio*.c host_sim/dio_sim.c host_sim/dio_bench.c \
+ *     -o dio_bench
+ * ./dio_bench --budget host_sim/dio_bench_budget.csv      # CSV report
+ * ./dio_bench --json                                       # JSON report
+ * @endcode
+ * A target with the core driver and the edge detection only (sim32) is
+ * built with its *.c files and -DDIO_BENCH_MODULES=0, which leaves out
+ * the benchmarks of the other modules.
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#define _POSIX_C_SOURCE 199309L /* For clock_gettime */
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "dio.h" /* For the interface under benchmark */
+#include "dio_edge.h" /* For the edge detection */
+#ifndef DIO_BENCH_MODULES
+#define DIO_BENCH_MODULES STD_ON /* Benchmarks the modules built on dio.c */
+#endif
+#if DIO_BENCH_MODULES == STD_ON
+#include "dio_set.h" /* For the channel sets */
+#include "dio_debounce.h" /* For the debouncing */
+#include "dio_pwm.h" /* For the software PWM */
+#include "dio_pattern.h" /* For the pattern playback */
+#include "dio_bb.h" /* For the bit-banged protocols */
+#include "dio_keypad.h" /* For the keypad scanner */
+#include "dio_ext.h" /* For the pull-up resistors */
+#endif
+#include "dio_sim.h" /* For the register access counters */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the name of the target the benchmark is built for, it selects
+* the rows of the budget file.
+*/
+#ifndef DIO_BENCH_TARGET
+#define DIO_BENCH_TARGET "unknown"
+#endif
+/**
+* Defines the default number of operations of each benchmark.
+*/
+#define DIO_BENCH_OPS 200000UL
+/**
+* Defines the maximum number of benchmarks.
+*/
+#define DIO_BENCH_MAX 32U
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+* Defines a benchmark: Run performs Ops operations.
+*/
+typedef struct
+{
+	const char * Name; /**< The benchmark name in the report and budget */
+	void (*Run)(uint32_t Ops); /**< Performs the operations */
+}DioBench_t;
+
+/**
+* Defines the result of a benchmark.
+*/
+typedef struct
+{
+	const char * Name; /**< The benchmark name */
+	uint32_t Ops; /**< Number of operations */
+	double NsPerOp; /**< Host time per operation */
+	double ReadsPerOp; /**< Register reads per operation */
+	double WritesPerOp; /**< Register writes per operation */
+	double MaskedPerOp; /**< Accesses with the interrupts disabled per operation */
+}DioBenchResult_t;
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The channel exercised by the single channel benchmarks and the port
+* exercised by the bus benchmarks, the last port of the target.
+*/
+static const DioChannel_t DioBench_Channel = (DioChannel_t)(DIO_CHANNEL_MAX - 1U);
+static const DioPort_t DioBench_Port = (DioPort_t)(DIO_PORT_MAX - 1U);
+#if DIO_BENCH_MODULES == STD_ON
+/**
+* The scattered channels of the channel set benchmarks, spread evenly
+* over all the ports, and their compiled set.
+*/
+#define DIO_BENCH_SET_SIZE 8U
+static DioChannel_t DioBench_SetChannels[DIO_BENCH_SET_SIZE];
+static DioChannelSet_t DioBench_Set;
+/**
+* The samples of the pattern benchmark, played as one buffer per operation.
+*/
+#define DIO_BENCH_PATTERN_SIZE 256U
+static DioPortValue_t DioBench_Pattern[DIO_BENCH_PATTERN_SIZE];
+#endif
+/**
+* Defeats the optimization of the reads.
+*/
+static volatile uint32_t DioBench_Sink;
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+static void
+DioBench_Init(uint32_t Ops)
+{
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_Init(Dio_ConfigGet());
+    }
+}
+
+static void
+DioBench_InitPorts(uint32_t Ops)
+{
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_InitPorts(Dio_PortConfigGet());
+    }
+}
+
+static void
+DioBench_ApplyProfile(uint32_t Ops)
+{
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_ApplyProfile((i & 1U) ? DIO_PROFILE_ACTIVE : DIO_PROFILE_SLEEP);
+    }
+}
+
+#if DIO_BENCH_MODULES == STD_ON
+static void
+DioBench_PortSetPullups(uint32_t Ops)
+{
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_PortSetPullups((DioPort_t)0, (DioPortValue_t)i);
+    }
+}
+#endif
+
+static void
+DioBench_ChannelWrite(uint32_t Ops)
+{
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_ChannelWrite(DioBench_Channel, (DioState_t)(i & 1U));
+    }
+}
+
+static void
+DioBench_ChannelWriteAtomic(uint32_t Ops)
+{
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_ChannelWriteAtomic(DioBench_Channel, (DioState_t)(i & 1U));
+    }
+}
+
+static void
+DioBench_SetChannelDirectionAtomic(uint32_t Ops)
+{
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_SetChannelDirectionAtomic(DioBench_Channel, (DioDirection_t)(i & 1U));
+    }
+}
+
+static void
+DioBench_PortWriteMaskedAtomic(uint32_t Ops)
+{
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_PortWriteMaskedAtomic(DioBench_Port, (DioPortValue_t)~(DioPortValue_t)0, (DioPortValue_t)i);
+    }
+}
+
+static void
+DioBench_ChannelRead(uint32_t Ops)
+{
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      DioBench_Sink += Dio_ChannelRead(DioBench_Channel);
+    }
+}
+
+static void
+DioBench_SetChannelDirection(uint32_t Ops)
+{
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_SetChannelDirection(DioBench_Channel, (DioDirection_t)(i & 1U));
+    }
+}
+
+static void
+DioBench_BusWritePerPin(uint32_t Ops)
+{
+  DioChannel_t First = (DioChannel_t)(DioBench_Port * DIO_CHANNELS_PER_PORT);
+
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      for (uint8_t Bit = 0; Bit < DIO_CHANNELS_PER_PORT; Bit++)
+        {
+          Dio_ChannelWrite((DioChannel_t)(First + Bit),
+                           (DioState_t)((i >> Bit) & 1U));
+        }
+    }
+}
+
+static void
+DioBench_BusWriteMasked(uint32_t Ops)
+{
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_PortWriteMasked(DioBench_Port, (DioPortValue_t)~(DioPortValue_t)0, (DioPortValue_t)i);
+    }
+}
+
+static void
+DioBench_BusReadPerPin(uint32_t Ops)
+{
+  DioChannel_t First = (DioChannel_t)(DioBench_Port * DIO_CHANNELS_PER_PORT);
+
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      uint32_t Value = 0;
+
+      for (uint8_t Bit = 0; Bit < DIO_CHANNELS_PER_PORT; Bit++)
+        {
+          Value |= (uint32_t)Dio_ChannelRead((DioChannel_t)(First + Bit)) << Bit;
+        }
+      DioBench_Sink += Value;
+    }
+}
+
+static void
+DioBench_BusReadPort(uint32_t Ops)
+{
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      DioBench_Sink += Dio_PortRead(DioBench_Port);
+    }
+}
+
+static void
+DioBench_GroupWrite(uint32_t Ops)
+{
+  const DioGroup_t * const Group = &Dio_GroupConfigGet()[0];
+
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_GroupWrite(Group, (DioPortValue_t)i);
+    }
+}
+
+static void
+DioBench_GroupRead(uint32_t Ops)
+{
+  const DioGroup_t * const Group = &Dio_GroupConfigGet()[0];
+
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      DioBench_Sink += Dio_GroupRead(Group);
+    }
+}
+
+#if DIO_BENCH_MODULES == STD_ON
+static void
+DioBench_SetPrepare(void)
+{
+  for (uint8_t i = 0; i < DIO_BENCH_SET_SIZE; i++)
+    {
+      DioBench_SetChannels[i] = (DioChannel_t)((i * (uint32_t)DIO_CHANNEL_MAX)
+                                               / DIO_BENCH_SET_SIZE);
+    }
+  Dio_ChannelSetCompile(&DioBench_Set, DioBench_SetChannels, DIO_BENCH_SET_SIZE);
+}
+
+static void
+DioBench_SetWritePerPin(uint32_t Ops)
+{
+  DioBench_SetPrepare();
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      for (uint8_t Bit = 0; Bit < DIO_BENCH_SET_SIZE; Bit++)
+        {
+          Dio_ChannelWrite(DioBench_SetChannels[Bit], (DioState_t)((i >> Bit) & 1U));
+        }
+    }
+}
+
+static void
+DioBench_SetWrite(uint32_t Ops)
+{
+  DioBench_SetPrepare();
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_ChannelSetWrite(&DioBench_Set, i);
+    }
+}
+
+static void
+DioBench_SetRead(uint32_t Ops)
+{
+  DioBench_SetPrepare();
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      DioBench_Sink += Dio_ChannelSetRead(&DioBench_Set);
+    }
+}
+
+static void
+DioBench_DebounceTick(uint32_t Ops)
+{
+  Dio_DebounceInit(Dio_DebounceConfigGet());
+  DioSim_CountersReset();
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_DebounceTick();
+    }
+}
+
+static void
+DioBench_PwmPeriod(uint32_t Ops)
+{
+  // Distinct duty cycles, the worst case of pulse width modulation
+  Dio_PwmInit(Dio_PwmConfigGet());
+  for (uint8_t Index = 0; Index < DIO_PWM_CHANNELS; Index++)
+    {
+      Dio_PwmDutySet(Index, (uint16_t)(((Index + 1U) * DIO_PWM_PERIOD)
+                                       / (DIO_PWM_CHANNELS + 1U)));
+    }
+  Dio_PwmCommit();
+  DioSim_CountersReset();
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      for (uint16_t Tick = 0; Tick < DIO_PWM_PERIOD; Tick++)
+        {
+          Dio_PwmTick();
+        }
+    }
+}
+
+static void
+DioBench_PatternBuffer(uint32_t Ops)
+{
+  for (uint16_t Sample = 0; Sample < DIO_BENCH_PATTERN_SIZE; Sample++)
+    {
+      DioBench_Pattern[Sample] = (DioPortValue_t)Sample;
+    }
+
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_PatternPlay(DioBench_Port, (DioPortValue_t)~(DioPortValue_t)0,
+                      DioBench_Pattern, DIO_BENCH_PATTERN_SIZE, 1);
+      Dio_PatternEnd();
+      for (uint16_t Sample = 0; Sample < DIO_BENCH_PATTERN_SIZE; Sample++)
+        {
+          Dio_PatternTick();
+        }
+    }
+}
+
+static void
+DioBench_SpiTransfer(uint32_t Ops)
+{
+  Dio_BbSpiInit();
+  DioSim_CountersReset();
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      DioBench_Sink += Dio_BbSpiTransfer((uint8_t)i);
+    }
+}
+
+#endif
+
+static void
+DioBench_ScanChanges(uint32_t Ops)
+{
+  Dio_EdgeInit();
+  DioSim_CountersReset();
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      DioBench_Sink += Dio_ScanChanges();
+    }
+}
+
+#if DIO_SHADOW == STD_ON
+static void
+DioBench_BatchWrite(uint32_t Ops)
+{
+  // A byte written channel by channel, flushed with one port write
+  const DioChannel_t First = (DioChannel_t)(DioBench_Port * DIO_CHANNELS_PER_PORT);
+
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_BeginBatch();
+      for (uint8_t Bit = 0; Bit < DIO_CHANNELS_PER_PORT; Bit++)
+        {
+          Dio_ChannelWrite((DioChannel_t)(First + Bit),
+                           (DioState_t)((i >> Bit) & 1U));
+        }
+      Dio_Commit();
+    }
+}
+#endif
+
+#if DIO_BENCH_MODULES == STD_ON
+static void
+DioBench_KeypadScan(uint32_t Ops)
+{
+  Dio_KeypadInit(Dio_KeypadConfigGet());
+  DioSim_CountersReset();
+  for (uint32_t i = 0; i < Ops; i++)
+    {
+      Dio_KeypadScan();
+    }
+}
+#endif
+
+/**
+* The benchmarks, in report order.
+*/
+static const DioBench_t DioBench_Table[] =
+{
+  { "init", DioBench_Init },
+  { "init_ports", DioBench_InitPorts },
+  { "apply_profile", DioBench_ApplyProfile },
+#if DIO_BENCH_MODULES == STD_ON
+  { "port_set_pullups", DioBench_PortSetPullups },
+#endif
+  { "channel_write", DioBench_ChannelWrite },
+  { "channel_write_atomic", DioBench_ChannelWriteAtomic },
+  { "set_channel_direction_atomic", DioBench_SetChannelDirectionAtomic },
+  { "port_write_masked_atomic", DioBench_PortWriteMaskedAtomic },
+  { "channel_read", DioBench_ChannelRead },
+  { "set_channel_direction", DioBench_SetChannelDirection },
+  { "bus_write_per_pin", DioBench_BusWritePerPin },
+  { "bus_write_masked", DioBench_BusWriteMasked },
+  { "bus_read_per_pin", DioBench_BusReadPerPin },
+  { "bus_read_port", DioBench_BusReadPort },
+  { "group_write", DioBench_GroupWrite },
+  { "group_read", DioBench_GroupRead },
+#if DIO_BENCH_MODULES == STD_ON
+  { "set_write_per_pin", DioBench_SetWritePerPin },
+  { "set_write", DioBench_SetWrite },
+  { "set_read", DioBench_SetRead },
+  { "debounce_tick", DioBench_DebounceTick },
+  { "pwm_period", DioBench_PwmPeriod },
+  { "pattern_buffer", DioBench_PatternBuffer },
+  { "spi_transfer", DioBench_SpiTransfer },
+  { "keypad_scan", DioBench_KeypadScan },
+#endif
+  { "scan_changes", DioBench_ScanChanges },
+#if DIO_SHADOW == STD_ON
+  { "batch_write", DioBench_BatchWrite },
+#endif
+};
+
+/**********************************************************************
+* Function : DioBench_Measure()
+*//**
+* \b Description:
+* Runs a benchmark on a freshly initialized simulation and measures it.
+**********************************************************************/
+static DioBenchResult_t
+DioBench_Measure(const DioBench_t * const Bench, uint32_t Ops)
+{
+  DioBenchResult_t Result = { Bench->Name, Ops, 0.0, 0.0, 0.0, 0.0 };
+  DioSimCounters_t Counters;
+  struct timespec Start;
+  struct timespec End;
+
+  DioSim_Reset();
+  Dio_Init(Dio_ConfigGet());
+  DioSim_CountersReset();
+
+  clock_gettime(CLOCK_MONOTONIC, &Start);
+  Bench->Run(Ops);
+  clock_gettime(CLOCK_MONOTONIC, &End);
+
+  DioSim_CountersGet(&Counters);
+  Result.NsPerOp = ((double)(End.tv_sec - Start.tv_sec) * 1e9
+                    + (double)(End.tv_nsec - Start.tv_nsec)) / Ops;
+  Result.ReadsPerOp = (double)Counters.Reads / Ops;
+  Result.WritesPerOp = (double)Counters.Writes / Ops;
+  Result.MaskedPerOp = (double)Counters.Masked / Ops;
+  return Result;
+}
+
+/**********************************************************************
+* Function : DioBench_Report()
+*//**
+* \b Description:
+* Prints the results as CSV, or as JSON when Json is set.
+**********************************************************************/
+static void
+DioBench_Report(const DioBenchResult_t * const Results, uint32_t Count, int Json)
+{
+  if (Json)
+    {
+      printf("{\n  \"target\": \"%s\",\n  \"results\": [\n", DIO_BENCH_TARGET);
+      for (uint32_t i = 0; i < Count; i++)
+        {
+          printf("    { \"benchmark\": \"%s\", \"ops\": %" PRIu32 ", "
+                 "\"ns_per_op\": %.2f, \"reads_per_op\": %.3f, "
+                 "\"writes_per_op\": %.3f, \"masked_per_op\": %.3f }%s\n",
+                 Results[i].Name, Results[i].Ops, Results[i].NsPerOp,
+                 Results[i].ReadsPerOp, Results[i].WritesPerOp,
+                 Results[i].MaskedPerOp, (i + 1U < Count) ? "," : "");
+        }
+      printf("  ]\n}\n");
+    }
+  else
+    {
+      printf("target,benchmark,ops,ns_per_op,reads_per_op,writes_per_op,masked_per_op\n");
+      for (uint32_t i = 0; i < Count; i++)
+        {
+          printf("%s,%s,%" PRIu32 ",%.2f,%.3f,%.3f,%.3f\n", DIO_BENCH_TARGET,
+                 Results[i].Name, Results[i].Ops, Results[i].NsPerOp,
+                 Results[i].ReadsPerOp, Results[i].WritesPerOp,
+                 Results[i].MaskedPerOp);
+        }
+    }
+}
+
+/**********************************************************************
+* Function : DioBench_Check()
+*//**
+* \b Description:
+* Checks the results against the budget file. Each line of the file is
+* "target,benchmark,reads_per_op,writes_per_op[,masked_per_op]", lines
+* starting with '#' are comments. A row without masked_per_op does not
+* budget the accesses with the interrupts disabled. Returns the number of violations, a benchmark without a
+* budget for this target is a violation so that new paths get one.
+**********************************************************************/
+static uint32_t
+DioBench_Check(const DioBenchResult_t * const Results, uint32_t Count,
+               const char * const Path)
+{
+  FILE * File = fopen(Path, "r");
+  char Line[256];
+  uint32_t Violations = 0;
+  int Budgeted[DIO_BENCH_MAX] = { 0 };
+
+  if (File == NULL)
+    {
+      fprintf(stderr, "dio_bench: cannot open %s\n", Path);
+      return 1;
+    }
+
+  while (fgets(Line, sizeof(Line), File) != NULL)
+    {
+      char Target[64];
+      char Name[64];
+      double Reads;
+      double Writes;
+      double Masked;
+      int Fields = sscanf(Line, "%63[^,],%63[^,],%lf,%lf,%lf",
+                          Target, Name, &Reads, &Writes, &Masked);
+
+      if (Line[0] == '#' || Fields < 4
+          || strcmp(Target, DIO_BENCH_TARGET) != 0)
+        {
+          continue;
+        }
+
+      for (uint32_t i = 0; i < Count; i++)
+        {
+          if (strcmp(Name, Results[i].Name) != 0)
+            {
+              continue;
+            }
+          Budgeted[i] = 1;
+          if (Results[i].ReadsPerOp > Reads + 1e-9
+              || Results[i].WritesPerOp > Writes + 1e-9)
+            {
+              fprintf(stderr, "dio_bench: %s over budget, %.3f reads and "
+                      "%.3f writes per op for a budget of %.3f and %.3f\n",
+                      Name, Results[i].ReadsPerOp, Results[i].WritesPerOp,
+                      Reads, Writes);
+              Violations++;
+            }
+          if (Fields == 5 && Results[i].MaskedPerOp > Masked + 1e-9)
+            {
+              fprintf(stderr, "dio_bench: %s over budget, %.3f accesses per "
+                      "op with the interrupts disabled for a budget of %.3f\n",
+                      Name, Results[i].MaskedPerOp, Masked);
+              Violations++;
+            }
+        }
+    }
+  fclose(File);
+
+  for (uint32_t i = 0; i < Count; i++)
+    {
+      if (!Budgeted[i])
+        {
+          fprintf(stderr, "dio_bench: %s has no budget for %s\n",
+                  Results[i].Name, DIO_BENCH_TARGET);
+          Violations++;
+        }
+    }
+  return Violations;
+}
+
+int
+main(int argc, char * argv[])
+{
+  const uint32_t Count = sizeof(DioBench_Table) / sizeof(DioBench_Table[0]);
+  DioBenchResult_t Results[DIO_BENCH_MAX];
+  const char * Budget = NULL;
+  uint32_t Ops = DIO_BENCH_OPS;
+  int Json = 0;
+
+  for (int i = 1; i < argc; i++)
+    {
+      if (strcmp(argv[i], "--json") == 0)
+        {
+          Json = 1;
+        }
+      else if (strcmp(argv[i], "--budget") == 0 && i + 1 < argc)
+        {
+          Budget = argv[++i];
+        }
+      else if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc)
+        {
+          Ops = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+      else
+        {
+          fprintf(stderr, "usage: %s [--json] [--ops N] [--budget FILE]\n", argv[0]);
+          return 2;
+        }
+    }
+
+  if (Ops == 0)
+    {
+      Ops = 1;
+    }
+
+  for (uint32_t i = 0; i < Count; i++)
+    {
+      Results[i] = DioBench_Measure(&DioBench_Table[i], Ops);
+    }
+
+  DioBench_Report(Results, Count, Json);
+
+  if (Budget != NULL && DioBench_Check(Results, Count, Budget) != 0)
+    {
+      return 1;
+    }
+  return 0;
+}
+/*************** END OF FILE ********************************/
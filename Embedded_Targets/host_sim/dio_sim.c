@@ -0,0 +1,600 @@
+/** 
+ * @file dio_sim.c
+ * @author Mohamed Hassanin
+ * @brief The implementation for the host simulation of the dio registers.
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include <string.h>
+#include "dio_sim.h" /* For this modules definitions */
+#include "dio_memmap.h" /* For the target hardware definitions */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the status register address and its global interrupt enable bit.
+*/
+#define DIO_SIM_SREG 0x5FU
+#define DIO_SIM_SREG_I 0x80U
+/**
+* Defines the CPU cycles of a register access.
+*/
+#define DIO_SIM_ACCESS_CYCLES 1U
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+* Defines the kinds of the port registers.
+*/
+typedef enum
+{
+	DIO_SIM_REG_PIN,
+	DIO_SIM_REG_DDR,
+	DIO_SIM_REG_PORT,
+	DIO_SIM_REG_SET,
+	DIO_SIM_REG_CLEAR,
+	DIO_SIM_REG_TOGGLE,
+	DIO_SIM_REG_OTHER
+}DioSimRegister_t;
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The simulated data space, indexed by the target register address.
+*/
+DioPortValue_t DioSim_Memory[DIO_SIM_MEMORY_SIZE];
+/**
+* The level applied externally to each port, valid for the driven channels.
+*/
+static DioPortValue_t DioSim_Level[DIO_NUMBER_OF_PORTS];
+/**
+* The channels of each port that are driven externally.
+*/
+static DioPortValue_t DioSim_Driven[DIO_NUMBER_OF_PORTS];
+/**
+* The register access counters.
+*/
+static DioSimCounters_t DioSim_Counters;
+/**
+* The handlers of the interrupt vectors and the raised vectors that wait
+* for the global interrupt enable flag.
+*/
+static DioSimVector_t DioSim_Vectors[DIO_SIM_VECTORS];
+static uint32_t DioSim_VectorsPending;
+/**
+* The write trace: the record of the register writes, its size and the
+* number of writes recorded.
+*/
+static DioSimWrite_t * DioSim_Trace;
+static uint32_t DioSim_TraceSize;
+static uint32_t DioSim_TraceCount;
+/**
+* The device model called after each register write.
+*/
+static DioSimHook_t DioSim_Hook;
+/**
+* The virtual CPU cycle counter.
+*/
+static uint32_t DioSim_Cycles;
+/**
+* Set from DioSim_InterruptsDisable to the end of the critical section.
+*/
+static uint8_t DioSim_Masking;
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+static uint16_t DioSim_Offset(const volatile DioPortValue_t * const Register);
+static DioSimRegister_t DioSim_Decode(uint16_t Offset, uint8_t * const Port);
+static void DioSim_PinUpdate(uint8_t Port);
+static void DioSim_VectorsService(void);
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : DioSim_Reset()
+*//**
+* \b Description:
+* This function is used to put the simulated registers in their reset <br>
+* state: all registers cleared, no channel driven externally, no vector <br>
+* pending and the access counters cleared. The vector handlers are kept.<br>
+* POST-CONDITION: The simulation is in the reset state.<br>
+* @return void
+*
+* \b Example:
+* @code
+* DioSim_Reset();
+* Dio_Init(Dio_ConfigGet());
+* @endcode
+**********************************************************************/
+void
+DioSim_Reset(void)
+{
+  memset(DioSim_Memory, 0, sizeof(DioSim_Memory));
+  memset(DioSim_Level, 0, sizeof(DioSim_Level));
+  memset(DioSim_Driven, 0, sizeof(DioSim_Driven));
+  memset(&DioSim_Counters, 0, sizeof(DioSim_Counters));
+  DioSim_VectorsPending = 0;
+  DioSim_Cycles = 0;
+  DioSim_Masking = 0;
+}
+
+/**********************************************************************
+* Function : DioSim_RegRead()
+*//**
+* \b Description:
+* This function is used by DIO_REG_READ to read a simulated register. <br>
+* A read in a critical section, SREG aside, is counted as masked.<br>
+* PRE-CONDITION: Register is within DioSim_Memory <br>
+* POST-CONDITION: The read is counted.<br>
+* @param Register is the simulated register to read
+* @return The current value of the register.
+**********************************************************************/
+DioPortValue_t
+DioSim_RegRead(const volatile DioPortValue_t * const Register)
+{
+  DioSim_Counters.Reads++;
+  DioSim_Cycles += DIO_SIM_ACCESS_CYCLES;
+  if (DioSim_Masking && DioSim_Offset(Register) != DIO_SIM_SREG)
+    {
+      DioSim_Counters.Masked++;
+    }
+  return *Register;
+}
+
+/**********************************************************************
+* Function : DioSim_RegWrite()
+*//**
+* \b Description:
+* This function is used by DIO_REG_WRITE to write a simulated register. <br>
+* A write to PINx toggles the PORTx bits on targets with <br>
+* DIO_PIN_WRITE_TOGGLE and is ignored on the others. A write to a set,<br>
+* clear or toggle register sets, clears or toggles the PORTx bits. The PINx register is<br>
+* updated after every write to PORTx or DDRx. The write is recorded in<br>
+* the write trace while it is started and passed to the hook. A write to<br>
+* SREG ends the critical section, and when it sets the global interrupt<br>
+* enable flag it runs the pending vectors.<br>
+* PRE-CONDITION: Register is within DioSim_Memory <br>
+* POST-CONDITION: The write is counted and applied.<br>
+* @param Register is the simulated register to write
+* @param Value is the value to write
+* @return void
+**********************************************************************/
+void
+DioSim_RegWrite(volatile DioPortValue_t * const Register, DioPortValue_t Value)
+{
+  uint16_t Offset = DioSim_Offset(Register);
+  uint8_t Port = 0;
+
+  DioSim_Counters.Writes++;
+  DioSim_Cycles += DIO_SIM_ACCESS_CYCLES;
+  if (DioSim_Masking && Offset != DIO_SIM_SREG)
+    {
+      DioSim_Counters.Masked++;
+    }
+
+  if (DioSim_TraceCount < DioSim_TraceSize)
+    {
+      DioSim_Trace[DioSim_TraceCount].Address = Offset;
+      DioSim_Trace[DioSim_TraceCount].Value = Value;
+      DioSim_Trace[DioSim_TraceCount].Cycle = DioSim_Cycles;
+      DioSim_TraceCount++;
+    }
+
+  switch (DioSim_Decode(Offset, &Port))
+    {
+    case DIO_SIM_REG_PIN:
+#if DIO_PIN_WRITE_TOGGLE
+      DioSim_Memory[DioSim_Offset(DIO_PORT_ADDRESS(Port))] ^= Value;
+#endif
+      DioSim_PinUpdate(Port);
+      break;
+#ifdef DIO_SET_ADDRESS
+    case DIO_SIM_REG_SET:
+      DioSim_Memory[DioSim_Offset(DIO_PORT_ADDRESS(Port))] |= Value;
+      DioSim_PinUpdate(Port);
+      break;
+    case DIO_SIM_REG_CLEAR:
+      DioSim_Memory[DioSim_Offset(DIO_PORT_ADDRESS(Port))] &= (DioPortValue_t)~Value;
+      DioSim_PinUpdate(Port);
+      break;
+#endif
+#ifdef DIO_TOGGLE_ADDRESS
+    case DIO_SIM_REG_TOGGLE:
+      DioSim_Memory[DioSim_Offset(DIO_PORT_ADDRESS(Port))] ^= Value;
+      DioSim_PinUpdate(Port);
+      break;
+#endif
+    case DIO_SIM_REG_DDR:
+    case DIO_SIM_REG_PORT:
+      DioSim_Memory[Offset] = Value;
+      DioSim_PinUpdate(Port);
+      break;
+    default:
+      DioSim_Memory[Offset] = Value;
+      if (Offset == DIO_SIM_SREG)
+        {
+          DioSim_Masking = 0;
+          DioSim_VectorsService();
+        }
+      break;
+    }
+
+  if (DioSim_Hook != NULL)
+    {
+      DioSim_Hook(Offset, Value);
+    }
+}
+
+/**********************************************************************
+* Function : DioSim_InterruptsDisable()
+*//**
+* \b Description:
+* This function is used to clear the global interrupt enable flag of the<br>
+* simulated status register, as the cli instruction does, and to start<br>
+* counting the masked accesses.<br>
+* @return void
+**********************************************************************/
+void
+DioSim_InterruptsDisable(void)
+{
+  DioSim_Memory[DIO_SIM_SREG] &= (DioPortValue_t)~DIO_SIM_SREG_I;
+  DioSim_Masking = 1;
+}
+
+/**********************************************************************
+* Function : DioSim_InterruptsEnable()
+*//**
+* \b Description:
+* This function is used to set the global interrupt enable flag of the<br>
+* simulated status register, as the sei instruction does.<br>
+* @return void
+**********************************************************************/
+void
+DioSim_InterruptsEnable(void)
+{
+  DioSim_Memory[DIO_SIM_SREG] |= DIO_SIM_SREG_I;
+  DioSim_Masking = 0;
+  DioSim_VectorsService();
+}
+
+/**********************************************************************
+* Function : DioSim_VectorSet()
+*//**
+* \b Description:
+* This function is used to connect the handler of an interrupt vector,<br>
+* it is called by DIO_ISR_CONNECT on the host.<br>
+* PRE-CONDITION: Vector < DIO_SIM_VECTORS <br>
+* @param Vector is the vector number of the target
+* @param Handler is the interrupt service routine of the vector
+* @return void
+* @see DioSim_VectorRaise
+**********************************************************************/
+void
+DioSim_VectorSet(uint8_t Vector, DioSimVector_t Handler)
+{
+  DioSim_Vectors[Vector] = Handler;
+}
+
+/**********************************************************************
+* Function : DioSim_VectorRaise()
+*//**
+* \b Description:
+* This function is used to raise an interrupt vector, as the hardware <br>
+* does when the interrupt condition occurs and the interrupt is enabled.<br>
+* The handler runs before the function returns when the global interrupt<br>
+* enable flag is set, else it runs when the flag is set again.<br>
+* PRE-CONDITION: Vector < DIO_SIM_VECTORS <br>
+* @param Vector is the vector number of the target
+* @return void
+*
+* \b Example:
+* @code
+* DioSim_InputDrive(DIO_PORTD, 0x04, 0x00);
+* DioSim_VectorRaise(DIO_PCINT2_VECTOR);
+* @endcode
+* @see DioSim_VectorSet
+**********************************************************************/
+void
+DioSim_VectorRaise(uint8_t Vector)
+{
+  DioSim_VectorsPending |= 1UL << Vector;
+  DioSim_VectorsService();
+}
+
+/**********************************************************************
+* Function : DioSim_InputDrive()
+*//**
+* \b Description:
+* This function is used to drive the channels of a port externally. The<br>
+* level is seen in PINx for the channels configured as INPUT.<br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition <br>
+* POST-CONDITION: The masked channels are driven to Level.<br>
+* @param Port is the port to drive
+* @param Mask selects the channels to drive, bit n for channel n
+* @param Level is the level of the selected channels
+* @return void
+*
+* \b Example:
+* @code
+* DioSim_InputDrive(DIO_PORTD, 0x04, 0x00); // Pull PORTD_2 low
+* @endcode
+* @see DioSim_InputRelease
+**********************************************************************/
+void
+DioSim_InputDrive(DioPort_t Port, DioPortValue_t Mask, DioPortValue_t Level)
+{
+  DioSim_Level[Port] = (DioPortValue_t)((DioSim_Level[Port] & ~Mask) | (Level & Mask));
+  DioSim_Driven[Port] |= Mask;
+  DioSim_PinUpdate(Port);
+}
+
+/**********************************************************************
+* Function : DioSim_InputRelease()
+*//**
+* \b Description:
+* This function is used to stop driving the channels of a port, they <br>
+* read the pull-up level (the PORTx bit) again.<br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition <br>
+* @param Port is the port to release
+* @param Mask selects the channels to release, bit n for channel n
+* @return void
+* @see DioSim_InputDrive
+**********************************************************************/
+void
+DioSim_InputRelease(DioPort_t Port, DioPortValue_t Mask)
+{
+  DioSim_Driven[Port] &= (DioPortValue_t)~Mask;
+  DioSim_PinUpdate(Port);
+}
+
+/**********************************************************************
+* Function : DioSim_PortLevel()
+*//**
+* \b Description:
+* This function is used to get the level seen on the pins of a port, <br>
+* without counting a register access.<br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition <br>
+* @param Port is the port to inspect
+* @return The level of the pins, bit n for channel n.
+**********************************************************************/
+DioPortValue_t
+DioSim_PortLevel(DioPort_t Port)
+{
+  return DioSim_Memory[DioSim_Offset(DIO_PIN_ADDRESS(Port))];
+}
+
+/**********************************************************************
+* Function : DioSim_CountersGet()
+*//**
+* \b Description:
+* This function is used to get the register access counters.<br>
+* @param Counters receives a snapshot of the counters
+* @return void
+**********************************************************************/
+void
+DioSim_CountersGet(DioSimCounters_t * const Counters)
+{
+  *Counters = DioSim_Counters;
+}
+
+/**********************************************************************
+* Function : DioSim_CountersReset()
+*//**
+* \b Description:
+* This function is used to clear the register access counters.<br>
+* @return void
+**********************************************************************/
+void
+DioSim_CountersReset(void)
+{
+  memset(&DioSim_Counters, 0, sizeof(DioSim_Counters));
+}
+
+/**********************************************************************
+* Function : DioSim_TraceStart()
+*//**
+* \b Description:
+* This function is used to start recording the register writes, in <br>
+* order, to verify the exact output sequence of the driver. The writes <br>
+* beyond Size are not recorded.<br>
+* @param Trace receives the writes
+* @param Size is the number of entries of Trace
+* @return void
+*
+* \b Example:
+* @code
+* DioSimWrite_t Trace[16];
+* DioSim_TraceStart(Trace, 16);
+* Dio_PortWrite(DIO_PORTB, 0x5A);
+* uint32_t Count = DioSim_TraceStop(); // Trace[0] = { PORTB, 0x5A }
+* @endcode
+* @see DioSim_TraceStop
+**********************************************************************/
+void
+DioSim_TraceStart(DioSimWrite_t * const Trace, uint32_t Size)
+{
+  DioSim_Trace = Trace;
+  DioSim_TraceSize = Size;
+  DioSim_TraceCount = 0;
+}
+
+/**********************************************************************
+* Function : DioSim_TraceStop()
+*//**
+* \b Description:
+* This function is used to stop recording the register writes.<br>
+* @return The number of writes recorded since DioSim_TraceStart.
+* @see DioSim_TraceStart
+**********************************************************************/
+uint32_t
+DioSim_TraceStop(void)
+{
+  DioSim_TraceSize = 0;
+  return DioSim_TraceCount;
+}
+
+/**********************************************************************
+* Function : DioSim_HookSet()
+*//**
+* \b Description:
+* This function is used to connect a device model, called after each <br>
+* register write with the address and the value written. NULL removes it.<br>
+* @param Hook is the device model
+* @return void
+*
+* \b Example:
+* @code
+* static void Loopback(uint16_t Address, DioPortValue_t Value) // PB3 to PB4
+* {
+*   if (Address == 0x25) // PORTB of the ATmega328P
+*     {
+*       DioSim_InputDrive(DIO_PORTB, 0x10, (DioPortValue_t)(Value << 1));
+*     }
+* }
+* DioSim_HookSet(Loopback);
+* @endcode
+**********************************************************************/
+void
+DioSim_HookSet(DioSimHook_t Hook)
+{
+  DioSim_Hook = Hook;
+}
+
+/**********************************************************************
+* Function : DioSim_Delay()
+*//**
+* \b Description:
+* This function is used by DIO_DELAY_CYCLES to advance the virtual cycle<br>
+* counter by a busy wait.<br>
+* @param Cycles is the number of CPU cycles of the wait
+* @return void
+**********************************************************************/
+void
+DioSim_Delay(uint32_t Cycles)
+{
+  DioSim_Cycles += Cycles;
+}
+
+/**********************************************************************
+* Function : DioSim_CyclesGet()
+*//**
+* \b Description:
+* This function is used to get the virtual cycle counter.<br>
+* @return The CPU cycles elapsed since DioSim_Reset.
+**********************************************************************/
+uint32_t
+DioSim_CyclesGet(void)
+{
+  return DioSim_Cycles;
+}
+
+/**********************************************************************
+* Function : DioSim_Offset()
+*//**
+* \b Description:
+* Converts a simulated register to its target address.
+**********************************************************************/
+static uint16_t
+DioSim_Offset(const volatile DioPortValue_t * const Register)
+{
+  return (uint16_t)(Register - (const volatile DioPortValue_t *)DioSim_Memory);
+}
+
+/**********************************************************************
+* Function : DioSim_Decode()
+*//**
+* \b Description:
+* Finds the port register at Offset, Port receives the port index.
+**********************************************************************/
+static DioSimRegister_t
+DioSim_Decode(uint16_t Offset, uint8_t * const Port)
+{
+  for (uint8_t i = 0; i < DIO_NUMBER_OF_PORTS; i++)
+    {
+      *Port = i;
+      if (Offset == DioSim_Offset(DIO_PIN_ADDRESS(i)))
+        {
+          return DIO_SIM_REG_PIN;
+        }
+      if (Offset == DioSim_Offset(DIO_DDR_ADDRESS(i)))
+        {
+          return DIO_SIM_REG_DDR;
+        }
+      if (Offset == DioSim_Offset(DIO_PORT_ADDRESS(i)))
+        {
+          return DIO_SIM_REG_PORT;
+        }
+#ifdef DIO_SET_ADDRESS
+      if (Offset == DioSim_Offset(DIO_SET_ADDRESS(i)))
+        {
+          return DIO_SIM_REG_SET;
+        }
+      if (Offset == DioSim_Offset(DIO_CLEAR_ADDRESS(i)))
+        {
+          return DIO_SIM_REG_CLEAR;
+        }
+#endif
+#ifdef DIO_TOGGLE_ADDRESS
+      if (Offset == DioSim_Offset(DIO_TOGGLE_ADDRESS(i)))
+        {
+          return DIO_SIM_REG_TOGGLE;
+        }
+#endif
+    }
+  return DIO_SIM_REG_OTHER;
+}
+
+/**********************************************************************
+* Function : DioSim_PinUpdate()
+*//**
+* \b Description:
+* Recomputes PINx: OUTPUT channels read PORTx, driven INPUT channels read
+* the external level and the others read their pull-up (the PORTx bit).
+**********************************************************************/
+static void
+DioSim_PinUpdate(uint8_t Port)
+{
+  DioPortValue_t Ddr = DioSim_Memory[DioSim_Offset(DIO_DDR_ADDRESS(Port))];
+  DioPortValue_t Out = DioSim_Memory[DioSim_Offset(DIO_PORT_ADDRESS(Port))];
+  DioPortValue_t Driven = (DioPortValue_t)(DioSim_Driven[Port] & ~Ddr);
+
+  DioSim_Memory[DioSim_Offset(DIO_PIN_ADDRESS(Port))] =
+    (DioPortValue_t)((Out & ~Driven) | (DioSim_Level[Port] & Driven));
+}
+/**********************************************************************
+* Function : DioSim_VectorsService()
+*//**
+* \b Description:
+* Runs the pending vectors in vector number order (their priority) while
+* the global interrupt enable flag is set. The flag is cleared while a
+* handler runs and set again after it, as the interrupt entry and reti do.
+**********************************************************************/
+static void
+DioSim_VectorsService(void)
+{
+  for (uint8_t Vector = 0; Vector < DIO_SIM_VECTORS; Vector++)
+    {
+      if ((DioSim_Memory[DIO_SIM_SREG] & DIO_SIM_SREG_I) == 0)
+        {
+          return;
+        }
+      if ((DioSim_VectorsPending & (1UL << Vector)) == 0)
+        {
+          continue;
+        }
+
+      DioSim_VectorsPending &= ~(1UL << Vector);
+      if (DioSim_Vectors[Vector] != NULL)
+        {
+          DioSim_Memory[DIO_SIM_SREG] &= (DioPortValue_t)~DIO_SIM_SREG_I;
+          DioSim_Vectors[Vector]();
+          DioSim_Memory[DIO_SIM_SREG] |= DIO_SIM_SREG_I;
+          Vector = 0xFF; // A handler may raise a vector, restart the scan
+        }
+    }
+}
+/*************** END OF FUNCTIONS ********************************/
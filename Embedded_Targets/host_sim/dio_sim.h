@@ -0,0 +1,137 @@
+/** 
+ * @file dio_sim.h
+ * @author Mohamed Hassanin
+ * @brief The interface definition for the host simulation of the dio
+ * registers. The simulation lets the driver of a target run on the
+ * build host: when a target is compiled with DIO_SIM defined, its
+ * dio_memmap.h maps PORTx/DDRx/PINx into DioSim_Memory and routes every
+ * register access through DioSim_RegRead/DioSim_RegWrite, which model the
+ * AVR port semantics. A register is a port word (DioPortValue_t) of the
+ * target, and the register addresses are counted in port words:
+ * - PINx reads the output level of OUTPUT channels and the external level
+ *   of INPUT channels (the pull-up level when not driven externally).
+ * - Writing a logic one to a PINx bit toggles the PORTx bit on targets
+ *   with DIO_PIN_WRITE_TOGGLE, it is ignored on the others.
+ * - Writing a logic one to a bit of the set (clear) register of a target
+ *   with DIO_SET_ADDRESS sets (clears) the PORTx bit, and to a bit of the
+ *   toggle register of a target with DIO_TOGGLE_ADDRESS toggles it. These
+ *   registers are write-only and read as zero.
+ * - Each register access takes one CPU cycle of a virtual cycle counter,
+ *   DIO_DELAY_CYCLES advances it by the cycles of the delay. The write
+ *   trace is timestamped with it to verify the timing of the driver.
+ * - The accesses made between DioSim_InterruptsDisable and the write
+ *   of SREG or the DioSim_InterruptsEnable that ends the critical
+ *   section are counted apart, the window with the interrupts disabled.
+ * - A raised interrupt vector runs its handler with the global interrupt
+ *   enable flag of SREG cleared, at once when the flag is set and else
+ *   as soon as it is set again.
+ *
+ * \b Example (from Embedded_Targets):
+ * @code
+ * gcc -DDIO_SIM -Iatmega328p -Ihost_sim atmega328p/dio.c \
+ *     atmega328p/dio_cfg.c host_sim/dio_sim.c app.c
+ * @endcode
+ * @version 0.1
+ * @date 2021-01-12
+*/
+#ifndef DIO_SIM_H_
+#define DIO_SIM_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_cfg.h" /**< For dio configuration */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the size of the simulated data space, it covers the register
+* file and the I/O space of the supported targets, in registers.
+*/
+#define DIO_SIM_MEMORY_SIZE 0x200U
+/**
+* Defines the number of interrupt vectors of the simulation.
+*/
+#define DIO_SIM_VECTORS 32U
+/**********************************************************************
+* Preprocessor Macros
+**********************************************************************/
+/**
+* Converts a register address of the target to the simulated register.
+*/
+#define DIO_SIM_REGISTER(Address) \
+  ((volatile DioPortValue_t *)&DioSim_Memory[(Address)])
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+* Defines the register access counters of the simulation.
+*/
+typedef struct
+{
+	uint32_t Reads; /**< Number of register reads */
+	uint32_t Writes; /**< Number of register writes */
+	uint32_t Masked; /**< Accesses of a critical section, SREG aside */
+}DioSimCounters_t;
+
+/**
+* Defines a register write recorded by the write trace.
+*/
+typedef struct
+{
+	uint16_t Address; /**< The target address of the register */
+	DioPortValue_t Value; /**< The value written */
+	uint32_t Cycle; /**< The virtual cycle of the write */
+}DioSimWrite_t;
+
+/**
+* Defines a hook called after each register write, it models the devices
+* connected to the pins by driving the inputs.
+*/
+typedef void (*DioSimHook_t)(uint16_t Address, DioPortValue_t Value);
+
+/**
+* Defines the handler of an interrupt vector, connected by DIO_ISR_CONNECT.
+*/
+typedef void (*DioSimVector_t)(void);
+/**********************************************************************
+* Variables
+**********************************************************************/
+extern DioPortValue_t DioSim_Memory[DIO_SIM_MEMORY_SIZE];
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void DioSim_Reset(void);
+
+DioPortValue_t DioSim_RegRead(const volatile DioPortValue_t * const Register);
+void DioSim_RegWrite(volatile DioPortValue_t * const Register, DioPortValue_t Value);
+
+void DioSim_InterruptsDisable(void);
+void DioSim_InterruptsEnable(void);
+void DioSim_VectorSet(uint8_t Vector, DioSimVector_t Handler);
+void DioSim_VectorRaise(uint8_t Vector);
+
+void DioSim_InputDrive(DioPort_t Port, DioPortValue_t Mask, DioPortValue_t Level);
+void DioSim_InputRelease(DioPort_t Port, DioPortValue_t Mask);
+DioPortValue_t DioSim_PortLevel(DioPort_t Port);
+
+void DioSim_CountersGet(DioSimCounters_t * const Counters);
+void DioSim_CountersReset(void);
+
+void DioSim_TraceStart(DioSimWrite_t * const Trace, uint32_t Size);
+uint32_t DioSim_TraceStop(void);
+void DioSim_HookSet(DioSimHook_t Hook);
+
+void DioSim_Delay(uint32_t Cycles);
+uint32_t DioSim_CyclesGet(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* DIO_SIM_H_*/
+/*************** END OF FILE ********************************/
@@ -0,0 +1,58 @@
+/**
+ * @file dio_test.h
+ * @author Mohamed Hassanin
+ * @brief The checks of the host tests of the dio. A test program is one
+ * translation unit built like dio_bench.c: it includes this file, runs
+ * its checks against the host simulation and returns DIO_TEST_RESULT()
+ * from main, so that a failed check fails the program.
+ * @version 0.1
+ * @date 2021-01-12
+*/
+#ifndef DIO_TEST_H_
+#define DIO_TEST_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "dio_sim.h" /**< For the simulated registers */
+/**********************************************************************
+* Preprocessor Macros
+**********************************************************************/
+/**
+* Checks Condition, a check that does not hold is reported with its
+* location and counted, and the test goes on.
+*/
+#define DIO_TEST_CHECK(Condition) \
+  do { \
+    DioTest_Checks++; \
+    if (!(Condition)) \
+      { \
+        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #Condition); \
+        DioTest_Failures++; \
+      } \
+  } while (0)
+/**
+* Reports the checks of the program and gives its exit status.
+*/
+#define DIO_TEST_RESULT() \
+  (printf("%" PRIu32 " checks, %" PRIu32 " failed\n", DioTest_Checks, \
+          DioTest_Failures), \
+   (DioTest_Failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE)
+/**
+* The address of a simulated register as recorded by the write trace.
+*/
+#define DIO_TEST_ADDRESS(Register) \
+  ((uint16_t)((Register) - DIO_SIM_REGISTER(0)))
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The checks run and the checks that failed.
+*/
+static uint32_t DioTest_Checks;
+static uint32_t DioTest_Failures;
+
+#endif /* DIO_TEST_H_*/
+/*************** END OF FILE ********************************/
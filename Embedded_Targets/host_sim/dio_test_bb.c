@@ -0,0 +1,271 @@
+/**
+ * @file dio_test_bb.c
+ * @author Mohamed Hassanin
+ * @brief The host test of the dio bit-banged protocols: the pin writes of
+ * each protocol are recorded by the write trace and timed with the cycle
+ * counter of the simulation: the bit time of the UART frame, exact to the
+ * cycle, the clock phases of the I2C bus and the slots of the 1-Wire bus,
+ * and the data of each protocol is checked against a bus model: a
+ * loopback for the SPI, pull-ups or a device pulling low for the I2C and
+ * the 1-Wire.
+ *
+ * \b Example (from Embedded_Targets):
+ * @code
+ * gcc -O2 -DDIO_SIM -Iatmega328p -Ihost_sim atmega328p/dio*.c \
+ *     host_sim/dio_sim.c host_sim/dio_test_bb.c -o dio_test_bb
+ * ./dio_test_bb
+ * @endcode
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio.h" /* For the channel macros */
+#include "dio_bb.h" /* For the interface under test */
+#include "dio_pin.h" /* For the pin registers */
+#include "dio_test.h" /* For the checks */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the writes the trace can hold, for the longest sequence: an
+* I2C byte.
+*/
+#define DIO_TEST_TRACE 512U
+/**
+* Defines the bit time of the UART, in cycles.
+*/
+#define DIO_TEST_UART_BIT ((uint32_t)(DIO_BB_F_CPU / DIO_BB_UART_BAUD))
+/**********************************************************************
+* Preprocessor Macros
+**********************************************************************/
+/**
+* The trace address of a pin register of a channel.
+*/
+#define DIO_TEST_PIN_ADDRESS(Register, Channel) \
+  DIO_TEST_ADDRESS((volatile DioPortValue_t *)Register(Channel))
+/**
+* Drives an input channel to the level of Condition.
+*/
+#define DIO_TEST_DRIVE(Channel, Condition) \
+  DioSim_InputDrive(DIO_CHANNEL_PORT(Channel), DIO_CHANNEL_MASK(Channel), \
+                    (Condition) ? DIO_CHANNEL_MASK(Channel) : 0)
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The write trace of the test in progress.
+*/
+static DioSimWrite_t DioTest_Trace[DIO_TEST_TRACE];
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : DioTest_TraceFilter()
+*//**
+* \b Description:
+* Keeps the Writes first writes of the trace that are made to Address,
+* in order, and returns their number.
+**********************************************************************/
+static uint32_t
+DioTest_TraceFilter(uint32_t Writes, uint16_t Address)
+{
+  uint32_t Kept = 0;
+
+  for (uint32_t i = 0; i < Writes; i++)
+    {
+      if(DioTest_Trace[i].Address == Address)
+        {
+          DioTest_Trace[Kept++] = DioTest_Trace[i];
+        }
+    }
+  return Kept;
+}
+
+/**********************************************************************
+* Function : DioTest_SpiLoopback()
+*//**
+* \b Description:
+* The write hook of the SPI test: MISO follows MOSI, like a wire between
+* the two pins.
+**********************************************************************/
+static void
+DioTest_SpiLoopback(uint16_t Address, DioPortValue_t Value)
+{
+  (void)Address;
+  (void)Value;
+  DIO_TEST_DRIVE(DIO_BB_SPI_MISO, DioSim_PortLevel(DIO_CHANNEL_PORT(DIO_BB_SPI_MOSI))
+                 & DIO_CHANNEL_MASK(DIO_BB_SPI_MOSI));
+}
+
+static void
+DioTest_BbSpi(void)
+{
+  uint8_t Out[3] = { 0x01, 0x7E, 0x80 };
+  uint8_t In[3] = { 0 };
+
+  DioSim_Reset();
+  Dio_BbSpiInit();
+  DioSim_HookSet(DioTest_SpiLoopback);
+  DIO_TEST_CHECK(Dio_BbSpiTransfer(0xA5) == 0xA5);
+  DIO_TEST_CHECK(Dio_BbSpiTransfer(0x3C) == 0x3C);
+  Dio_BbSpiTransferBuffer(Out, In, 3);
+  DioSim_HookSet(NULL);
+  for (uint8_t i = 0; i < 3; i++)
+    {
+      DIO_TEST_CHECK(In[i] == Out[i]);
+    }
+
+  // Mode 0: the clock idles low between the bytes
+  DIO_TEST_CHECK(DIO_PIN_READ(DIO_BB_SPI_SCK) == DIO_STATE_LOW);
+}
+
+static void
+DioTest_BbUartFrame(uint8_t Byte)
+{
+  const uint16_t Address = DIO_TEST_PIN_ADDRESS(DIO_PORT_REG, DIO_BB_UART_TX);
+  uint32_t Writes;
+  uint32_t End;
+
+  DioSim_Reset();
+  Dio_BbUartInit();
+  DioSim_TraceStart(DioTest_Trace, DIO_TEST_TRACE);
+  Dio_BbUartWrite(Byte);
+  End = DioSim_CyclesGet();
+  Writes = DioTest_TraceFilter(DioSim_TraceStop(), Address);
+
+  // One write per bit: the start bit, the data bits LSB first, the stop bit
+  DIO_TEST_CHECK(Writes == 10U);
+  if(Writes != 10U)
+    {
+      return;
+    }
+  for (uint8_t Bit = 0; Bit < 10U; Bit++)
+    {
+      const uint8_t High = (Bit == 9U) || (Bit > 0U && (Byte & (1U << (Bit - 1U))));
+
+      DIO_TEST_CHECK(((DioTest_Trace[Bit].Value & DIO_CHANNEL_MASK(DIO_BB_UART_TX)) != 0) == High);
+      // Every bit lasts the same time, whatever its level
+      if(Bit > 0U)
+        {
+          DIO_TEST_CHECK(DioTest_Trace[Bit].Cycle - DioTest_Trace[Bit - 1U].Cycle
+                         == DIO_TEST_UART_BIT);
+        }
+    }
+  DIO_TEST_CHECK(End - DioTest_Trace[9].Cycle >= DIO_TEST_UART_BIT - DIO_BB_UART_BIT_OVERHEAD);
+}
+
+static void
+DioTest_BbUart(void)
+{
+  uint8_t Byte;
+
+  // Alternating bits, runs of ones and zeros, a single level
+  DioTest_BbUartFrame(0x55);
+  DioTest_BbUartFrame(0x0F);
+  DioTest_BbUartFrame(0xF0);
+  DioTest_BbUartFrame(0x00);
+  DioTest_BbUartFrame(0xFF);
+
+  // RX idles high: no start bit, no frame
+  DIO_TEST_DRIVE(DIO_BB_UART_RX, 1);
+  DIO_TEST_CHECK(Dio_BbUartRead(&Byte, 10) == 0);
+}
+
+static void
+DioTest_BbI2c(void)
+{
+  const uint16_t Address = DIO_TEST_PIN_ADDRESS(DIO_DDR_REG, DIO_BB_I2C_SCL);
+  const DioPortValue_t Scl = DIO_CHANNEL_MASK(DIO_BB_I2C_SCL);
+  uint32_t Writes;
+  uint32_t Edge = 0;
+  uint32_t Pulses = 0;
+
+  // The pull-ups hold both lines high while they are released
+  DioSim_Reset();
+  DIO_TEST_DRIVE(DIO_BB_I2C_SCL, 1);
+  DIO_TEST_DRIVE(DIO_BB_I2C_SDA, 1);
+  Dio_BbI2cInit();
+  DIO_TEST_CHECK(DIO_PIN_READ(DIO_BB_I2C_SCL) == DIO_STATE_HIGH);
+  Dio_BbI2cStart();
+  DIO_TEST_CHECK(DIO_PIN_READ(DIO_BB_I2C_SCL) == DIO_STATE_LOW);
+  DIO_TEST_CHECK(DIO_PIN_READ(DIO_BB_I2C_SDA) == DIO_STATE_LOW);
+
+  // No device: NACK and all ones; a device holding SDA: ACK and zeros
+  DioSim_TraceStart(DioTest_Trace, DIO_TEST_TRACE);
+  DIO_TEST_CHECK(Dio_BbI2cWrite(0xA0) == 0);
+  Writes = DioTest_TraceFilter(DioSim_TraceStop(), Address);
+  DIO_TEST_CHECK(Dio_BbI2cRead(0) == 0xFF);
+  DIO_TEST_DRIVE(DIO_BB_I2C_SDA, 0);
+  DIO_TEST_CHECK(Dio_BbI2cWrite(0xA0) == 1);
+  DIO_TEST_CHECK(Dio_BbI2cRead(1) == 0x00);
+  DIO_TEST_DRIVE(DIO_BB_I2C_SDA, 1);
+  Dio_BbI2cStop();
+  DIO_TEST_CHECK(DIO_PIN_READ(DIO_BB_I2C_SCL) == DIO_STATE_HIGH);
+  DIO_TEST_CHECK(DIO_PIN_READ(DIO_BB_I2C_SDA) == DIO_STATE_HIGH);
+  DIO_TEST_CHECK((DIO_REG_READ(DIO_PORT_REG(DIO_BB_I2C_SDA)) & DIO_CHANNEL_MASK(DIO_BB_I2C_SDA)) == 0);
+
+  // Each phase of the clock of the byte lasts at least half a period.
+  // SCL is driven low by its DDR bit, a clear bit releases it high.
+  for (uint32_t i = 1; i < Writes; i++)
+    {
+      if(((DioTest_Trace[i].Value ^ DioTest_Trace[Edge].Value) & Scl) != 0)
+        {
+          DIO_TEST_CHECK(DioTest_Trace[i].Cycle - DioTest_Trace[Edge].Cycle
+                         >= DIO_BB_I2C_HALF_CYCLES);
+          if((DioTest_Trace[i].Value & Scl) == 0)
+            {
+              Pulses++;
+            }
+          Edge = i;
+        }
+    }
+  DIO_TEST_CHECK(Pulses == 9U);
+}
+
+static void
+DioTest_BbOneWire(void)
+{
+  const uint16_t Address = DIO_TEST_PIN_ADDRESS(DIO_DDR_REG, DIO_BB_ONEWIRE_PIN);
+  uint32_t Writes;
+
+  // The pull-up and no device: no presence pulse and all ones
+  DioSim_Reset();
+  DIO_TEST_DRIVE(DIO_BB_ONEWIRE_PIN, 1);
+  Dio_BbOneWireInit();
+  DIO_TEST_CHECK(Dio_BbOneWireReset() == 0);
+  DIO_TEST_CHECK(Dio_BbOneWireRead() == 0xFF);
+
+  // Each slot pulls the bus low then releases it: 2 writes per bit
+  DioSim_TraceStart(DioTest_Trace, DIO_TEST_TRACE);
+  Dio_BbOneWireWrite(0x01);
+  Writes = DioTest_TraceFilter(DioSim_TraceStop(), Address);
+  DIO_TEST_CHECK(Writes == 16U);
+  if(Writes == 16U)
+    {
+      const uint32_t One = DioTest_Trace[1].Cycle - DioTest_Trace[0].Cycle;
+      const uint32_t Zero = DioTest_Trace[3].Cycle - DioTest_Trace[2].Cycle;
+
+      DIO_TEST_CHECK(One >= DIO_BB_US(6) && One < DIO_BB_US(7));
+      DIO_TEST_CHECK(Zero >= DIO_BB_US(60) && Zero < DIO_BB_US(61));
+      DIO_TEST_CHECK(DioTest_Trace[2].Cycle - DioTest_Trace[0].Cycle >= DIO_BB_US(70));
+    }
+
+  // A device holding the bus: a presence pulse and all zeros
+  DIO_TEST_DRIVE(DIO_BB_ONEWIRE_PIN, 0);
+  DIO_TEST_CHECK(Dio_BbOneWireReset() == 1);
+  DIO_TEST_CHECK(Dio_BbOneWireRead() == 0x00);
+}
+
+int
+main(void)
+{
+  DioTest_BbSpi();
+  DioTest_BbUart();
+  DioTest_BbI2c();
+  DioTest_BbOneWire();
+  return DIO_TEST_RESULT();
+}
+/*************** END OF FILE ********************************/
@@ -0,0 +1,248 @@
+/**
+ * @file dio_test_debounce.c
+ * @author Mohamed Hassanin
+ * @brief The host test of the dio input debouncing: the channels of the
+ * debounce table are driven through the simulation and ticked. A press or
+ * a release is reported by Dio_DebouncePressedGet and
+ * Dio_DebounceReleasedGet only after 2^DIO_DEBOUNCE_COUNTER_BITS stable
+ * samples, a bounce clears the vertical counter of the channel, and the
+ * other channels of the port are not disturbed.
+ *
+ * \b Example (from Embedded_Targets):
+ * @code
+ * gcc -O2 -DDIO_SIM -Iatmega328p -Ihost_sim atmega328p/dio*.c \
+ *     host_sim/dio_sim.c host_sim/dio_test_debounce.c -o dio_test_debounce
+ * ./dio_test_debounce
+ * @endcode
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio.h" /* For the channel macros */
+#include "dio_debounce.h" /* For the interface under test */
+#include "dio_test.h" /* For the checks */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the stable samples a channel takes to change state.
+*/
+#define DIO_TEST_STABLE (1U << DIO_DEBOUNCE_COUNTER_BITS)
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The debounce table of the target.
+*/
+static const DioDebounceConfig_t * DioTest_Debounce;
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : DioTest_DebounceDrive()
+*//**
+* \b Description:
+* Drives the channels of Mask of a row of the debounce table to their
+* active level when Active is set, to their inactive level else.
+**********************************************************************/
+static void
+DioTest_DebounceDrive(const DioDebounceConfig_t * const Row, DioPortValue_t Mask,
+                      uint8_t Active)
+{
+  const DioPortValue_t Inactive = Row->ActiveLow & Mask;
+
+  DioSim_InputDrive(Row->Port, Mask,
+                    (Active != 0) ? (DioPortValue_t)(~Inactive & Mask) : Inactive);
+}
+
+/**********************************************************************
+* Function : DioTest_DebounceTicks()
+*//**
+* \b Description:
+* Runs Ticks ticks and checks that no channel of the port of Row was
+* reported pressed or released.
+**********************************************************************/
+static void
+DioTest_DebounceTicks(const DioDebounceConfig_t * const Row, uint32_t Ticks)
+{
+  for (uint32_t i = 0; i < Ticks; i++)
+    {
+      Dio_DebounceTick();
+    }
+  DIO_TEST_CHECK(Dio_DebouncePressedGet(Row->Port) == 0);
+  DIO_TEST_CHECK(Dio_DebounceReleasedGet(Row->Port) == 0);
+}
+
+/**********************************************************************
+* Function : DioTest_DebounceState()
+*//**
+* \b Description:
+* Checks the debounced state of a channel: active or inactive.
+**********************************************************************/
+static void
+DioTest_DebounceState(const DioDebounceConfig_t * const Row, DioChannel_t Channel,
+                      uint8_t Active)
+{
+  const DioPortValue_t Mask = DIO_CHANNEL_MASK(Channel);
+  const DioState_t Level = (((Row->ActiveLow & Mask) != 0) != (Active != 0))
+                           ? DIO_STATE_HIGH : DIO_STATE_LOW;
+
+  DIO_TEST_CHECK(Dio_DebouncedRead(Channel) == Level);
+  DIO_TEST_CHECK((Dio_DebouncedPortRead(Row->Port) & Mask)
+                 == ((Level == DIO_STATE_HIGH) ? Mask : 0));
+}
+
+static void
+DioTest_DebounceSetup(void)
+{
+  DioSim_Reset();
+  Dio_Init(Dio_ConfigGet());
+  DioTest_Debounce = Dio_DebounceConfigGet();
+  for (uint8_t Row = 0; Row < DIO_DEBOUNCE_PORTS; Row++)
+    {
+      DioTest_DebounceDrive(&DioTest_Debounce[Row], DioTest_Debounce[Row].Mask, 0);
+    }
+  Dio_DebounceInit(DioTest_Debounce);
+}
+
+/**********************************************************************
+* Function : DioTest_DebounceChannel()
+*//**
+* \b Description:
+* Presses and releases a channel of a row of the debounce table, with
+* and without bounces, while the other channels of the row stay
+* inactive.
+**********************************************************************/
+static void
+DioTest_DebounceChannel(const DioDebounceConfig_t * const Row, DioChannel_t Channel)
+{
+  const DioPortValue_t Mask = DIO_CHANNEL_MASK(Channel);
+
+  DioTest_DebounceSetup();
+  DioTest_DebounceTicks(Row, DIO_TEST_STABLE);
+  DioTest_DebounceState(Row, Channel, 0);
+
+  // A press is reported at the last of the stable samples, once
+  DioTest_DebounceDrive(Row, Mask, 1);
+  DioTest_DebounceTicks(Row, DIO_TEST_STABLE - 1U);
+  DioTest_DebounceState(Row, Channel, 0);
+  Dio_DebounceTick();
+  DioTest_DebounceState(Row, Channel, 1);
+  DIO_TEST_CHECK(Dio_DebounceReleasedGet(Row->Port) == 0);
+  DIO_TEST_CHECK(Dio_DebouncePressedGet(Row->Port) == Mask);
+  DioTest_DebounceTicks(Row, 4U * DIO_TEST_STABLE);
+  DioTest_DebounceState(Row, Channel, 1);
+
+  // The same for a release
+  DioTest_DebounceDrive(Row, Mask, 0);
+  DioTest_DebounceTicks(Row, DIO_TEST_STABLE - 1U);
+  DioTest_DebounceState(Row, Channel, 1);
+  Dio_DebounceTick();
+  DioTest_DebounceState(Row, Channel, 0);
+  DIO_TEST_CHECK(Dio_DebouncePressedGet(Row->Port) == 0);
+  DIO_TEST_CHECK(Dio_DebounceReleasedGet(Row->Port) == Mask);
+  DioTest_DebounceTicks(Row, DIO_TEST_STABLE);
+
+  // A bounce one sample short of the count clears the counter: the
+  // press takes the stable samples again from there
+  for (uint32_t Bounce = 0; Bounce < 3U; Bounce++)
+    {
+      DioTest_DebounceDrive(Row, Mask, 1);
+      DioTest_DebounceTicks(Row, DIO_TEST_STABLE - 1U);
+      DioTest_DebounceDrive(Row, Mask, 0);
+      DioTest_DebounceTicks(Row, 1);
+    }
+  DioTest_DebounceState(Row, Channel, 0);
+  DioTest_DebounceDrive(Row, Mask, 1);
+  DioTest_DebounceTicks(Row, DIO_TEST_STABLE - 1U);
+  Dio_DebounceTick();
+  DIO_TEST_CHECK(Dio_DebouncePressedGet(Row->Port) == Mask);
+
+  // Bouncing on the release, then released
+  DioTest_DebounceDrive(Row, Mask, 0);
+  DioTest_DebounceTicks(Row, DIO_TEST_STABLE - 1U);
+  DioTest_DebounceDrive(Row, Mask, 1);
+  DioTest_DebounceTicks(Row, 1);
+  DioTest_DebounceDrive(Row, Mask, 0);
+  DioTest_DebounceTicks(Row, DIO_TEST_STABLE - 1U);
+  DioTest_DebounceState(Row, Channel, 1);
+  Dio_DebounceTick();
+  DIO_TEST_CHECK(Dio_DebounceReleasedGet(Row->Port) == Mask);
+  DioTest_DebounceState(Row, Channel, 0);
+
+  // Latched until read: a press and a release between two reads
+  DioTest_DebounceDrive(Row, Mask, 1);
+  DioTest_DebounceTicks(Row, 0);
+  for (uint32_t i = 0; i < DIO_TEST_STABLE; i++)
+    {
+      Dio_DebounceTick();
+    }
+  DioTest_DebounceDrive(Row, Mask, 0);
+  for (uint32_t i = 0; i < DIO_TEST_STABLE; i++)
+    {
+      Dio_DebounceTick();
+    }
+  DIO_TEST_CHECK(Dio_DebouncePressedGet(Row->Port) == Mask);
+  DIO_TEST_CHECK(Dio_DebounceReleasedGet(Row->Port) == Mask);
+  DioTest_DebounceTicks(Row, 0);
+}
+
+static void
+DioTest_DebounceStart(void)
+{
+  DioSim_Reset();
+  Dio_Init(Dio_ConfigGet());
+  DioTest_Debounce = Dio_DebounceConfigGet();
+
+  // A channel found at its active level at start up is not a press
+  for (uint8_t Row = 0; Row < DIO_DEBOUNCE_PORTS; Row++)
+    {
+      DioTest_DebounceDrive(&DioTest_Debounce[Row], DioTest_Debounce[Row].Mask, 1);
+    }
+  Dio_DebounceInit(DioTest_Debounce);
+  for (uint8_t Row = 0; Row < DIO_DEBOUNCE_PORTS; Row++)
+    {
+      DioTest_DebounceTicks(&DioTest_Debounce[Row], 4U * DIO_TEST_STABLE);
+    }
+}
+
+static void
+DioTest_DebounceTogether(void)
+{
+  // All the channels of a row pressed at once are reported at once
+  DioTest_DebounceSetup();
+  for (uint8_t Row = 0; Row < DIO_DEBOUNCE_PORTS; Row++)
+    {
+      const DioDebounceConfig_t * const Config = &DioTest_Debounce[Row];
+
+      DioTest_DebounceDrive(Config, Config->Mask, 1);
+      DioTest_DebounceTicks(Config, DIO_TEST_STABLE - 1U);
+      Dio_DebounceTick();
+      DIO_TEST_CHECK(Dio_DebouncePressedGet(Config->Port) == Config->Mask);
+    }
+}
+
+int
+main(void)
+{
+  DioTest_DebounceStart();
+  DioTest_DebounceTogether();
+  for (uint8_t Row = 0; Row < DIO_DEBOUNCE_PORTS; Row++)
+    {
+      const DioDebounceConfig_t * const Config = &Dio_DebounceConfigGet()[Row];
+
+      for (uint8_t Bit = 0; Bit < DIO_CHANNELS_PER_PORT; Bit++)
+        {
+          if(Config->Mask & (1U << Bit))
+            {
+              DioTest_DebounceChannel(Config, (DioChannel_t)(Config->Port
+                                              * DIO_CHANNELS_PER_PORT + Bit));
+            }
+        }
+    }
+  return DIO_TEST_RESULT();
+}
+/*************** END OF FILE ********************************/
@@ -0,0 +1,250 @@
+/**
+ * @file dio_test_edge.c
+ * @author Mohamed Hassanin
+ * @brief The host test of the dio edge detection: the inputs are driven
+ * through the simulation and the calls of Dio_ScanChanges to a recording
+ * callback are checked: the channels, the levels and the order of the
+ * calls for rising, falling and both edges, several channels of several
+ * ports changing in one scan, no call when nothing changed or when the
+ * edge is not registered, and the port count it returns. It builds for
+ * every target.
+ *
+ * \b Example (from Embedded_Targets):
+ * @code
+ * gcc -O2 -DDIO_SIM -Isim32 -Ihost_sim sim32/dio*.c host_sim/dio_sim.c \
+ *     host_sim/dio_test_edge.c -o dio_test_edge
+ * ./dio_test_edge
+ * @endcode
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio.h" /* For the port interface */
+#include "dio_edge.h" /* For the interface under test */
+#include "dio_test.h" /* For the checks */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the calls the recording callback can hold.
+*/
+#define DIO_TEST_CALLS 8U
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+* Defines a call of the recording callback.
+*/
+typedef struct
+{
+	DioChannel_t Channel; /**< The channel of the edge */
+	DioState_t State; /**< The level after the edge */
+}DioTestCall_t;
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The ports under test, the first and the last one of the target, and
+* the channels of the last port registered for the rising, the falling
+* and both edges, the channel of the first port registered for both
+* edges, and a channel without a callback.
+*/
+static const DioPort_t DioTest_First = (DioPort_t)0;
+static const DioPort_t DioTest_Last = (DioPort_t)(DIO_PORT_MAX - 1U);
+static const DioChannel_t DioTest_Rising =
+  (DioChannel_t)((DIO_PORT_MAX - 1U) * DIO_CHANNELS_PER_PORT + 0U);
+static const DioChannel_t DioTest_Falling =
+  (DioChannel_t)((DIO_PORT_MAX - 1U) * DIO_CHANNELS_PER_PORT + 1U);
+static const DioChannel_t DioTest_Both =
+  (DioChannel_t)((DIO_PORT_MAX - 1U) * DIO_CHANNELS_PER_PORT + 2U);
+static const DioChannel_t DioTest_Unregistered =
+  (DioChannel_t)((DIO_PORT_MAX - 1U) * DIO_CHANNELS_PER_PORT + 5U);
+static const DioChannel_t DioTest_Other =
+  (DioChannel_t)(DIO_CHANNELS_PER_PORT - 1U);
+/**
+* The calls recorded since the last check, the calls of the other
+* callback.
+*/
+static DioTestCall_t DioTest_Calls[DIO_TEST_CALLS];
+static uint32_t DioTest_CallCount;
+static uint32_t DioTest_OtherCount;
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : DioTest_EdgeRecord()
+*//**
+* \b Description:
+* The recording callback: appends the call to DioTest_Calls.
+**********************************************************************/
+static void
+DioTest_EdgeRecord(DioChannel_t Channel, DioState_t State)
+{
+  if(DioTest_CallCount < DIO_TEST_CALLS)
+    {
+      DioTest_Calls[DioTest_CallCount].Channel = Channel;
+      DioTest_Calls[DioTest_CallCount].State = State;
+    }
+  DioTest_CallCount++;
+}
+
+/**********************************************************************
+* Function : DioTest_EdgeOther()
+*//**
+* \b Description:
+* A second callback, which replaces the recording one.
+**********************************************************************/
+static void
+DioTest_EdgeOther(DioChannel_t Channel, DioState_t State)
+{
+  (void)Channel;
+  (void)State;
+  DioTest_OtherCount++;
+}
+
+/**********************************************************************
+* Function : DioTest_EdgeDrive()
+*//**
+* \b Description:
+* Drives an input channel to a level.
+**********************************************************************/
+static void
+DioTest_EdgeDrive(DioChannel_t Channel, DioState_t State)
+{
+  DioSim_InputDrive(DIO_CHANNEL_PORT(Channel), DIO_CHANNEL_MASK(Channel),
+                    (State == DIO_STATE_HIGH) ? DIO_CHANNEL_MASK(Channel) : 0);
+}
+
+/**********************************************************************
+* Function : DioTest_EdgeScan()
+*//**
+* \b Description:
+* Runs a scan, checks the ports it reports changed and that it made
+* Count calls, and clears the record.
+**********************************************************************/
+static void
+DioTest_EdgeScan(uint8_t Ports, uint32_t Count)
+{
+  DioTest_CallCount = 0;
+  DIO_TEST_CHECK(Dio_ScanChanges() == Ports);
+  DIO_TEST_CHECK(DioTest_CallCount == Count);
+}
+
+/**********************************************************************
+* Function : DioTest_EdgeCall()
+*//**
+* \b Description:
+* Checks call Index of the last scan.
+**********************************************************************/
+static void
+DioTest_EdgeCall(uint32_t Index, DioChannel_t Channel, DioState_t State)
+{
+  DIO_TEST_CHECK(Index < DioTest_CallCount);
+  DIO_TEST_CHECK(DioTest_Calls[Index].Channel == Channel);
+  DIO_TEST_CHECK(DioTest_Calls[Index].State == State);
+}
+
+static void
+DioTest_EdgeSetup(void)
+{
+  DioSim_Reset();
+  Dio_Init(Dio_ConfigGet());
+  Dio_SetPortDirection(DioTest_First, 0);
+  Dio_SetPortDirection(DioTest_Last, 0);
+  DioSim_InputDrive(DioTest_First, (DioPortValue_t)~(DioPortValue_t)0, 0);
+  DioSim_InputDrive(DioTest_Last, (DioPortValue_t)~(DioPortValue_t)0, 0);
+  Dio_EdgeInit();
+  Dio_EdgeRegister(DioTest_Rising, DIO_EDGE_RISING, DioTest_EdgeRecord);
+  Dio_EdgeRegister(DioTest_Falling, DIO_EDGE_FALLING, DioTest_EdgeRecord);
+  Dio_EdgeRegister(DioTest_Both, DIO_EDGE_BOTH, DioTest_EdgeRecord);
+  Dio_EdgeRegister(DioTest_Other, DIO_EDGE_BOTH, DioTest_EdgeRecord);
+}
+
+static void
+DioTest_EdgeDispatch(void)
+{
+  DioTest_EdgeSetup();
+
+  // Nothing changed, no call
+  DioTest_EdgeScan(0, 0);
+
+  // Four channels of two ports rise in one scan: one call per channel
+  // registered for the rising edge, in channel order, after the scan
+  DioTest_EdgeDrive(DioTest_Rising, DIO_STATE_HIGH);
+  DioTest_EdgeDrive(DioTest_Falling, DIO_STATE_HIGH);
+  DioTest_EdgeDrive(DioTest_Both, DIO_STATE_HIGH);
+  DioTest_EdgeDrive(DioTest_Other, DIO_STATE_HIGH);
+  DioTest_EdgeScan(2, 3);
+  DioTest_EdgeCall(0, DioTest_Other, DIO_STATE_HIGH);
+  DioTest_EdgeCall(1, DioTest_Rising, DIO_STATE_HIGH);
+  DioTest_EdgeCall(2, DioTest_Both, DIO_STATE_HIGH);
+  DIO_TEST_CHECK(Dio_EdgeRisingGet(DioTest_Last)
+                 == (DioPortValue_t)(DIO_CHANNEL_MASK(DioTest_Rising)
+                                     | DIO_CHANNEL_MASK(DioTest_Falling)
+                                     | DIO_CHANNEL_MASK(DioTest_Both)));
+  DIO_TEST_CHECK(Dio_EdgeFallingGet(DioTest_Last) == 0);
+
+  // The levels held, no call
+  DioTest_EdgeScan(0, 0);
+  DIO_TEST_CHECK(Dio_EdgeRisingGet(DioTest_Last) == 0);
+
+  // All fall: the falling and both edges
+  DioTest_EdgeDrive(DioTest_Rising, DIO_STATE_LOW);
+  DioTest_EdgeDrive(DioTest_Falling, DIO_STATE_LOW);
+  DioTest_EdgeDrive(DioTest_Both, DIO_STATE_LOW);
+  DioTest_EdgeDrive(DioTest_Other, DIO_STATE_LOW);
+  DioTest_EdgeScan(2, 3);
+  DioTest_EdgeCall(0, DioTest_Other, DIO_STATE_LOW);
+  DioTest_EdgeCall(1, DioTest_Falling, DIO_STATE_LOW);
+  DioTest_EdgeCall(2, DioTest_Both, DIO_STATE_LOW);
+
+  // A channel without a callback changes the port, calls nothing
+  DioTest_EdgeDrive(DioTest_Unregistered, DIO_STATE_HIGH);
+  DioTest_EdgeScan(1, 0);
+  DIO_TEST_CHECK(Dio_EdgeRisingGet(DioTest_Last) == DIO_CHANNEL_MASK(DioTest_Unregistered));
+  DioTest_EdgeDrive(DioTest_Unregistered, DIO_STATE_LOW);
+  DioTest_EdgeScan(1, 0);
+
+  // A pulse between two scans is not an edge
+  DioTest_EdgeDrive(DioTest_Both, DIO_STATE_HIGH);
+  DioTest_EdgeDrive(DioTest_Both, DIO_STATE_LOW);
+  DioTest_EdgeScan(0, 0);
+}
+
+static void
+DioTest_EdgeRegistration(void)
+{
+  DioTest_EdgeSetup();
+
+  // A new registration replaces the callback and the edges
+  DioTest_OtherCount = 0;
+  Dio_EdgeRegister(DioTest_Rising, DIO_EDGE_FALLING, DioTest_EdgeOther);
+  DioTest_EdgeDrive(DioTest_Rising, DIO_STATE_HIGH);
+  DioTest_EdgeScan(1, 0);
+  DioTest_EdgeDrive(DioTest_Rising, DIO_STATE_LOW);
+  DioTest_EdgeScan(1, 0);
+  DIO_TEST_CHECK(DioTest_OtherCount == 1);
+
+  // Removed with DIO_EDGE_NONE or NULL
+  Dio_EdgeRegister(DioTest_Both, DIO_EDGE_NONE, DioTest_EdgeRecord);
+  Dio_EdgeRegister(DioTest_Other, DIO_EDGE_BOTH, NULL);
+  DioTest_EdgeDrive(DioTest_Both, DIO_STATE_HIGH);
+  DioTest_EdgeDrive(DioTest_Other, DIO_STATE_HIGH);
+  DioTest_EdgeScan(2, 0);
+
+  // The snapshot is the level of the last scan
+  DIO_TEST_CHECK(Dio_EdgeSnapshotGet(DioTest_Last) == DIO_CHANNEL_MASK(DioTest_Both));
+  DIO_TEST_CHECK(Dio_EdgeSnapshotGet(DioTest_First) == DIO_CHANNEL_MASK(DioTest_Other));
+}
+
+int
+main(void)
+{
+  DioTest_EdgeDispatch();
+  DioTest_EdgeRegistration();
+  return DIO_TEST_RESULT();
+}
+/*************** END OF FILE ********************************/
@@ -0,0 +1,192 @@
+/**
+ * @file dio_test_inline.c
+ * @author Mohamed Hassanin
+ * @brief The host test of the inline channel accessors of DIO_INLINE: it
+ * is linked without dio.c, so that it only builds when Dio_ChannelRead,
+ * Dio_ChannelWrite and Dio_SetChannelDirection are inline, and checks
+ * each channel of the target: the bit and the register each accessor
+ * reaches, the other bits of the port, and the register accesses of a
+ * call, the same as the functions of dio.c.
+ *
+ * \b Example (from Embedded_Targets):
+ * @code
+ * gcc -O2 -DDIO_SIM -DDIO_INLINE=1 -DDIO_SHADOW=0 -Iatmega328p -Ihost_sim \
+ *     host_sim/dio_sim.c host_sim/dio_test_inline.c -o dio_test_inline
+ * ./dio_test_inline
+ * @endcode
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio.h" /* For the interface under test */
+#include "dio_memmap.h" /* For the register addresses */
+#include "dio_test.h" /* For the checks */
+
+#if DIO_INLINE != STD_ON
+#error "dio_test_inline.c checks the inline accessors, build it with DIO_INLINE=1"
+#endif
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the register accesses of a Dio_ChannelWrite: one store to a set
+* or clear register, or a read-modify-write of PORTx, with the read and
+* the write of SREG when it is atomic, and the accesses made with the
+* interrupts disabled: the read and the write of PORTx.
+*/
+#ifdef DIO_SET_ADDRESS
+#define DIO_TEST_WRITE_READS 0U
+#define DIO_TEST_WRITE_WRITES 1U
+#define DIO_TEST_WRITE_MASKED 0U
+#elif DIO_ATOMIC == STD_ON
+#define DIO_TEST_WRITE_READS 2U
+#define DIO_TEST_WRITE_WRITES 2U
+#define DIO_TEST_WRITE_MASKED 2U
+#else
+#define DIO_TEST_WRITE_READS 1U
+#define DIO_TEST_WRITE_WRITES 1U
+#define DIO_TEST_WRITE_MASKED 0U
+#endif
+/**
+* Defines the register accesses of a Dio_SetChannelDirection: a
+* read-modify-write of DDRx, with SREG when it is atomic.
+*/
+#if DIO_ATOMIC == STD_ON
+#define DIO_TEST_DIRECTION_READS 2U
+#define DIO_TEST_DIRECTION_WRITES 2U
+#define DIO_TEST_DIRECTION_MASKED 2U
+#else
+#define DIO_TEST_DIRECTION_READS 1U
+#define DIO_TEST_DIRECTION_WRITES 1U
+#define DIO_TEST_DIRECTION_MASKED 0U
+#endif
+/**
+* Defines the trace length, the writes of one call.
+*/
+#define DIO_TEST_TRACE 4U
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The level of the other channels of the port under test.
+*/
+static const DioPortValue_t DioTest_Other = (DioPortValue_t)0x5A5A5A5AUL;
+/**
+* The write trace of the call under test.
+*/
+static DioSimWrite_t DioTest_Trace[DIO_TEST_TRACE];
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : DioTest_InlineCall()
+*//**
+* \b Description:
+* Ends the trace and the counters of a call: checks its register
+* accesses, those made with the interrupts disabled, and that its
+* writes, SREG aside, reach Address alone.
+**********************************************************************/
+static void
+DioTest_InlineCall(uint16_t Address, uint32_t Reads, uint32_t Writes, uint32_t Masked)
+{
+  const uint32_t Traced = DioSim_TraceStop();
+  DioSimCounters_t Counters;
+
+  DioSim_CountersGet(&Counters);
+  DIO_TEST_CHECK(Counters.Reads == Reads);
+  DIO_TEST_CHECK(Counters.Writes == Writes);
+  DIO_TEST_CHECK(Counters.Masked == Masked);
+  DIO_TEST_CHECK(Traced == Writes);
+  for (uint32_t i = 0; i < Traced && i < DIO_TEST_TRACE; i++)
+    {
+      DIO_TEST_CHECK(DioTest_Trace[i].Address == Address
+                     || DioTest_Trace[i].Address == DIO_TEST_ADDRESS((volatile DioPortValue_t *)SREG));
+    }
+}
+
+/**********************************************************************
+* Function : DioTest_InlineStart()
+*//**
+* \b Description:
+* Starts the trace and the counters of a call.
+**********************************************************************/
+static void
+DioTest_InlineStart(void)
+{
+  DioSim_CountersReset();
+  DioSim_TraceStart(DioTest_Trace, DIO_TEST_TRACE);
+}
+
+static void
+DioTest_InlineChannel(DioChannel_t Channel)
+{
+  const DioPort_t Port = DIO_CHANNEL_PORT(Channel);
+  const DioPortValue_t Mask = DIO_CHANNEL_MASK(Channel);
+  volatile DioPortValue_t * const Ddr = (volatile DioPortValue_t *)DIO_DDR_ADDRESS(Port);
+  volatile DioPortValue_t * const Out = (volatile DioPortValue_t *)DIO_PORT_ADDRESS(Port);
+
+  DioSim_Reset();
+  DioSim_RegWrite(Ddr, (DioPortValue_t)(DioTest_Other & (DioPortValue_t)~Mask));
+  DioSim_RegWrite(Out, (DioPortValue_t)(DioTest_Other & (DioPortValue_t)~Mask));
+
+  DioTest_InlineStart();
+  Dio_SetChannelDirection(Channel, DIO_DIR_OUTPUT);
+  DioTest_InlineCall(DIO_TEST_ADDRESS(Ddr), DIO_TEST_DIRECTION_READS, DIO_TEST_DIRECTION_WRITES,
+                     DIO_TEST_DIRECTION_MASKED);
+  DIO_TEST_CHECK(DioSim_RegRead(Ddr) == (DioPortValue_t)(DioTest_Other | Mask));
+
+  DioTest_InlineStart();
+  Dio_ChannelWrite(Channel, DIO_STATE_HIGH);
+#ifdef DIO_SET_ADDRESS
+  DioTest_InlineCall(DIO_TEST_ADDRESS((volatile DioPortValue_t *)DIO_SET_ADDRESS(Port)),
+                     DIO_TEST_WRITE_READS, DIO_TEST_WRITE_WRITES,
+                     DIO_TEST_WRITE_MASKED);
+#else
+  DioTest_InlineCall(DIO_TEST_ADDRESS(Out), DIO_TEST_WRITE_READS, DIO_TEST_WRITE_WRITES,
+                     DIO_TEST_WRITE_MASKED);
+#endif
+  DIO_TEST_CHECK(DioSim_PortLevel(Port) == (DioPortValue_t)(DioTest_Other | Mask));
+
+  DioTest_InlineStart();
+  DIO_TEST_CHECK(Dio_ChannelRead(Channel) == DIO_STATE_HIGH);
+  DioTest_InlineCall(0, 1U, 0U, 0U);
+
+  DioTest_InlineStart();
+  Dio_ChannelWrite(Channel, DIO_STATE_LOW);
+#ifdef DIO_SET_ADDRESS
+  DioTest_InlineCall(DIO_TEST_ADDRESS((volatile DioPortValue_t *)DIO_CLEAR_ADDRESS(Port)),
+                     DIO_TEST_WRITE_READS, DIO_TEST_WRITE_WRITES,
+                     DIO_TEST_WRITE_MASKED);
+#else
+  DioTest_InlineCall(DIO_TEST_ADDRESS(Out), DIO_TEST_WRITE_READS, DIO_TEST_WRITE_WRITES,
+                     DIO_TEST_WRITE_MASKED);
+#endif
+  DIO_TEST_CHECK(DioSim_PortLevel(Port) == (DioPortValue_t)(DioTest_Other & (DioPortValue_t)~Mask));
+  DIO_TEST_CHECK(Dio_ChannelRead(Channel) == DIO_STATE_LOW);
+
+  DioTest_InlineStart();
+  Dio_SetChannelDirection(Channel, DIO_DIR_INPUT);
+  DioTest_InlineCall(DIO_TEST_ADDRESS(Ddr), DIO_TEST_DIRECTION_READS, DIO_TEST_DIRECTION_WRITES,
+                     DIO_TEST_DIRECTION_MASKED);
+  DIO_TEST_CHECK(DioSim_RegRead(Ddr) == (DioPortValue_t)(DioTest_Other & (DioPortValue_t)~Mask));
+
+  // An input reads the level driven on the pin
+  DioSim_InputDrive(Port, Mask, Mask);
+  DIO_TEST_CHECK(Dio_ChannelRead(Channel) == DIO_STATE_HIGH);
+  DioSim_InputDrive(Port, Mask, 0);
+  DIO_TEST_CHECK(Dio_ChannelRead(Channel) == DIO_STATE_LOW);
+}
+
+int
+main(void)
+{
+  for (uint32_t Channel = 0; Channel < DIO_CHANNEL_MAX; Channel++)
+    {
+      DioTest_InlineChannel((DioChannel_t)Channel);
+    }
+  return DIO_TEST_RESULT();
+}
+/*************** END OF FILE ********************************/
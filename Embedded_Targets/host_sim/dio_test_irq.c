@@ -0,0 +1,209 @@
+/**
+ * @file dio_test_irq.c
+ * @author Mohamed Hassanin
+ * @brief The host test of the dio interrupt driven inputs: the edges of
+ * the channels of the interrupt table raise their vector on the
+ * simulation, and the event queue is checked entry by entry: the order,
+ * the port, the channel and the level of each event, the edge filter,
+ * the vectors pending while the interrupts are disabled and the
+ * overflow of a full queue.
+ *
+ * \b Example (from Embedded_Targets):
+ * @code
+ * gcc -O2 -DDIO_SIM -Iatmega328p -Ihost_sim atmega328p/dio*.c \
+ *     host_sim/dio_sim.c host_sim/dio_test_irq.c -o dio_test_irq
+ * ./dio_test_irq
+ * @endcode
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio.h" /* For the channel directions */
+#include "dio_irq.h" /* For the interface under test */
+#include "dio_memmap.h" /* For the interrupt vectors */
+#include "dio_test.h" /* For the checks */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the number of edges applied to each channel of the table.
+*/
+#define DIO_TEST_EDGES 6U
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : DioTest_IrqVector()
+*//**
+* \b Description:
+* The vector of a channel: the pin change bank of its port, or the
+* external interrupt of its pin.
+**********************************************************************/
+static uint8_t
+DioTest_IrqVector(DioChannel_t Channel)
+{
+#ifdef DIO_PCINT0_VECTOR
+  return (uint8_t)(DIO_PCINT0_VECTOR + DIO_CHANNEL_PORT(Channel));
+#else
+  switch (Channel)
+    {
+    case PORTD_2:
+      return DIO_INT0_VECTOR;
+    case PORTD_3:
+      return DIO_INT1_VECTOR;
+    default:
+      return DIO_INT2_VECTOR;
+    }
+#endif
+}
+
+/**********************************************************************
+* Function : DioTest_IrqEdge()
+*//**
+* \b Description:
+* Drives a channel to Level and raises its vector like the hardware: a
+* pin change bank on any change, an external interrupt on the edges it
+* senses. Returns 1 when the driver must queue an event for the edge.
+**********************************************************************/
+static uint8_t
+DioTest_IrqEdge(const DioIrqConfig_t * const Row, DioState_t Level)
+{
+  const DioPort_t Port = DIO_CHANNEL_PORT(Row->Channel);
+  const DioPortValue_t Mask = DIO_CHANNEL_MASK(Row->Channel);
+  const uint8_t Event = (Row->Edge == DIO_IRQ_BOTH)
+                        || (Row->Edge == DIO_IRQ_RISING && Level == DIO_STATE_HIGH)
+                        || (Row->Edge == DIO_IRQ_FALLING && Level == DIO_STATE_LOW);
+
+  DioSim_InputDrive(Port, Mask, (Level == DIO_STATE_HIGH) ? Mask : 0);
+#ifdef DIO_PCINT0_VECTOR
+  DioSim_VectorRaise(DioTest_IrqVector(Row->Channel));
+#else
+  if(Event != 0)
+    {
+      DioSim_VectorRaise(DioTest_IrqVector(Row->Channel));
+    }
+#endif
+  return Event;
+}
+
+static void
+DioTest_IrqSetup(void)
+{
+  const DioIrqConfig_t * const Config = Dio_IrqConfigGet();
+
+  DioSim_Reset();
+  Dio_Init(Dio_ConfigGet());
+  for (uint8_t Row = 0; Row < DIO_IRQ_CHANNELS; Row++)
+    {
+      Dio_SetChannelDirection(Config[Row].Channel, DIO_DIR_INPUT);
+      DioSim_InputDrive(DIO_CHANNEL_PORT(Config[Row].Channel),
+                        DIO_CHANNEL_MASK(Config[Row].Channel),
+                        DIO_CHANNEL_MASK(Config[Row].Channel));
+    }
+  Dio_IrqInit(Config);
+  DioSim_InterruptsEnable();
+}
+
+static void
+DioTest_IrqEvents(void)
+{
+  const DioIrqConfig_t * const Config = Dio_IrqConfigGet();
+  DioIrqEvent_t Expected[DIO_IRQ_QUEUE_SIZE];
+  DioIrqEvent_t Events[DIO_IRQ_QUEUE_SIZE];
+  uint8_t Count = 0;
+
+  DioTest_IrqSetup();
+  DIO_TEST_CHECK(Dio_IrqEventsRead(Events, DIO_IRQ_QUEUE_SIZE) == 0);
+
+  // Alternate the channels so that the events of the rows interleave
+  for (uint8_t Edge = 0; Edge < DIO_TEST_EDGES; Edge++)
+    {
+      for (uint8_t Row = 0; Row < DIO_IRQ_CHANNELS; Row++)
+        {
+          const DioState_t Level = (Edge & 1U) ? DIO_STATE_HIGH : DIO_STATE_LOW;
+
+          if(DioTest_IrqEdge(&Config[Row], Level) != 0 && Count < DIO_IRQ_QUEUE_SIZE)
+            {
+              Expected[Count].Port = DIO_CHANNEL_PORT(Config[Row].Channel);
+              Expected[Count].Changed = DIO_CHANNEL_MASK(Config[Row].Channel);
+              Expected[Count].Level = (Level == DIO_STATE_HIGH) ? Expected[Count].Changed : 0;
+              Count++;
+            }
+        }
+    }
+
+  DIO_TEST_CHECK(Count < DIO_IRQ_QUEUE_SIZE);
+  DIO_TEST_CHECK(Dio_IrqEventsRead(Events, DIO_IRQ_QUEUE_SIZE) == Count);
+  for (uint8_t i = 0; i < Count; i++)
+    {
+      DIO_TEST_CHECK(Events[i].Port == Expected[i].Port);
+      DIO_TEST_CHECK((Events[i].Changed & Expected[i].Changed) == Expected[i].Changed);
+      DIO_TEST_CHECK((Events[i].Level & Expected[i].Changed) == Expected[i].Level);
+    }
+  DIO_TEST_CHECK(Dio_IrqEventsRead(Events, DIO_IRQ_QUEUE_SIZE) == 0);
+  DIO_TEST_CHECK(Dio_IrqOverflowsGet() == 0);
+}
+
+static void
+DioTest_IrqPending(void)
+{
+  const DioIrqConfig_t * const Row = &Dio_IrqConfigGet()[0];
+  DioIrqEvent_t Events[2];
+
+  DioTest_IrqSetup();
+
+  // The vector waits for the interrupts, the event carries the level then
+  DioSim_InterruptsDisable();
+  (void)DioTest_IrqEdge(Row, (Row->Edge == DIO_IRQ_RISING) ? DIO_STATE_HIGH : DIO_STATE_LOW);
+  DIO_TEST_CHECK(Dio_IrqEventsRead(Events, 2) == 0);
+  DioSim_InterruptsEnable();
+  if(Row->Edge == DIO_IRQ_RISING)
+    {
+      DIO_TEST_CHECK(Dio_IrqEventsRead(Events, 2) == 0);
+    }
+  else
+    {
+      DIO_TEST_CHECK(Dio_IrqEventsRead(Events, 2) == 1);
+      DIO_TEST_CHECK(Events[0].Port == DIO_CHANNEL_PORT(Row->Channel));
+      DIO_TEST_CHECK((Events[0].Level & DIO_CHANNEL_MASK(Row->Channel)) == 0);
+    }
+}
+
+static void
+DioTest_IrqOverflow(void)
+{
+  const DioIrqConfig_t * const Config = Dio_IrqConfigGet();
+  DioIrqEvent_t Events[DIO_IRQ_QUEUE_SIZE];
+  uint16_t Raised = 0;
+
+  DioTest_IrqSetup();
+
+  // The queue keeps one entry free: DIO_IRQ_QUEUE_SIZE - 1 events fit
+  for (uint16_t Edge = 0; Edge < 2U * DIO_IRQ_QUEUE_SIZE; Edge++)
+    {
+      Raised += DioTest_IrqEdge(&Config[DIO_IRQ_CHANNELS - 1U],
+                                (Edge & 1U) ? DIO_STATE_HIGH : DIO_STATE_LOW);
+    }
+  DIO_TEST_CHECK(Raised >= DIO_IRQ_QUEUE_SIZE);
+  DIO_TEST_CHECK(Dio_IrqOverflowsGet() == Raised - (DIO_IRQ_QUEUE_SIZE - 1U));
+  DIO_TEST_CHECK(Dio_IrqEventsRead(Events, DIO_IRQ_QUEUE_SIZE) == DIO_IRQ_QUEUE_SIZE - 1U);
+
+  // The oldest events are kept, the queue accepts events again
+  DIO_TEST_CHECK(Events[0].Port == DIO_CHANNEL_PORT(Config[DIO_IRQ_CHANNELS - 1U].Channel));
+  (void)DioTest_IrqEdge(&Config[DIO_IRQ_CHANNELS - 1U], DIO_STATE_LOW);
+  (void)DioTest_IrqEdge(&Config[DIO_IRQ_CHANNELS - 1U], DIO_STATE_HIGH);
+  DIO_TEST_CHECK(Dio_IrqEventsRead(Events, DIO_IRQ_QUEUE_SIZE) >= 1);
+}
+
+int
+main(void)
+{
+  DioTest_IrqEvents();
+  DioTest_IrqPending();
+  DioTest_IrqOverflow();
+  return DIO_TEST_RESULT();
+}
+/*************** END OF FILE ********************************/
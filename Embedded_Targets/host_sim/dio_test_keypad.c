@@ -0,0 +1,425 @@
+/**
+ * @file dio_test_keypad.c
+ * @author Mohamed Hassanin
+ * @brief The host test of the dio matrix keypad scanner: a model of the
+ * matrix without diodes drives the column inputs after each row strobe,
+ * a column is pulled LOW through the pressed keys by a row driven LOW,
+ * ghost keys included. The events and the key bitmap are checked for a
+ * single key, the debounce counters, n-key rollover, three keys at the
+ * corners of a rectangle and an overflow of the event queue.
+ *
+ * \b Example (from Embedded_Targets):
+ * @code
+ * gcc -O2 -DDIO_SIM -Iatmega328p -Ihost_sim atmega328p/dio*.c \
+ *     host_sim/dio_sim.c host_sim/dio_test_keypad.c -o dio_test_keypad
+ * ./dio_test_keypad
+ * @endcode
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio.h" /* For the channel macros */
+#include "dio_keypad.h" /* For the interface under test */
+#include "dio_memmap.h" /* For the register addresses */
+#include "dio_test.h" /* For the checks */
+
+#if DIO_KEYPAD_DIODES != STD_OFF
+#error "dio_test_keypad.c models a matrix without diodes"
+#endif
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the scans a key takes to change state.
+*/
+#define DIO_TEST_DEBOUNCE (1U << DIO_KEYPAD_COUNTER_BITS)
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The keypad matrix of the target.
+*/
+static const DioKeypadConfig_t * DioTest_Keypad;
+/**
+* The pressed keys of each row, bit n for column n, and the direction
+* registers as last written, which tell the rows driven LOW.
+*/
+static uint8_t DioTest_Keys[DIO_KEYPAD_ROWS];
+static DioPortValue_t DioTest_Ddr[DIO_NUMBER_OF_PORTS];
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : DioTest_KeypadMatrix()
+*//**
+* \b Description:
+* The write hook of the test: follows the direction registers and drives
+* each column LOW when a pressed key joins it to a row driven LOW, either
+* directly or through other pressed keys, like the wires of a matrix
+* without diodes. The other columns are driven HIGH.
+**********************************************************************/
+static void
+DioTest_KeypadMatrix(uint16_t Address, DioPortValue_t Value)
+{
+  uint8_t Rows = 0;
+  uint8_t Columns = 0;
+
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      if(Address == DIO_TEST_ADDRESS(DIO_DDR_ADDRESS(Port)))
+        {
+          DioTest_Ddr[Port] = Value;
+        }
+    }
+  for (uint8_t Row = 0; Row < DIO_KEYPAD_ROWS; Row++)
+    {
+      const DioChannel_t Channel = DioTest_Keypad->Rows[Row];
+
+      if(DioTest_Ddr[DIO_CHANNEL_PORT(Channel)] & DIO_CHANNEL_MASK(Channel))
+        {
+          Rows |= (uint8_t)(1U << Row);
+        }
+    }
+
+  // Spread the LOW level through the keys until it settles
+  for (uint8_t Pass = 0; Pass < DIO_KEYPAD_ROWS + DIO_KEYPAD_COLUMNS; Pass++)
+    {
+      for (uint8_t Row = 0; Row < DIO_KEYPAD_ROWS; Row++)
+        {
+          if(Rows & (1U << Row))
+            {
+              Columns |= DioTest_Keys[Row];
+            }
+          else if(Columns & DioTest_Keys[Row])
+            {
+              Rows |= (uint8_t)(1U << Row);
+            }
+        }
+    }
+
+  for (uint8_t Column = 0; Column < DIO_KEYPAD_COLUMNS; Column++)
+    {
+      const DioChannel_t Channel = DioTest_Keypad->Columns[Column];
+
+      DioSim_InputDrive(DIO_CHANNEL_PORT(Channel), DIO_CHANNEL_MASK(Channel),
+                        (Columns & (1U << Column)) ? 0 : DIO_CHANNEL_MASK(Channel));
+    }
+}
+
+static void
+DioTest_KeypadSetup(void)
+{
+  DioSim_Reset();
+  for (uint8_t Row = 0; Row < DIO_KEYPAD_ROWS; Row++)
+    {
+      DioTest_Keys[Row] = 0;
+    }
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      DioTest_Ddr[Port] = 0;
+    }
+  DioTest_Keypad = Dio_KeypadConfigGet();
+  DioSim_HookSet(DioTest_KeypadMatrix);
+  Dio_Init(Dio_ConfigGet());
+  Dio_KeypadInit(DioTest_Keypad);
+}
+
+/**********************************************************************
+* Function : DioTest_KeypadKey()
+*//**
+* \b Description:
+* Presses or releases a key of the matrix model.
+**********************************************************************/
+static void
+DioTest_KeypadKey(uint8_t Row, uint8_t Column, uint8_t Pressed)
+{
+  if(Pressed != 0)
+    {
+      DioTest_Keys[Row] |= (uint8_t)(1U << Column);
+    }
+  else
+    {
+      DioTest_Keys[Row] &= (uint8_t)~(1U << Column);
+    }
+}
+
+/**********************************************************************
+* Function : DioTest_KeypadScans()
+*//**
+* \b Description:
+* Runs Scans scans and checks that none of them queued an event.
+**********************************************************************/
+static void
+DioTest_KeypadScans(uint32_t Scans)
+{
+  DioKeypadEvent_t Event;
+
+  for (uint32_t i = 0; i < Scans; i++)
+    {
+      Dio_KeypadScan();
+    }
+  DIO_TEST_CHECK(Dio_KeypadEventRead(&Event) == 0);
+}
+
+/**********************************************************************
+* Function : DioTest_KeypadEvent()
+*//**
+* \b Description:
+* Checks that the next event of the queue is Pressed for the key at Row
+* and Column.
+**********************************************************************/
+static void
+DioTest_KeypadEvent(uint8_t Row, uint8_t Column, uint8_t Pressed)
+{
+  DioKeypadEvent_t Event = { 0xFF, 0xFF };
+
+  DIO_TEST_CHECK(Dio_KeypadEventRead(&Event) == 1);
+  DIO_TEST_CHECK(Event.Key == Row * DIO_KEYPAD_COLUMNS + Column);
+  DIO_TEST_CHECK(Event.Pressed == Pressed);
+}
+
+/**********************************************************************
+* Function : DioTest_KeypadBitmap()
+*//**
+* \b Description:
+* Checks the key bitmap and the state of each key against the keys of
+* Expected, one byte per row.
+**********************************************************************/
+static void
+DioTest_KeypadBitmap(const uint8_t * const Expected)
+{
+  uint8_t Bitmap[DIO_KEYPAD_ROWS];
+
+  Dio_KeypadBitmapGet(Bitmap);
+  for (uint8_t Row = 0; Row < DIO_KEYPAD_ROWS; Row++)
+    {
+      DIO_TEST_CHECK(Bitmap[Row] == Expected[Row]);
+      for (uint8_t Column = 0; Column < DIO_KEYPAD_COLUMNS; Column++)
+        {
+          DIO_TEST_CHECK(Dio_KeypadIsPressed((uint8_t)(Row * DIO_KEYPAD_COLUMNS + Column))
+                         == ((Expected[Row] >> Column) & 1U));
+        }
+    }
+}
+
+static void
+DioTest_KeypadSingle(void)
+{
+  const uint8_t None[DIO_KEYPAD_ROWS] = { 0 };
+  uint8_t Expected[DIO_KEYPAD_ROWS] = { 0 };
+  const uint8_t Row = DIO_KEYPAD_ROWS - 1U;
+  const uint8_t Column = DIO_KEYPAD_COLUMNS - 1U;
+
+  DioTest_KeypadSetup();
+  DioTest_KeypadScans(DIO_TEST_DEBOUNCE);
+  DioTest_KeypadBitmap(None);
+
+  // Pressed after DIO_TEST_DEBOUNCE scans, not one before
+  DioTest_KeypadKey(Row, Column, 1);
+  DioTest_KeypadScans(DIO_TEST_DEBOUNCE - 1U);
+  DioTest_KeypadBitmap(None);
+  Dio_KeypadScan();
+  DioTest_KeypadEvent(Row, Column, 1);
+  Expected[Row] = (uint8_t)(1U << Column);
+  DioTest_KeypadBitmap(Expected);
+
+  // Held, no more events
+  DioTest_KeypadScans(4U * DIO_TEST_DEBOUNCE);
+  DioTest_KeypadBitmap(Expected);
+
+  // Released the same way
+  DioTest_KeypadKey(Row, Column, 0);
+  DioTest_KeypadScans(DIO_TEST_DEBOUNCE - 1U);
+  DioTest_KeypadBitmap(Expected);
+  Dio_KeypadScan();
+  DioTest_KeypadEvent(Row, Column, 0);
+  DioTest_KeypadBitmap(None);
+  DIO_TEST_CHECK(Dio_KeypadOverflowsGet() == 0);
+}
+
+static void
+DioTest_KeypadBounce(void)
+{
+  uint8_t Expected[DIO_KEYPAD_ROWS] = { 0 };
+
+  DioTest_KeypadSetup();
+
+  // A bounce clears the counter of the key, the count starts over
+  DioTest_KeypadKey(0, 0, 1);
+  DioTest_KeypadScans(DIO_TEST_DEBOUNCE - 1U);
+  DioTest_KeypadKey(0, 0, 0);
+  DioTest_KeypadScans(1);
+  DioTest_KeypadKey(0, 0, 1);
+  DioTest_KeypadScans(DIO_TEST_DEBOUNCE - 1U);
+  DioTest_KeypadBitmap(Expected);
+  Dio_KeypadScan();
+  DioTest_KeypadEvent(0, 0, 1);
+  Expected[0] = 1U;
+  DioTest_KeypadBitmap(Expected);
+
+  // The counter wrapped to zero with the change: a release also takes
+  // DIO_TEST_DEBOUNCE scans, and a release bounce starts it over
+  DioTest_KeypadKey(0, 0, 0);
+  DioTest_KeypadScans(DIO_TEST_DEBOUNCE - 1U);
+  DioTest_KeypadKey(0, 0, 1);
+  DioTest_KeypadScans(1);
+  DioTest_KeypadKey(0, 0, 0);
+  DioTest_KeypadScans(DIO_TEST_DEBOUNCE - 1U);
+  DioTest_KeypadBitmap(Expected);
+  Dio_KeypadScan();
+  DioTest_KeypadEvent(0, 0, 0);
+}
+
+static void
+DioTest_KeypadRollover(void)
+{
+  uint8_t Expected[DIO_KEYPAD_ROWS] = { 0 };
+  const uint8_t None[DIO_KEYPAD_ROWS] = { 0 };
+
+  DioTest_KeypadSetup();
+
+  // A whole row: every key is reported, in column order
+  for (uint8_t Column = 0; Column < DIO_KEYPAD_COLUMNS; Column++)
+    {
+      DioTest_KeypadKey(0, Column, 1);
+    }
+  DioTest_KeypadScans(DIO_TEST_DEBOUNCE - 1U);
+  Dio_KeypadScan();
+  for (uint8_t Column = 0; Column < DIO_KEYPAD_COLUMNS; Column++)
+    {
+      DioTest_KeypadEvent(0, Column, 1);
+    }
+  Expected[0] = (uint8_t)((1U << DIO_KEYPAD_COLUMNS) - 1U);
+  DioTest_KeypadBitmap(Expected);
+  DioTest_KeypadScans(0);
+
+  // Then a whole column, the keys of row 0 but one released meanwhile
+  for (uint8_t Column = 1; Column < DIO_KEYPAD_COLUMNS; Column++)
+    {
+      DioTest_KeypadKey(0, Column, 0);
+    }
+  for (uint8_t Row = 1; Row < DIO_KEYPAD_ROWS; Row++)
+    {
+      DioTest_KeypadKey(Row, 0, 1);
+    }
+  DioTest_KeypadScans(DIO_TEST_DEBOUNCE - 1U);
+  Dio_KeypadScan();
+  for (uint8_t Column = 1; Column < DIO_KEYPAD_COLUMNS; Column++)
+    {
+      DioTest_KeypadEvent(0, Column, 0);
+    }
+  for (uint8_t Row = 1; Row < DIO_KEYPAD_ROWS; Row++)
+    {
+      DioTest_KeypadEvent(Row, 0, 1);
+      Expected[Row] = 1U;
+    }
+  Expected[0] = 1U;
+  DioTest_KeypadBitmap(Expected);
+  DioTest_KeypadScans(0);
+
+  // And all of them released at once
+  for (uint8_t Row = 0; Row < DIO_KEYPAD_ROWS; Row++)
+    {
+      DioTest_KeypadKey(Row, 0, 0);
+    }
+  DioTest_KeypadScans(DIO_TEST_DEBOUNCE - 1U);
+  Dio_KeypadScan();
+  for (uint8_t Row = 0; Row < DIO_KEYPAD_ROWS; Row++)
+    {
+      DioTest_KeypadEvent(Row, 0, 0);
+    }
+  DioTest_KeypadBitmap(None);
+}
+
+static void
+DioTest_KeypadGhost(void)
+{
+  uint8_t Expected[DIO_KEYPAD_ROWS] = { 0 };
+
+  DioTest_KeypadSetup();
+
+  // Three corners of a rectangle pressed at once also close the fourth:
+  // no key can be told from a ghost, none is reported
+  DioTest_KeypadKey(0, 0, 1);
+  DioTest_KeypadKey(0, 1, 1);
+  DioTest_KeypadKey(1, 0, 1);
+  DioTest_KeypadScans(4U * DIO_TEST_DEBOUNCE);
+  DioTest_KeypadBitmap(Expected);
+
+  // One corner released, the ambiguity is gone
+  DioTest_KeypadKey(0, 1, 0);
+  DioTest_KeypadScans(DIO_TEST_DEBOUNCE - 1U);
+  Dio_KeypadScan();
+  DioTest_KeypadEvent(0, 0, 1);
+  DioTest_KeypadEvent(1, 0, 1);
+  Expected[0] = 1U;
+  Expected[1] = 1U;
+  DioTest_KeypadBitmap(Expected);
+
+  // The third corner pressed on top of two keys: the rows keep their
+  // state, the real key and the ghost are both held back
+  DioTest_KeypadKey(0, 1, 1);
+  DioTest_KeypadScans(4U * DIO_TEST_DEBOUNCE);
+  DioTest_KeypadBitmap(Expected);
+
+  // Released, the two keys of the column are released
+  DioTest_KeypadKey(0, 1, 0);
+  DioTest_KeypadKey(0, 0, 0);
+  DioTest_KeypadKey(1, 0, 0);
+  DioTest_KeypadScans(DIO_TEST_DEBOUNCE - 1U);
+  Dio_KeypadScan();
+  DioTest_KeypadEvent(0, 0, 0);
+  DioTest_KeypadEvent(1, 0, 0);
+  Expected[0] = 0;
+  Expected[1] = 0;
+  DioTest_KeypadBitmap(Expected);
+}
+
+static void
+DioTest_KeypadOverflow(void)
+{
+  // The queue keeps one entry free: it holds DIO_KEYPAD_QUEUE_SIZE - 1
+  const uint32_t Events = DIO_KEYPAD_QUEUE_SIZE + 2U;
+  DioKeypadEvent_t Event;
+
+  DioTest_KeypadSetup();
+  for (uint32_t i = 0; i < Events; i++)
+    {
+      DioTest_KeypadKey(0, 0, (uint8_t)((i & 1U) == 0));
+      for (uint32_t Scan = 0; Scan < DIO_TEST_DEBOUNCE; Scan++)
+        {
+          Dio_KeypadScan();
+        }
+    }
+  DIO_TEST_CHECK(Dio_KeypadOverflowsGet() == Events - (DIO_KEYPAD_QUEUE_SIZE - 1U));
+
+  // The oldest events are kept, the newest are lost
+  for (uint32_t i = 0; i < DIO_KEYPAD_QUEUE_SIZE - 1U; i++)
+    {
+      DioTest_KeypadEvent(0, 0, (uint8_t)((i & 1U) == 0));
+    }
+  DIO_TEST_CHECK(Dio_KeypadEventRead(&Event) == 0);
+
+  // The queue takes events again once read
+  DioTest_KeypadKey(0, 0, 1);
+  DioTest_KeypadScans(DIO_TEST_DEBOUNCE - 1U);
+  Dio_KeypadScan();
+  DioTest_KeypadEvent(0, 0, 1);
+  DIO_TEST_CHECK(Dio_KeypadOverflowsGet() == Events - (DIO_KEYPAD_QUEUE_SIZE - 1U));
+}
+
+int
+main(void)
+{
+  DioTest_KeypadSingle();
+  DioTest_KeypadBounce();
+  DioTest_KeypadRollover();
+  DioTest_KeypadGhost();
+  DioTest_KeypadOverflow();
+  DioSim_HookSet(NULL);
+  return DIO_TEST_RESULT();
+}
+/*************** END OF FILE ********************************/
@@ -0,0 +1,178 @@
+/**
+ * @file dio_test_pattern.c
+ * @author Mohamed Hassanin
+ * @brief The host test of the dio pattern playback: the port writes of
+ * the ticks are recorded by the write trace and checked sample by
+ * sample: the output sequence, the tick of each sample, the channels
+ * outside the mask, the refill of the ring, the underruns and the end
+ * and stop of the playback.
+ *
+ * \b Example (from Embedded_Targets):
+ * @code
+ * gcc -O2 -DDIO_SIM -Iatmega328p -Ihost_sim atmega328p/dio*.c \
+ *     host_sim/dio_sim.c host_sim/dio_test_pattern.c -o dio_test_pattern
+ * ./dio_test_pattern
+ * @endcode
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio.h" /* For the port interface */
+#include "dio_pattern.h" /* For the interface under test */
+#include "dio_memmap.h" /* For the register addresses */
+#include "dio_test.h" /* For the checks */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the ring size, the samples of the streamed pattern, its ticks
+* per sample and the ticks run.
+*/
+#define DIO_TEST_RING 4U
+#define DIO_TEST_SAMPLES 10U
+#define DIO_TEST_PERIOD 2U
+#define DIO_TEST_TICKS 40U
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The port the patterns are played on, the last port of the target, the
+* channels of the pattern and the level of the other channels.
+*/
+static const DioPort_t DioTest_Port = (DioPort_t)(DIO_PORT_MAX - 1U);
+static const DioPortValue_t DioTest_Mask = 0x0F;
+static const DioPortValue_t DioTest_Other = 0xA0;
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+static void
+DioTest_PatternSetup(void)
+{
+  DioSim_Reset();
+  Dio_Init(Dio_ConfigGet());
+  Dio_SetPortDirection(DioTest_Port, (DioPortValue_t)~(DioPortValue_t)0);
+  Dio_PortWrite(DioTest_Port, DioTest_Other);
+}
+
+static void
+DioTest_PatternStream(void)
+{
+  DioPortValue_t Samples[DIO_TEST_SAMPLES];
+  DioPortValue_t Ring[DIO_TEST_RING];
+  DioSimWrite_t Trace[4U * DIO_TEST_TICKS];
+  uint32_t TickCycle[DIO_TEST_TICKS + 1U];
+  const uint16_t Address = DIO_TEST_ADDRESS(DIO_PORT_ADDRESS(DioTest_Port));
+  uint16_t Sent = DIO_TEST_RING;
+  uint32_t Count = 0;
+  uint32_t Writes;
+
+  DioTest_PatternSetup();
+  for (uint8_t i = 0; i < DIO_TEST_SAMPLES; i++)
+    {
+      // The high bits are outside the mask, they must not reach the port
+      Samples[i] = (DioPortValue_t)(0xF0U | (i + 1U));
+    }
+  for (uint8_t i = 0; i < DIO_TEST_RING; i++)
+    {
+      Ring[i] = Samples[i];
+    }
+
+  Dio_PatternPlay(DioTest_Port, DioTest_Mask, Ring, DIO_TEST_RING, DIO_TEST_PERIOD);
+  DIO_TEST_CHECK(Dio_PatternIsPlaying() != 0);
+  DIO_TEST_CHECK(Dio_PatternFill(&Samples[Sent], DIO_TEST_SAMPLES - Sent) == 0);
+
+  // Each tick is followed by the refill of the ring, like a main loop.
+  // The cycle counter at the start of each tick dates the port writes.
+  DioSim_TraceStart(Trace, 4U * DIO_TEST_TICKS);
+  for (uint32_t t = 0; t < DIO_TEST_TICKS; t++)
+    {
+      TickCycle[t] = DioSim_CyclesGet();
+      Dio_PatternTick();
+      DioSim_Delay(1);
+      if(Sent < DIO_TEST_SAMPLES)
+        {
+          Sent += Dio_PatternFill(&Samples[Sent], DIO_TEST_SAMPLES - Sent);
+        }
+    }
+  TickCycle[DIO_TEST_TICKS] = DioSim_CyclesGet() + 1U;
+  Writes = DioSim_TraceStop();
+
+  DIO_TEST_CHECK(Sent == DIO_TEST_SAMPLES);
+  for (uint32_t i = 0; i < Writes; i++)
+    {
+      if(Trace[i].Address == Address)
+        {
+          const uint32_t Expected = Count * DIO_TEST_PERIOD;
+
+          DIO_TEST_CHECK(Count < DIO_TEST_SAMPLES);
+          if(Count < DIO_TEST_SAMPLES)
+            {
+              DIO_TEST_CHECK(Trace[i].Value == (DioPortValue_t)(DioTest_Other
+                                               | (Samples[Count] & DioTest_Mask)));
+              DIO_TEST_CHECK(TickCycle[Expected] < Trace[i].Cycle
+                             && Trace[i].Cycle < TickCycle[Expected + 1U]);
+            }
+          Count++;
+        }
+    }
+  DIO_TEST_CHECK(Count == DIO_TEST_SAMPLES);
+
+  // The ring ran dry after the last sample, once per period
+  DIO_TEST_CHECK(Dio_PatternUnderrunsGet()
+                 == (DIO_TEST_TICKS - DIO_TEST_SAMPLES * DIO_TEST_PERIOD) / DIO_TEST_PERIOD);
+  DIO_TEST_CHECK(Dio_PortRead(DioTest_Port)
+                 == (DioPortValue_t)(DioTest_Other | (Samples[DIO_TEST_SAMPLES - 1U] & DioTest_Mask)));
+}
+
+static void
+DioTest_PatternEnd(void)
+{
+  DioPortValue_t Shot[3] = { 0x0A, 0x0B, 0x0C };
+
+  DioTest_PatternSetup();
+  Dio_PatternPlay(DioTest_Port, DioTest_Mask, Shot, 3, 1);
+  Dio_PatternEnd();
+  for (uint8_t t = 0; t < 10; t++)
+    {
+      Dio_PatternTick();
+    }
+  DIO_TEST_CHECK(Dio_PatternIsPlaying() == 0);
+  DIO_TEST_CHECK(Dio_PatternUnderrunsGet() == 0);
+  DIO_TEST_CHECK(DioSim_PortLevel(DioTest_Port) == (DioPortValue_t)(DioTest_Other | 0x0C));
+}
+
+static void
+DioTest_PatternStop(void)
+{
+  DioPortValue_t Wave[2] = { 0x05, 0x0A };
+  DioSimCounters_t Counters;
+
+  DioTest_PatternSetup();
+  Dio_PatternPlay(DioTest_Port, DioTest_Mask, Wave, 2, 1);
+  Dio_PatternTick();
+  Dio_PatternStop();
+  DIO_TEST_CHECK(Dio_PatternIsPlaying() == 0);
+
+  // Stopped, the ticks leave the port alone
+  DioSim_CountersReset();
+  for (uint8_t t = 0; t < 4; t++)
+    {
+      Dio_PatternTick();
+    }
+  DioSim_CountersGet(&Counters);
+  DIO_TEST_CHECK(Counters.Writes == 0);
+  DIO_TEST_CHECK(DioSim_PortLevel(DioTest_Port) == (DioPortValue_t)(DioTest_Other | 0x05));
+}
+
+int
+main(void)
+{
+  DioTest_PatternStream();
+  DioTest_PatternEnd();
+  DioTest_PatternStop();
+  return DIO_TEST_RESULT();
+}
+/*************** END OF FILE ********************************/
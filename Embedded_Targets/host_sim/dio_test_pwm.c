@@ -0,0 +1,212 @@
+/**
+ * @file dio_test_pwm.c
+ * @author Mohamed Hassanin
+ * @brief The host test of the dio software PWM: the ticks of whole
+ * periods are run and the level of each PWM channel is checked at every
+ * slot, for the duty cycles 0, 1, DIO_PWM_PERIOD - 1 and DIO_PWM_PERIOD,
+ * with the channels outside the PWM table left alone. A commit made in
+ * the middle of a period takes effect at slot 0 of the next one, the
+ * period it is made in is played to its end with the old duty cycles.
+ *
+ * \b Example (from Embedded_Targets):
+ * @code
+ * gcc -O2 -DDIO_SIM -Iatmega328p -Ihost_sim atmega328p/dio*.c \
+ *     host_sim/dio_sim.c host_sim/dio_test_pwm.c -o dio_test_pwm
+ * ./dio_test_pwm
+ * @endcode
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio.h" /* For the port interface */
+#include "dio_pwm.h" /* For the interface under test */
+#include "dio_test.h" /* For the checks */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the number of duty cycles under test.
+*/
+#define DIO_TEST_DUTIES 4U
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The duty cycles under test: the edges of the range and their
+* neighbours, a pulse of one tick and a gap of one tick.
+*/
+static const uint16_t DioTest_Duties[DIO_TEST_DUTIES] =
+{
+  0U, 1U, DIO_PWM_PERIOD - 1U, DIO_PWM_PERIOD
+};
+/**
+* The PWM channel table and the level of the other channels of each port.
+*/
+static const DioChannel_t * DioTest_Channels;
+static DioPortValue_t DioTest_Other[DIO_NUMBER_OF_PORTS];
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : DioTest_PwmLevel()
+*//**
+* \b Description:
+* Returns the level a channel of duty cycle Duty has at a slot of the
+* period: HIGH for the first Duty slots with pulse width modulation,
+* HIGH in the frames of the set duty bits with bit angle modulation,
+* where the frame of bit n starts at slot 2^n - 1.
+**********************************************************************/
+static DioState_t
+DioTest_PwmLevel(uint16_t Duty, uint16_t Slot)
+{
+#if DIO_PWM_BAM == STD_ON
+  uint8_t Bit = 0;
+
+  while ((uint32_t)Slot + 1U >= (2UL << Bit))
+    {
+      Bit++;
+    }
+  return ((Duty >> Bit) & 1U) ? DIO_STATE_HIGH : DIO_STATE_LOW;
+#else
+  return (Slot < Duty) ? DIO_STATE_HIGH : DIO_STATE_LOW;
+#endif
+}
+
+/**********************************************************************
+* Function : DioTest_PwmPeriod()
+*//**
+* \b Description:
+* Ticks a whole period and checks the level of each PWM channel after
+* the tick of every slot, against Duty[Index], the time each channel is
+* HIGH, and the other channels of the ports. When Next is not NULL, its
+* duty cycles are committed in the middle of the period.
+**********************************************************************/
+static void
+DioTest_PwmPeriod(const uint16_t * const Duty, const uint16_t * const Next)
+{
+  uint16_t High[DIO_PWM_CHANNELS] = { 0 };
+
+  for (uint16_t Slot = 0; Slot < DIO_PWM_PERIOD; Slot++)
+    {
+      if(Next != NULL && Slot == DIO_PWM_PERIOD / 2U)
+        {
+          for (uint8_t Index = 0; Index < DIO_PWM_CHANNELS; Index++)
+            {
+              Dio_PwmDutySet(Index, Next[Index]);
+            }
+          Dio_PwmCommit();
+        }
+      Dio_PwmTick();
+      for (uint8_t Index = 0; Index < DIO_PWM_CHANNELS; Index++)
+        {
+          const DioState_t Level = Dio_ChannelRead(DioTest_Channels[Index]);
+
+          DIO_TEST_CHECK(Level == DioTest_PwmLevel(Duty[Index], Slot));
+          High[Index] += (Level == DIO_STATE_HIGH);
+        }
+    }
+
+  for (uint8_t Index = 0; Index < DIO_PWM_CHANNELS; Index++)
+    {
+      DIO_TEST_CHECK(High[Index] == Duty[Index]);
+    }
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      DioPortValue_t Mask = 0;
+
+      for (uint8_t Index = 0; Index < DIO_PWM_CHANNELS; Index++)
+        {
+          if(DIO_CHANNEL_PORT(DioTest_Channels[Index]) == Port)
+            {
+              Mask |= DIO_CHANNEL_MASK(DioTest_Channels[Index]);
+            }
+        }
+      DIO_TEST_CHECK((Dio_PortRead((DioPort_t)Port) & (DioPortValue_t)~Mask)
+                     == (DioTest_Other[Port] & (DioPortValue_t)~Mask));
+    }
+}
+
+static void
+DioTest_PwmSetup(void)
+{
+  DioSim_Reset();
+  Dio_Init(Dio_ConfigGet());
+  DioTest_Channels = Dio_PwmConfigGet();
+  Dio_PwmInit(DioTest_Channels);
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      DioTest_Other[Port] = Dio_PortRead((DioPort_t)Port);
+    }
+}
+
+static void
+DioTest_PwmDuties(void)
+{
+  const uint16_t Zero[DIO_PWM_CHANNELS] = { 0 };
+  uint16_t Duty[DIO_PWM_CHANNELS];
+
+  DioTest_PwmSetup();
+  DioTest_PwmPeriod(Zero, NULL);
+
+  // Each channel takes each duty cycle, with different ones beside it
+  for (uint8_t Shift = 0; Shift < DIO_TEST_DUTIES; Shift++)
+    {
+      for (uint8_t Index = 0; Index < DIO_PWM_CHANNELS; Index++)
+        {
+          Duty[Index] = DioTest_Duties[(Shift + Index) % DIO_TEST_DUTIES];
+          Dio_PwmDutySet(Index, Duty[Index]);
+        }
+      Dio_PwmCommit();
+      DioTest_PwmPeriod(Duty, NULL);
+      DioTest_PwmPeriod(Duty, NULL);
+    }
+
+  // A duty cycle over the period is limited to it
+  Dio_PwmDutySet(0, (uint16_t)(DIO_PWM_PERIOD + 1U));
+  Dio_PwmCommit();
+  Duty[0] = DIO_PWM_PERIOD;
+  DioTest_PwmPeriod(Duty, NULL);
+}
+
+static void
+DioTest_PwmCommit(void)
+{
+  uint16_t Old[DIO_PWM_CHANNELS];
+  uint16_t New[DIO_PWM_CHANNELS];
+
+  DioTest_PwmSetup();
+  for (uint8_t Index = 0; Index < DIO_PWM_CHANNELS; Index++)
+    {
+      Old[Index] = DioTest_Duties[(Index + 1U) % DIO_TEST_DUTIES];
+      New[Index] = DioTest_Duties[(Index + 3U) % DIO_TEST_DUTIES];
+      Dio_PwmDutySet(Index, Old[Index]);
+    }
+  Dio_PwmCommit();
+  DioTest_PwmPeriod(Old, NULL);
+
+  // Committed in the middle of a period, the new duty cycles wait for
+  // slot 0: the rest of the period is played with the old ones
+  DioTest_PwmPeriod(Old, New);
+  DioTest_PwmPeriod(New, NULL);
+
+  // A second commit before slot 0 replaces the first one
+  DioTest_PwmPeriod(New, Old);
+  for (uint8_t Index = 0; Index < DIO_PWM_CHANNELS; Index++)
+    {
+      Dio_PwmDutySet(Index, New[Index]);
+    }
+  Dio_PwmCommit();
+  DioTest_PwmPeriod(New, NULL);
+}
+
+int
+main(void)
+{
+  DioTest_PwmDuties();
+  DioTest_PwmCommit();
+  return DIO_TEST_RESULT();
+}
+/*************** END OF FILE ********************************/
@@ -0,0 +1,207 @@
+/**
+ * @file dio_test_set.c
+ * @author Mohamed Hassanin
+ * @brief The host test of the dio channel sets: a set of non contiguous
+ * channels spread over three ports and a set whose ports map to the
+ * packed value by a shift are compiled, and every packed value is
+ * written and read back. The level of each channel is checked, with the
+ * other channels of the ports left alone, and so are the plan of each
+ * set and the single write and read of each port it touches.
+ *
+ * \b Example (from Embedded_Targets):
+ * @code
+ * gcc -O2 -DDIO_SIM -Iatmega328p -Ihost_sim atmega328p/dio*.c \
+ *     host_sim/dio_sim.c host_sim/dio_test_set.c -o dio_test_set
+ * ./dio_test_set
+ * @endcode
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio.h" /* For the port interface */
+#include "dio_set.h" /* For the interface under test */
+#include "dio_memmap.h" /* For the register addresses */
+#include "dio_test.h" /* For the checks */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the channels of the sets under test.
+*/
+#define DIO_TEST_SCATTERED 6U
+#define DIO_TEST_SHIFTED 5U
+/**
+* Defines the level of the channels outside the sets.
+*/
+#define DIO_TEST_OTHER ((DioPortValue_t)0xA5)
+/**
+* Defines the writes the trace can hold, for a set write.
+*/
+#define DIO_TEST_TRACE 32U
+/**********************************************************************
+* Preprocessor Macros
+**********************************************************************/
+/**
+* The channel of bit Bit of port Port.
+*/
+#define DIO_TEST_CHANNEL(Port, Bit) \
+  ((DioChannel_t)((Port) * DIO_CHANNELS_PER_PORT + (Bit)))
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* A set out of port order, with gaps, over the first and the last port
+* and the one after the first: no port maps to the packed value by a
+* shift.
+*/
+static const DioChannel_t DioTest_Scattered[DIO_TEST_SCATTERED] =
+{
+  DIO_TEST_CHANNEL(0U, 5U),
+  DIO_TEST_CHANNEL(DIO_NUMBER_OF_PORTS - 1U, 0U),
+  DIO_TEST_CHANNEL(0U, 1U),
+  DIO_TEST_CHANNEL(1U, 7U),
+  DIO_TEST_CHANNEL(DIO_NUMBER_OF_PORTS - 1U, 6U),
+  DIO_TEST_CHANNEL(1U, 2U),
+};
+/**
+* A set of two runs of channels: the first port of the set sits 4 bits
+* above the packed value, the second one 2 bits below it.
+*/
+static const DioChannel_t DioTest_Shifted[DIO_TEST_SHIFTED] =
+{
+  DIO_TEST_CHANNEL(1U, 4U),
+  DIO_TEST_CHANNEL(1U, 5U),
+  DIO_TEST_CHANNEL(1U, 6U),
+  DIO_TEST_CHANNEL(0U, 1U),
+  DIO_TEST_CHANNEL(0U, 2U),
+};
+/**
+* The write trace of the test in progress.
+*/
+static DioSimWrite_t DioTest_Trace[DIO_TEST_TRACE];
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+static void
+DioTest_SetSetup(void)
+{
+  DioSim_Reset();
+  Dio_Init(Dio_ConfigGet());
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      Dio_SetPortDirection((DioPort_t)Port, (DioPortValue_t)~(DioPortValue_t)0);
+      Dio_PortWrite((DioPort_t)Port, DIO_TEST_OTHER);
+    }
+}
+
+/**********************************************************************
+* Function : DioTest_SetRoundTrip()
+*//**
+* \b Description:
+* Writes every packed value of a set and checks the level of each of
+* its Count channels, the other channels of the ports, one write of the
+* data output register per touched port, and the value read back with
+* one read per touched port.
+**********************************************************************/
+static void
+DioTest_SetRoundTrip(const DioChannelSet_t * const Set,
+                     const DioChannel_t * const Channels, uint8_t Count)
+{
+  DioPortValue_t Mask[DIO_NUMBER_OF_PORTS] = { 0 };
+
+  for (uint8_t Bit = 0; Bit < Count; Bit++)
+    {
+      Mask[DIO_CHANNEL_PORT(Channels[Bit])] |= DIO_CHANNEL_MASK(Channels[Bit]);
+    }
+
+  for (uint32_t Bits = 0; Bits < (1UL << Count); Bits++)
+    {
+      DioSimCounters_t Counters;
+      uint32_t Writes;
+
+      DioSim_TraceStart(DioTest_Trace, DIO_TEST_TRACE);
+      Dio_ChannelSetWrite(Set, Bits);
+      Writes = DioSim_TraceStop();
+
+      for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+        {
+          const uint16_t Address = DIO_TEST_ADDRESS(DIO_PORT_ADDRESS(Port));
+          uint32_t PortWrites = 0;
+
+          for (uint32_t i = 0; i < Writes; i++)
+            {
+              PortWrites += (DioTest_Trace[i].Address == Address);
+            }
+          DIO_TEST_CHECK(PortWrites == ((Mask[Port] != 0) ? 1U : 0U));
+          DIO_TEST_CHECK((Dio_PortRead((DioPort_t)Port) & (DioPortValue_t)~Mask[Port])
+                         == (DIO_TEST_OTHER & (DioPortValue_t)~Mask[Port]));
+        }
+      for (uint8_t Bit = 0; Bit < Count; Bit++)
+        {
+          DIO_TEST_CHECK(Dio_ChannelRead(Channels[Bit])
+                         == (((Bits >> Bit) & 1UL) ? DIO_STATE_HIGH : DIO_STATE_LOW));
+        }
+
+      DioSim_CountersReset();
+      DIO_TEST_CHECK(Dio_ChannelSetRead(Set) == Bits);
+      DioSim_CountersGet(&Counters);
+      DIO_TEST_CHECK(Counters.Reads == Set->PortCount);
+    }
+}
+
+static void
+DioTest_SetScattered(void)
+{
+  DioChannelSet_t Set;
+
+  DioTest_SetSetup();
+  Dio_ChannelSetCompile(&Set, DioTest_Scattered, DIO_TEST_SCATTERED);
+
+  // The ports in port order, each with its channels and no shift
+  DIO_TEST_CHECK(Set.PortCount == 3U);
+  for (uint8_t i = 0; i < Set.PortCount; i++)
+    {
+      DIO_TEST_CHECK(Set.Ports[i].Linear == 0);
+      if(i > 0U)
+        {
+          DIO_TEST_CHECK(Set.Ports[i].Port > Set.Ports[i - 1U].Port);
+        }
+    }
+  DIO_TEST_CHECK(Set.Ports[0].Mask == (DioPortValue_t)((1U << 5) | (1U << 1)));
+
+  DioTest_SetRoundTrip(&Set, DioTest_Scattered, DIO_TEST_SCATTERED);
+}
+
+static void
+DioTest_SetShifted(void)
+{
+  DioChannelSet_t Set;
+
+  DioTest_SetSetup();
+  Dio_ChannelSetCompile(&Set, DioTest_Shifted, DIO_TEST_SHIFTED);
+
+  // Both ports take the shift path, one shifted each way
+  DIO_TEST_CHECK(Set.PortCount == 2U);
+  DIO_TEST_CHECK(Set.Ports[0].Port == (DioPort_t)0);
+  DIO_TEST_CHECK(Set.Ports[0].Linear == 1);
+  DIO_TEST_CHECK(Set.Ports[0].Shift == -2);
+  DIO_TEST_CHECK(Set.Ports[0].Mask == (DioPortValue_t)0x06);
+  DIO_TEST_CHECK(Set.Ports[1].Port == (DioPort_t)1);
+  DIO_TEST_CHECK(Set.Ports[1].Linear == 1);
+  DIO_TEST_CHECK(Set.Ports[1].Shift == 4);
+  DIO_TEST_CHECK(Set.Ports[1].Mask == (DioPortValue_t)0x70);
+
+  DioTest_SetRoundTrip(&Set, DioTest_Shifted, DIO_TEST_SHIFTED);
+}
+
+int
+main(void)
+{
+  DioTest_SetScattered();
+  DioTest_SetShifted();
+  return DIO_TEST_RESULT();
+}
+/*************** END OF FILE ********************************/
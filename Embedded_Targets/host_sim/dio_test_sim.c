@@ -0,0 +1,738 @@
+/**
+ * @file dio_test_sim.c
+ * @author Mohamed Hassanin
+ * @brief The host test of the core dio driver on the simulated register
+ * file: the channel and port accesses, the register semantics of the
+ * target (PINx toggle, set/clear/toggle registers), the external drive
+ * of the inputs, the access counters, the write trace, the vectors, the
+ * order of the writes of a profile switch, the channel groups, the
+ * pull-ups of Dio_Init, the initialization from the packed configuration
+ * and, with DIO_INSTRUMENT, the counters of Dio_StatsGet.
+ * It builds for every target and every build mode of the driver.
+ *
+ * \b Example (from Embedded_Targets):
+ * @code
+ * gcc -O2 -DDIO_SIM -Iatmega328p -Ihost_sim atmega328p/dio*.c \
+ *     host_sim/dio_sim.c host_sim/dio_test_sim.c -o dio_test_sim
+ * ./dio_test_sim
+ * @endcode
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio.h" /* For the interface under test */
+#include "dio_ext.h" /* For the toggle */
+#include "dio_memmap.h" /* For the register addresses */
+#include "dio_test.h" /* For the checks */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the register accesses of a Dio_ChannelWrite: one store to a set
+* or clear register, or a read-modify-write of PORTx, with the read and
+* the write of SREG when it is atomic.
+*/
+#ifdef DIO_SET_ADDRESS
+#define DIO_TEST_WRITE_READS 0U
+#define DIO_TEST_WRITE_WRITES 1U
+#elif DIO_ATOMIC == STD_ON
+#define DIO_TEST_WRITE_READS 2U
+#define DIO_TEST_WRITE_WRITES 2U
+#else
+#define DIO_TEST_WRITE_READS 1U
+#define DIO_TEST_WRITE_WRITES 1U
+#endif
+/**
+* Defines the register accesses of a Dio_ChannelToggle: one store to a
+* toggle register, else an atomic read-modify-write of PORTx.
+*/
+#if DIO_PIN_WRITE_TOGGLE || defined(DIO_TOGGLE_ADDRESS)
+#define DIO_TEST_TOGGLE_READS 0U
+#define DIO_TEST_TOGGLE_WRITES 1U
+#else
+#define DIO_TEST_TOGGLE_READS 2U
+#define DIO_TEST_TOGGLE_WRITES 2U
+#endif
+/**
+* Defines the writes the trace of a profile can hold: the direction, the
+* data and the direction again, and SREG, for each port.
+*/
+#define DIO_TEST_PROFILE_TRACE (4U * DIO_NUMBER_OF_PORTS)
+/**
+* Defines the writes the trace of a group write can hold: the set and
+* the clear register, or PORTx, and SREG twice.
+*/
+#define DIO_TEST_GROUP_TRACE 4U
+/**
+* Defines the writes the trace of Dio_Init and Dio_InitPorts holds: the
+* data and the direction of each port.
+*/
+#define DIO_TEST_INIT_TRACE (2U * DIO_NUMBER_OF_PORTS)
+/**
+* Defines the register accesses counted by the instrumentation for a
+* Dio_ChannelWrite: SREG is not a port register and is not counted.
+*/
+#ifdef DIO_SET_ADDRESS
+#define DIO_TEST_STATS_WRITE_READS 0U
+#else
+#define DIO_TEST_STATS_WRITE_READS 1U
+#endif
+/**
+* Defines the vector raised by the vector test.
+*/
+#define DIO_TEST_VECTOR 1U
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The port under test, the last port of the target, and a channel in
+* the middle of it.
+*/
+static const DioPort_t DioTest_Port = (DioPort_t)(DIO_PORT_MAX - 1U);
+static const DioChannel_t DioTest_Channel =
+  (DioChannel_t)((DIO_PORT_MAX - 1U) * DIO_CHANNELS_PER_PORT + 3U);
+static const DioPortValue_t DioTest_Mask = (DioPortValue_t)(1U << 3);
+/**
+* The number of runs of the vector handler.
+*/
+static uint32_t DioTest_VectorRuns;
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+static void
+DioTest_Setup(void)
+{
+  DioSim_Reset();
+  Dio_Init(Dio_ConfigGet());
+  Dio_SetPortDirection(DioTest_Port, (DioPortValue_t)~(DioPortValue_t)0);
+  Dio_PortWrite(DioTest_Port, 0);
+}
+
+static void
+DioTest_ChannelWrite(void)
+{
+  DioTest_Setup();
+  Dio_ChannelWrite(DioTest_Channel, DIO_STATE_HIGH);
+  DIO_TEST_CHECK(Dio_ChannelRead(DioTest_Channel) == DIO_STATE_HIGH);
+  DIO_TEST_CHECK(DioSim_PortLevel(DioTest_Port) == DioTest_Mask);
+  Dio_ChannelWrite(DioTest_Channel, DIO_STATE_LOW);
+  DIO_TEST_CHECK(Dio_ChannelRead(DioTest_Channel) == DIO_STATE_LOW);
+  DIO_TEST_CHECK(DioSim_PortLevel(DioTest_Port) == 0);
+}
+
+static void
+DioTest_PortWrite(void)
+{
+  DioTest_Setup();
+  Dio_PortWrite(DioTest_Port, 0xA0);
+  Dio_PortWriteMasked(DioTest_Port, 0x0F, 0xF5);
+  DIO_TEST_CHECK(Dio_PortRead(DioTest_Port) == 0xA5);
+  Dio_PortWriteMaskedIsr(DioTest_Port, 0xF0, 0x30);
+  DIO_TEST_CHECK(Dio_PortRead(DioTest_Port) == 0x35);
+}
+
+static void
+DioTest_Inputs(void)
+{
+  DioTest_Setup();
+  Dio_SetChannelDirection(DioTest_Channel, DIO_DIR_INPUT);
+  DioSim_InputDrive(DioTest_Port, DioTest_Mask, DioTest_Mask);
+  DIO_TEST_CHECK(Dio_ChannelRead(DioTest_Channel) == DIO_STATE_HIGH);
+  DioSim_InputDrive(DioTest_Port, DioTest_Mask, 0);
+  DIO_TEST_CHECK(Dio_ChannelRead(DioTest_Channel) == DIO_STATE_LOW);
+
+  // Released, the input reads its pull-up: the PORTx bit
+  DioSim_InputRelease(DioTest_Port, DioTest_Mask);
+  DIO_TEST_CHECK(Dio_ChannelRead(DioTest_Channel) == DIO_STATE_LOW);
+  Dio_ChannelWrite(DioTest_Channel, DIO_STATE_HIGH);
+  DIO_TEST_CHECK(Dio_ChannelRead(DioTest_Channel) == DIO_STATE_HIGH);
+
+  // An output reads its own level, whatever drives the pin
+  DioSim_InputDrive(DioTest_Port, DioTest_Mask, 0);
+  Dio_SetChannelDirection(DioTest_Channel, DIO_DIR_OUTPUT);
+  DIO_TEST_CHECK(Dio_ChannelRead(DioTest_Channel) == DIO_STATE_HIGH);
+}
+
+static void
+DioTest_Registers(void)
+{
+  volatile DioPortValue_t * const Port = DIO_PORT_ADDRESS(DioTest_Port);
+
+  DioTest_Setup();
+  DioSim_RegWrite(DIO_PIN_ADDRESS(DioTest_Port), 0x0F);
+#if DIO_PIN_WRITE_TOGGLE
+  DIO_TEST_CHECK(DioSim_RegRead(Port) == 0x0F);
+  DioSim_RegWrite(DIO_PIN_ADDRESS(DioTest_Port), 0x05);
+  DIO_TEST_CHECK(DioSim_RegRead(Port) == 0x0A);
+#else
+  DIO_TEST_CHECK(DioSim_RegRead(Port) == 0);
+#endif
+
+#ifdef DIO_SET_ADDRESS
+  DioSim_RegWrite(Port, 0);
+  DioSim_RegWrite(DIO_SET_ADDRESS(DioTest_Port), 0x81);
+  DIO_TEST_CHECK(DioSim_RegRead(Port) == 0x81);
+  DioSim_RegWrite(DIO_CLEAR_ADDRESS(DioTest_Port), 0x01);
+  DIO_TEST_CHECK(DioSim_RegRead(Port) == 0x80);
+  DIO_TEST_CHECK(DioSim_RegRead(DIO_SET_ADDRESS(DioTest_Port)) == 0);
+  DIO_TEST_CHECK(DioSim_RegRead(DIO_CLEAR_ADDRESS(DioTest_Port)) == 0);
+#endif
+#ifdef DIO_TOGGLE_ADDRESS
+  DioSim_RegWrite(DIO_TOGGLE_ADDRESS(DioTest_Port), 0x81);
+  DIO_TEST_CHECK(DioSim_RegRead(Port) == 0x01);
+  DIO_TEST_CHECK(DioSim_RegRead(DIO_TOGGLE_ADDRESS(DioTest_Port)) == 0);
+#endif
+  DIO_TEST_CHECK(DioSim_PortLevel(DioTest_Port) == DioSim_RegRead(Port));
+}
+
+static void
+DioTest_Counters(void)
+{
+  DioSimCounters_t Counters;
+
+  DioTest_Setup();
+  DioSim_CountersReset();
+  (void)Dio_PortRead(DioTest_Port);
+  DioSim_CountersGet(&Counters);
+  DIO_TEST_CHECK(Counters.Reads == 1 && Counters.Writes == 0);
+
+  DioSim_CountersReset();
+  Dio_PortWrite(DioTest_Port, 0x55);
+  DioSim_CountersGet(&Counters);
+  DIO_TEST_CHECK(Counters.Reads == 0 && Counters.Writes == 1);
+
+  DioSim_CountersReset();
+  Dio_ChannelWrite(DioTest_Channel, DIO_STATE_HIGH);
+  DioSim_CountersGet(&Counters);
+  DIO_TEST_CHECK(Counters.Reads == DIO_TEST_WRITE_READS);
+  DIO_TEST_CHECK(Counters.Writes == DIO_TEST_WRITE_WRITES);
+
+#if DIO_TOGGLE == STD_ON
+  DioSim_CountersReset();
+  Dio_ChannelToggle(DioTest_Channel);
+  DioSim_CountersGet(&Counters);
+  DIO_TEST_CHECK(Counters.Reads == DIO_TEST_TOGGLE_READS);
+  DIO_TEST_CHECK(Counters.Writes == DIO_TEST_TOGGLE_WRITES);
+  DIO_TEST_CHECK(Dio_ChannelRead(DioTest_Channel) == DIO_STATE_LOW);
+  Dio_PortToggle(DioTest_Port, 0x11);
+  DIO_TEST_CHECK(Dio_PortRead(DioTest_Port) == 0x44);
+#endif
+}
+
+static void
+DioTest_Trace(void)
+{
+  DioSimWrite_t Trace[4] = { { 0 } };
+  uint32_t Count;
+
+  DioTest_Setup();
+  DioSim_TraceStart(Trace, 4);
+  Dio_PortWrite(DioTest_Port, 0x12);
+  DioSim_Delay(100);
+  Dio_PortWrite(DioTest_Port, 0x34);
+  Count = DioSim_TraceStop();
+
+  DIO_TEST_CHECK(Count == 2);
+  DIO_TEST_CHECK(Trace[0].Address == DIO_TEST_ADDRESS(DIO_PORT_ADDRESS(DioTest_Port)));
+  DIO_TEST_CHECK(Trace[1].Address == Trace[0].Address);
+  DIO_TEST_CHECK(Trace[0].Value == 0x12 && Trace[1].Value == 0x34);
+  DIO_TEST_CHECK(Trace[1].Cycle - Trace[0].Cycle == 100U + 1U);
+
+  // Stopped, the trace records nothing
+  Dio_PortWrite(DioTest_Port, 0x56);
+  DIO_TEST_CHECK(Trace[2].Value == 0 && Trace[2].Cycle == 0);
+}
+
+static void
+DioTest_VectorHandler(void)
+{
+  DioTest_VectorRuns++;
+}
+
+static void
+DioTest_Vectors(void)
+{
+  DioTest_Setup();
+  DioTest_VectorRuns = 0;
+  DioSim_VectorSet(DIO_TEST_VECTOR, DioTest_VectorHandler);
+
+  // Pending while the interrupts are disabled, run once enabled
+  DioSim_InterruptsDisable();
+  DioSim_VectorRaise(DIO_TEST_VECTOR);
+  DIO_TEST_CHECK(DioTest_VectorRuns == 0);
+  DioSim_InterruptsEnable();
+  DIO_TEST_CHECK(DioTest_VectorRuns == 1);
+  DioSim_VectorRaise(DIO_TEST_VECTOR);
+  DIO_TEST_CHECK(DioTest_VectorRuns == 2);
+  DioSim_InterruptsDisable();
+  DioSim_VectorSet(DIO_TEST_VECTOR, NULL);
+}
+
+/**********************************************************************
+* Function : DioTest_ProfileApply()
+*//**
+* \b Description:
+* Applies a profile and replays its write trace on a model of the port
+* registers: a pin driven by the old profile changes level only when it
+* stays an OUTPUT, any other is released to INPUT first, and an INPUT
+* becomes an OUTPUT only once its data is the new one. Then the registers
+* must be those of the profile. Returns the writes, SREG aside.
+**********************************************************************/
+static uint32_t
+DioTest_ProfileApply(DioProfileId_t Id)
+{
+  const DioPortConfig_t * const Profile = Dio_ProfileConfigGet(Id);
+  const uint16_t Sreg = DIO_TEST_ADDRESS((volatile DioPortValue_t *)SREG);
+  DioSimWrite_t Trace[DIO_TEST_PROFILE_TRACE];
+  DioPortValue_t Direction[DIO_NUMBER_OF_PORTS];
+  DioPortValue_t Data[DIO_NUMBER_OF_PORTS];
+  uint32_t Writes = 0;
+  uint32_t Count;
+
+  for (uint32_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      Direction[Port] = DioSim_RegRead(DIO_DDR_ADDRESS(Port));
+      Data[Port] = DioSim_RegRead(DIO_PORT_ADDRESS(Port));
+    }
+
+  DioSim_TraceStart(Trace, DIO_TEST_PROFILE_TRACE);
+  Dio_ApplyProfile(Id);
+  Count = DioSim_TraceStop();
+  DIO_TEST_CHECK(Count <= DIO_TEST_PROFILE_TRACE);
+
+  for (uint32_t i = 0; i < Count && i < DIO_TEST_PROFILE_TRACE; i++)
+    {
+      const DioPortValue_t Value = Trace[i].Value;
+      uint32_t Port = 0;
+
+      if(Trace[i].Address == Sreg)
+        {
+          continue;
+        }
+      while (Port < DIO_NUMBER_OF_PORTS
+             && Trace[i].Address != DIO_TEST_ADDRESS(DIO_DDR_ADDRESS(Port))
+             && Trace[i].Address != DIO_TEST_ADDRESS(DIO_PORT_ADDRESS(Port)))
+        {
+          Port++;
+        }
+      DIO_TEST_CHECK(Port < DIO_NUMBER_OF_PORTS);
+      if(Port == DIO_NUMBER_OF_PORTS)
+        {
+          continue;
+        }
+      Writes++;
+
+      const DioPortValue_t Final = Profile[Port].Data | Profile[Port].Pullup;
+
+      if(Trace[i].Address == DIO_TEST_ADDRESS(DIO_DDR_ADDRESS(Port)))
+        {
+          const DioPortValue_t Enabled = Value & (DioPortValue_t)~Direction[Port];
+
+          // Only the outputs of the profile, each at its new level
+          DIO_TEST_CHECK((Enabled & (DioPortValue_t)~Profile[Port].Direction) == 0);
+          DIO_TEST_CHECK(((Data[Port] ^ Final) & Enabled) == 0);
+          Direction[Port] = Value;
+        }
+      else
+        {
+          // The data is written once, to its new value, and a driven pin
+          // that changes level stays driven
+          DIO_TEST_CHECK(Value == Final);
+          DIO_TEST_CHECK(((Value ^ Data[Port]) & Direction[Port]
+                          & (DioPortValue_t)~Profile[Port].Direction) == 0);
+          Data[Port] = Value;
+        }
+    }
+
+  for (uint32_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      DIO_TEST_CHECK(DioSim_RegRead(DIO_DDR_ADDRESS(Port)) == Profile[Port].Direction);
+      DIO_TEST_CHECK(DioSim_RegRead(DIO_PORT_ADDRESS(Port))
+                     == (DioPortValue_t)(Profile[Port].Data | Profile[Port].Pullup));
+      DIO_TEST_CHECK(Direction[Port] == Profile[Port].Direction);
+    }
+  return Writes;
+}
+
+static void
+DioTest_Profiles(void)
+{
+  DioSim_Reset();
+  Dio_Init(Dio_ConfigGet());
+
+  // ACTIVE is the configuration of Dio_Init: nothing to write
+  DIO_TEST_CHECK(DioTest_ProfileApply(DIO_PROFILE_ACTIVE) == 0);
+  DIO_TEST_CHECK(DioTest_ProfileApply(DIO_PROFILE_SLEEP) != 0);
+  DIO_TEST_CHECK(DioTest_ProfileApply(DIO_PROFILE_SAFE) != 0);
+  DIO_TEST_CHECK(DioTest_ProfileApply(DIO_PROFILE_SAFE) == 0);
+  DIO_TEST_CHECK(DioTest_ProfileApply(DIO_PROFILE_ACTIVE) != 0);
+}
+
+/**********************************************************************
+* Function : DioTest_GroupWrite()
+*//**
+* \b Description:
+* Writes Value to a group and replays the write trace on its port: the
+* writes go to the data output register of the port, or to its set and
+* clear registers with the channels of the group only. Then the group
+* reads back Value, within its width, and the other channels of the port
+* have kept their level.
+**********************************************************************/
+static void
+DioTest_GroupWrite(const DioGroup_t * const Group, DioPortValue_t Value)
+{
+  const uint16_t Sreg = DIO_TEST_ADDRESS((volatile DioPortValue_t *)SREG);
+  const uint16_t Out = DIO_TEST_ADDRESS(DIO_PORT_ADDRESS(Group->Port));
+  const DioPortValue_t Before = DioSim_RegRead(DIO_PORT_ADDRESS(Group->Port));
+  const DioPortValue_t Expected = (DioPortValue_t)((Before & (DioPortValue_t)~Group->Mask)
+                                  | ((DioPortValue_t)(Value << Group->Shift) & Group->Mask));
+  DioSimWrite_t Trace[DIO_TEST_GROUP_TRACE];
+  DioPortValue_t Model = Before;
+  uint32_t Writes = 0;
+  uint32_t Count;
+
+  DioSim_TraceStart(Trace, DIO_TEST_GROUP_TRACE);
+  Dio_GroupWrite(Group, Value);
+  Count = DioSim_TraceStop();
+  DIO_TEST_CHECK(Count <= DIO_TEST_GROUP_TRACE);
+
+  for (uint32_t i = 0; i < Count && i < DIO_TEST_GROUP_TRACE; i++)
+    {
+      if(Trace[i].Address == Sreg)
+        {
+          continue;
+        }
+      Writes++;
+#ifdef DIO_SET_ADDRESS
+      if(Trace[i].Address == DIO_TEST_ADDRESS(DIO_SET_ADDRESS(Group->Port)))
+        {
+          DIO_TEST_CHECK((Trace[i].Value & (DioPortValue_t)~Group->Mask) == 0);
+          Model |= Trace[i].Value;
+          continue;
+        }
+      if(Trace[i].Address == DIO_TEST_ADDRESS(DIO_CLEAR_ADDRESS(Group->Port)))
+        {
+          DIO_TEST_CHECK((Trace[i].Value & (DioPortValue_t)~Group->Mask) == 0);
+          Model &= (DioPortValue_t)~Trace[i].Value;
+          continue;
+        }
+#endif
+      DIO_TEST_CHECK(Trace[i].Address == Out);
+      Model = Trace[i].Value;
+    }
+
+  // One store per register, each skipped when it has nothing to do
+#ifdef DIO_SET_ADDRESS
+  DIO_TEST_CHECK(Writes >= 1U && Writes <= 2U);
+#else
+  DIO_TEST_CHECK(Writes == 1U);
+#endif
+  DIO_TEST_CHECK(Model == Expected);
+  DIO_TEST_CHECK(DioSim_RegRead(DIO_PORT_ADDRESS(Group->Port)) == Expected);
+  DIO_TEST_CHECK(Dio_GroupRead(Group) == (DioPortValue_t)(Value & (Group->Mask >> Group->Shift)));
+}
+
+/**********************************************************************
+* Function : DioTest_GroupValues()
+*//**
+* \b Description:
+* Writes a group with all its channels LOW, all HIGH, alternating, each
+* channel alone, and with bits beyond its width, over a port whose other
+* channels are set, then cleared.
+**********************************************************************/
+static void
+DioTest_GroupValues(const DioGroup_t * const Group)
+{
+  const DioPortValue_t All = (DioPortValue_t)(Group->Mask >> Group->Shift);
+
+  DioSim_Reset();
+  Dio_Init(Dio_ConfigGet());
+  Dio_SetPortDirection(Group->Port, (DioPortValue_t)~(DioPortValue_t)0);
+  for (uint8_t Other = 0; Other < 2U; Other++)
+    {
+      Dio_PortWrite(Group->Port, (Other != 0) ? (DioPortValue_t)~Group->Mask : 0);
+      DioTest_GroupWrite(Group, 0);
+      DioTest_GroupWrite(Group, All);
+      DioTest_GroupWrite(Group, (DioPortValue_t)(All & (DioPortValue_t)0x55555555UL));
+      DioTest_GroupWrite(Group, (DioPortValue_t)(All & (DioPortValue_t)0xAAAAAAAAUL));
+      for (DioPortValue_t Bit = 1U; Bit != 0 && Bit <= All; Bit = (DioPortValue_t)(Bit << 1))
+        {
+          DioTest_GroupWrite(Group, Bit);
+        }
+      DioTest_GroupWrite(Group, (DioPortValue_t)~(DioPortValue_t)0);
+      DioTest_GroupWrite(Group, (DioPortValue_t)~All);
+    }
+}
+
+static void
+DioTest_Groups(void)
+{
+  // DIO_GROUP: 3 channels from bit 2 of the port under test
+  const DioGroup_t Group = DIO_GROUP(DioTest_Channel - 1U, 3U);
+
+  DIO_TEST_CHECK(Group.Port == DioTest_Port);
+  DIO_TEST_CHECK(Group.Mask == (DioPortValue_t)0x1C);
+  DIO_TEST_CHECK(Group.Shift == 2U);
+  DioTest_GroupValues(&Group);
+
+  // The group table of the target
+  for (uint8_t Id = 0; Id < DIO_GROUP_MAX; Id++)
+    {
+      DioTest_GroupValues(&Dio_GroupConfigGet()[Id]);
+    }
+}
+
+static void
+DioTest_Pullups(void)
+{
+  const DioConfig_t * const Config = Dio_ConfigGet();
+  DioSimWrite_t Trace[DIO_TEST_INIT_TRACE];
+  DioPortValue_t Pullup[DIO_NUMBER_OF_PORTS] = { 0 };
+  uint32_t Count;
+
+  DioSim_Reset();
+  DioSim_TraceStart(Trace, DIO_TEST_INIT_TRACE);
+  Dio_Init(Config);
+  Count = DioSim_TraceStop();
+
+  // A pulled-up input has its PORTx bit set and its DDRx bit clear, and
+  // reads HIGH while nothing drives it
+  for (uint16_t i = 0; i < DIO_CHANNEL_MAX; i++)
+    {
+      const DioPort_t Port = DIO_CHANNEL_PORT(Config[i].Channel);
+      const DioPortValue_t Mask = DIO_CHANNEL_MASK(Config[i].Channel);
+      const DioPortValue_t Direction = DioSim_RegRead(DIO_DDR_ADDRESS(Port)) & Mask;
+      const DioPortValue_t Data = DioSim_RegRead(DIO_PORT_ADDRESS(Port)) & Mask;
+
+      if(Config[i].Direction == DIO_DIR_OUTPUT)
+        {
+          DIO_TEST_CHECK(Direction == Mask);
+          DIO_TEST_CHECK(Data == ((Config[i].Data == DIO_STATE_HIGH) ? Mask : 0));
+        }
+      else if(Config[i].Pullup == DIO_PULLUP_ENABLED)
+        {
+          DIO_TEST_CHECK(Direction == 0 && Data == Mask);
+          DIO_TEST_CHECK(Dio_ChannelRead(Config[i].Channel) == DIO_STATE_HIGH);
+          Pullup[Port] |= Mask;
+        }
+      else
+        {
+          DIO_TEST_CHECK(Direction == 0 && Data == 0);
+        }
+    }
+
+  // PORTx is written before DDRx, the pull-ups with the first write, and
+  // no write makes a pulled-up input an output
+  DIO_TEST_CHECK(Count <= DIO_TEST_INIT_TRACE);
+  for (uint32_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      uint8_t DataWritten = 0;
+
+      for (uint32_t i = 0; i < Count && i < DIO_TEST_INIT_TRACE; i++)
+        {
+          if(Trace[i].Address == DIO_TEST_ADDRESS(DIO_PORT_ADDRESS(Port)))
+            {
+              DIO_TEST_CHECK((Trace[i].Value & Pullup[Port]) == Pullup[Port]);
+              DataWritten = 1;
+            }
+          else if(Trace[i].Address == DIO_TEST_ADDRESS(DIO_DDR_ADDRESS(Port)))
+            {
+              DIO_TEST_CHECK(DataWritten == 1);
+              DIO_TEST_CHECK((Trace[i].Value & Pullup[Port]) == 0);
+            }
+        }
+    }
+}
+
+static void
+DioTest_InitPorts(void)
+{
+  DioPortValue_t Direction[DIO_NUMBER_OF_PORTS];
+  DioPortValue_t Data[DIO_NUMBER_OF_PORTS];
+  DioSimWrite_t Trace[DIO_TEST_INIT_TRACE];
+  DioSimCounters_t Counters;
+  uint32_t Count;
+
+  DioSim_Reset();
+  Dio_Init(Dio_ConfigGet());
+  for (uint32_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      Direction[Port] = DioSim_RegRead(DIO_DDR_ADDRESS(Port));
+      Data[Port] = DioSim_RegRead(DIO_PORT_ADDRESS(Port));
+    }
+
+  // From registers left in any state, each port is written whole,
+  // without a read: the data first, then the direction
+  DioSim_Reset();
+  for (uint32_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      DioSim_RegWrite(DIO_DDR_ADDRESS(Port), (DioPortValue_t)~Direction[Port]);
+      DioSim_RegWrite(DIO_PORT_ADDRESS(Port), (DioPortValue_t)~Data[Port]);
+    }
+  DioSim_CountersReset();
+  DioSim_TraceStart(Trace, DIO_TEST_INIT_TRACE);
+  Dio_InitPorts(Dio_PortConfigGet());
+  Count = DioSim_TraceStop();
+  DioSim_CountersGet(&Counters);
+
+  DIO_TEST_CHECK(Counters.Reads == 0);
+  DIO_TEST_CHECK(Count == DIO_TEST_INIT_TRACE);
+  for (uint32_t Port = 0; Port < DIO_NUMBER_OF_PORTS && 2U * Port + 1U < Count; Port++)
+    {
+      DIO_TEST_CHECK(Trace[2U * Port].Address == DIO_TEST_ADDRESS(DIO_PORT_ADDRESS(Port)));
+      DIO_TEST_CHECK(Trace[2U * Port + 1U].Address == DIO_TEST_ADDRESS(DIO_DDR_ADDRESS(Port)));
+    }
+
+  // The same registers as Dio_Init
+  for (uint32_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      DIO_TEST_CHECK(DioSim_RegRead(DIO_DDR_ADDRESS(Port)) == Direction[Port]);
+      DIO_TEST_CHECK(DioSim_RegRead(DIO_PORT_ADDRESS(Port)) == Data[Port]);
+    }
+}
+
+#if DIO_INSTRUMENT == STD_ON
+/**********************************************************************
+* Function : DioTest_StatsZero()
+*//**
+* \b Description:
+* Checks that all the instrumentation counters are zero but the calls
+* of Api, Calls, and their Reads and Writes.
+**********************************************************************/
+static void
+DioTest_StatsZero(DioApi_t Api, uint32_t Calls, uint32_t Reads, uint32_t Writes)
+{
+  DioStats_t Stats;
+
+  Dio_StatsGet(&Stats);
+  for (uint8_t i = 0; i < DIO_API_MAX; i++)
+    {
+      DIO_TEST_CHECK(Stats.ApiCalls[i] == ((i == Api) ? Calls : 0U));
+      DIO_TEST_CHECK(Stats.ApiAccess[i].Reads == ((i == Api) ? Reads : 0U));
+      DIO_TEST_CHECK(Stats.ApiAccess[i].Writes == ((i == Api) ? Writes : 0U));
+    }
+  for (uint8_t Port = 0; Port <= DIO_NUMBER_OF_PORTS; Port++)
+    {
+      DIO_TEST_CHECK(Stats.PortAccess[Port].Reads == ((Port == DioTest_Port) ? Reads : 0U));
+      DIO_TEST_CHECK(Stats.PortAccess[Port].Writes == ((Port == DioTest_Port) ? Writes : 0U));
+    }
+  for (uint16_t Channel = 0; Channel < DIO_CHANNEL_MAX; Channel++)
+    {
+      DIO_TEST_CHECK(Stats.ChannelCalls[Channel] == 0);
+    }
+}
+
+static void
+DioTest_Stats(void)
+{
+  volatile DioPortValue_t * const Outside =
+    (volatile DioPortValue_t *)DIO_UPPER_BOUND_ADDRESS + 1;
+  DioStats_t Stats;
+
+  DioTest_Setup();
+  Dio_StatsReset();
+  DioTest_StatsZero(DIO_API_MAX, 0, 0, 0);
+
+  // A known sequence: 3 channel writes, 2 channel reads, a direction,
+  // a port write, 2 port reads, and the register interface on a port
+  // register, the first port and a register outside the ports
+  Dio_ChannelWrite(DioTest_Channel, DIO_STATE_HIGH);
+  Dio_ChannelWrite(DioTest_Channel, DIO_STATE_LOW);
+  Dio_ChannelWrite(DioTest_Channel, DIO_STATE_HIGH);
+  (void)Dio_ChannelRead(DioTest_Channel);
+  (void)Dio_ChannelRead(DioTest_Channel);
+  Dio_SetChannelDirection(DioTest_Channel, DIO_DIR_OUTPUT);
+  Dio_PortWrite(DioTest_Port, 0x55);
+  (void)Dio_PortRead(DioTest_Port);
+  (void)Dio_PortRead(DioTest_Port);
+  Dio_RegisterWrite(DIO_PORT_ADDRESS(DioTest_Port), 0x0F);
+  (void)Dio_RegisterRead(DIO_DDR_ADDRESS(0U));
+  Dio_RegisterWrite(Outside, 0);
+
+  Dio_StatsGet(&Stats);
+  DIO_TEST_CHECK(Stats.ApiCalls[DIO_API_CHANNEL_WRITE] == 3U);
+  DIO_TEST_CHECK(Stats.ApiAccess[DIO_API_CHANNEL_WRITE].Reads == 3U * DIO_TEST_STATS_WRITE_READS);
+  DIO_TEST_CHECK(Stats.ApiAccess[DIO_API_CHANNEL_WRITE].Writes == 3U);
+  DIO_TEST_CHECK(Stats.ApiCalls[DIO_API_CHANNEL_READ] == 2U);
+  DIO_TEST_CHECK(Stats.ApiAccess[DIO_API_CHANNEL_READ].Reads == 2U);
+  DIO_TEST_CHECK(Stats.ApiAccess[DIO_API_CHANNEL_READ].Writes == 0);
+  DIO_TEST_CHECK(Stats.ApiCalls[DIO_API_SET_CHANNEL_DIRECTION] == 1U);
+  DIO_TEST_CHECK(Stats.ApiAccess[DIO_API_SET_CHANNEL_DIRECTION].Reads == 1U);
+  DIO_TEST_CHECK(Stats.ApiAccess[DIO_API_SET_CHANNEL_DIRECTION].Writes == 1U);
+  DIO_TEST_CHECK(Stats.ApiCalls[DIO_API_PORT_WRITE] == 1U);
+  DIO_TEST_CHECK(Stats.ApiAccess[DIO_API_PORT_WRITE].Reads == 0);
+  DIO_TEST_CHECK(Stats.ApiAccess[DIO_API_PORT_WRITE].Writes == 1U);
+  DIO_TEST_CHECK(Stats.ApiCalls[DIO_API_PORT_READ] == 2U);
+  DIO_TEST_CHECK(Stats.ApiAccess[DIO_API_PORT_READ].Reads == 2U);
+  DIO_TEST_CHECK(Stats.ApiCalls[DIO_API_REGISTER_WRITE] == 2U);
+  DIO_TEST_CHECK(Stats.ApiAccess[DIO_API_REGISTER_WRITE].Writes == 2U);
+  DIO_TEST_CHECK(Stats.ApiCalls[DIO_API_REGISTER_READ] == 1U);
+  DIO_TEST_CHECK(Stats.ApiAccess[DIO_API_REGISTER_READ].Reads == 1U);
+  DIO_TEST_CHECK(Stats.ApiCalls[DIO_API_INIT] == 0);
+
+  // Dio_StatsPortOf: each access is counted for its port, the register
+  // outside the ports for the last entry
+  DIO_TEST_CHECK(Stats.PortAccess[DioTest_Port].Reads
+                 == 3U * DIO_TEST_STATS_WRITE_READS + 2U + 1U + 2U);
+  DIO_TEST_CHECK(Stats.PortAccess[DioTest_Port].Writes == 3U + 1U + 1U + 1U);
+  DIO_TEST_CHECK(Stats.PortAccess[0].Reads == 1U);
+  DIO_TEST_CHECK(Stats.PortAccess[0].Writes == 0);
+  DIO_TEST_CHECK(Stats.PortAccess[DIO_NUMBER_OF_PORTS].Reads == 0);
+  DIO_TEST_CHECK(Stats.PortAccess[DIO_NUMBER_OF_PORTS].Writes == 1U);
+  for (uint16_t Channel = 0; Channel < DIO_CHANNEL_MAX; Channel++)
+    {
+      DIO_TEST_CHECK(Stats.ChannelCalls[Channel] == ((Channel == DioTest_Channel) ? 6U : 0U));
+    }
+
+  // Zero after a reset, then counted from there
+  Dio_StatsReset();
+  DioTest_StatsZero(DIO_API_MAX, 0, 0, 0);
+  (void)Dio_PortRead(DioTest_Port);
+  DioTest_StatsZero(DIO_API_PORT_READ, 1U, 1U, 0);
+}
+#endif
+
+#if DIO_SHADOW == STD_ON
+static void
+DioTest_Batch(void)
+{
+  DioTest_Setup();
+  Dio_BeginBatch();
+  Dio_ChannelWrite(DioTest_Channel, DIO_STATE_HIGH);
+  Dio_PortWriteMasked(DioTest_Port, 0x03, 0x03);
+  DIO_TEST_CHECK(Dio_PortRead(DioTest_Port) == 0);
+
+  // The interrupt path is not deferred
+  Dio_PortWriteMaskedIsr(DioTest_Port, 0x80, 0x80);
+  DIO_TEST_CHECK(Dio_PortRead(DioTest_Port) == 0x80);
+  Dio_Commit();
+  DIO_TEST_CHECK(Dio_PortRead(DioTest_Port) == 0x8B);
+}
+#endif
+
+int
+main(void)
+{
+  DioTest_ChannelWrite();
+  DioTest_PortWrite();
+  DioTest_Inputs();
+  DioTest_Registers();
+  DioTest_Counters();
+  DioTest_Trace();
+  DioTest_Vectors();
+  DioTest_Profiles();
+  DioTest_Groups();
+  DioTest_Pullups();
+  DioTest_InitPorts();
+#if DIO_SHADOW == STD_ON
+  DioTest_Batch();
+#endif
+#if DIO_INSTRUMENT == STD_ON
+  DioTest_Stats();
+#endif
+  return DIO_TEST_RESULT();
+}
+/*************** END OF FILE ********************************/
@@ -0,0 +1,371 @@
+/** 
+ * @file dio_cfg.c
+ * @author Mohamed Hassanin
+ * @brief This module contains the implementation for the digital
+ * input/output peripheral configuration
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include "dio_cfg.h" /**< For this modules definitions */
+/*********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The following list contains the configuration data for each
+* digital input/output peripheral channel (pin). Each row represents a 
+* single pin: X(Port, Channel, Direction, Data, Pullup). The list is expanded
+* into the two formats of the configuration below, so they always agree.
+* DIO_CONFIG_PORT gives the 32 rows of a port in one line.
+*/
+#define DIO_CONFIG_TABLE(X, Port) \
+  DIO_CONFIG_PORT(X, Port, 0, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 1, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 2, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 3, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 4, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 5, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 6, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 7, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 8, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 9, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 10, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 11, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 12, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 13, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 14, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 15, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 16, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 17, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 18, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 19, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 20, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 21, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 22, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 23, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 24, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 25, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 26, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 27, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 28, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 29, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 30, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED) \
+  DIO_CONFIG_PORT(X, Port, 31, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED)
+
+/**
+* The rows of the 32 channels of port n, all in the same configuration.
+*/
+#define DIO_CONFIG_PORT(X, Port, n, Direction, Data, Pullup) \
+  X(Port, PORT##n##_0, Direction, Data, Pullup) \
+  X(Port, PORT##n##_1, Direction, Data, Pullup) \
+  X(Port, PORT##n##_2, Direction, Data, Pullup) \
+  X(Port, PORT##n##_3, Direction, Data, Pullup) \
+  X(Port, PORT##n##_4, Direction, Data, Pullup) \
+  X(Port, PORT##n##_5, Direction, Data, Pullup) \
+  X(Port, PORT##n##_6, Direction, Data, Pullup) \
+  X(Port, PORT##n##_7, Direction, Data, Pullup) \
+  X(Port, PORT##n##_8, Direction, Data, Pullup) \
+  X(Port, PORT##n##_9, Direction, Data, Pullup) \
+  X(Port, PORT##n##_10, Direction, Data, Pullup) \
+  X(Port, PORT##n##_11, Direction, Data, Pullup) \
+  X(Port, PORT##n##_12, Direction, Data, Pullup) \
+  X(Port, PORT##n##_13, Direction, Data, Pullup) \
+  X(Port, PORT##n##_14, Direction, Data, Pullup) \
+  X(Port, PORT##n##_15, Direction, Data, Pullup) \
+  X(Port, PORT##n##_16, Direction, Data, Pullup) \
+  X(Port, PORT##n##_17, Direction, Data, Pullup) \
+  X(Port, PORT##n##_18, Direction, Data, Pullup) \
+  X(Port, PORT##n##_19, Direction, Data, Pullup) \
+  X(Port, PORT##n##_20, Direction, Data, Pullup) \
+  X(Port, PORT##n##_21, Direction, Data, Pullup) \
+  X(Port, PORT##n##_22, Direction, Data, Pullup) \
+  X(Port, PORT##n##_23, Direction, Data, Pullup) \
+  X(Port, PORT##n##_24, Direction, Data, Pullup) \
+  X(Port, PORT##n##_25, Direction, Data, Pullup) \
+  X(Port, PORT##n##_26, Direction, Data, Pullup) \
+  X(Port, PORT##n##_27, Direction, Data, Pullup) \
+  X(Port, PORT##n##_28, Direction, Data, Pullup) \
+  X(Port, PORT##n##_29, Direction, Data, Pullup) \
+  X(Port, PORT##n##_30, Direction, Data, Pullup) \
+  X(Port, PORT##n##_31, Direction, Data, Pullup)
+
+/**
+* The following array contains the configuration data for each
+* digital input/output peripheral channel (pin). Each row represents a 
+* single pin. Each column is representing a member of the DioConfig_t
+* structure. This table is read in by Dio_Init, where each channel is then
+* set up based on this table.
+*/
+static const DioConfig_t DioConfig[] =
+{
+  DIO_CONFIG_TABLE(DIO_CONFIG_ROW, 0)
+};
+
+/**
+* The following array contains the packed configuration, one row per port
+* indexed by DioPort_t, folded from the same list at build time. It is
+* read in by Dio_InitPorts, which writes each port register once. Its 3
+* masks per port replace the DioConfig_t row of each channel.
+*/
+static const DioPortConfig_t DioPortConfig[DIO_NUMBER_OF_PORTS] =
+{
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT0),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT1),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT2),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT3),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT4),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT5),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT6),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT7),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT8),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT9),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT10),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT11),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT12),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT13),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT14),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT15),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT16),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT17),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT18),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT19),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT20),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT21),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT22),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT23),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT24),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT25),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT26),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT27),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT28),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT29),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT30),
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT31),
+};
+
+/**
+* The following array contains the pin configuration profiles, indexed by
+* DioProfileId_t, each one packed as one row per port (DioPortConfig_t).
+* A profile is built from a DIO_CONFIG_TABLE list with DIO_PORT_CONFIG, or
+* written directly as masks. Dio_ApplyProfile switches to a profile by
+* writing only the port registers that differ from it.
+*/
+static const DioPortConfig_t DioProfiles[DIO_PROFILE_MAX][DIO_NUMBER_OF_PORTS] =
+{
+  [DIO_PROFILE_ACTIVE] =
+  {
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT0),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT1),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT2),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT3),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT4),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT5),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT6),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT7),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT8),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT9),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT10),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT11),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT12),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT13),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT14),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT15),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT16),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT17),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT18),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT19),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT20),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT21),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT22),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT23),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT24),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT25),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT26),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT27),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT28),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT29),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT30),
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORT31),
+  },
+  [DIO_PROFILE_SLEEP] =
+  {
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+    { 0x00000000, 0x00000000, 0xFFFFFFFF },
+  },
+  [DIO_PROFILE_SAFE] =
+  {
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000 },
+  },
+};
+
+/**
+* The following array contains the channel groups, indexed by DioGroupId_t.
+* Each group is a set of contiguous channels of one port that is written
+* and read as a single value by Dio_GroupWrite and Dio_GroupRead.
+*/
+static const DioGroup_t DioGroups[DIO_GROUP_MAX] =
+{
+  [DIO_GROUP_BUS_DATA] = DIO_GROUP(PORT1_0, 16U),
+};
+
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : Dio_ConfigGet()
+*//**
+* \b Description:
+* This function is used to get the cofiguration handle of the Dio <br>
+* POST-CONDITION: A constant pointer to the first member of the
+* configuration table will be returned. <br>
+* @return A pointer to the configuration table.
+*
+* \b Example Example:
+* @code
+* const Dio_ConfigType *DioConfig = Dio_GetConfig();
+* Dio_Init(DioConfig);
+* @endcode
+* @see Dio_Init
+**********************************************************************/
+const DioConfig_t * 
+Dio_ConfigGet(void)
+{
+  /*
+  * The cast is performed to ensure that the address of the first element
+  * of configuration table is returned as a constant pointer and NOT a
+  * pointer that can be modified.
+  */
+  return (const DioConfig_t *)DioConfig;
+}
+
+/**********************************************************************
+* Function : Dio_PortConfigGet()
+*//**
+* \b Description:
+* This function is used to get the packed configuration of the Dio <br>
+* POST-CONDITION: A constant pointer to the first member of the
+* packed configuration will be returned. <br>
+* @return A pointer to the packed configuration of DIO_NUMBER_OF_PORTS
+* rows.
+*
+* \b Example:
+* @code
+* Dio_InitPorts(Dio_PortConfigGet());
+* @endcode
+* @see Dio_InitPorts
+**********************************************************************/
+const DioPortConfig_t *
+Dio_PortConfigGet(void)
+{
+  return DioPortConfig;
+}
+
+/**********************************************************************
+* Function : Dio_ProfileConfigGet()
+*//**
+* \b Description:
+* This function is used to get a pin configuration profile of the Dio <br>
+* PRE-CONDITION: Id < DIO_PROFILE_MAX <br>
+* POST-CONDITION: A constant pointer to the first port of the profile
+* will be returned. <br>
+* @param Id is the profile
+* @return A pointer to the DIO_NUMBER_OF_PORTS rows of the profile.
+*
+* \b Example:
+* @code
+* Dio_InitPorts(Dio_ProfileConfigGet(DIO_PROFILE_SAFE));
+* @endcode
+* @see Dio_ApplyProfile
+**********************************************************************/
+const DioPortConfig_t *
+Dio_ProfileConfigGet(DioProfileId_t Id)
+{
+  return DioProfiles[Id];
+}
+
+/**********************************************************************
+* Function : Dio_GroupConfigGet()
+*//**
+* \b Description:
+* This function is used to get the channel group table of the Dio <br>
+* POST-CONDITION: A constant pointer to the first member of the
+* group table will be returned. <br>
+* @return A pointer to the group table, indexed by DioGroupId_t.
+*
+* \b Example:
+* @code
+* const DioGroup_t *Groups = Dio_GroupConfigGet();
+* Dio_GroupWrite(&Groups[DIO_GROUP_BUS_DATA], 0xBEEF);
+* @endcode
+* @see Dio_GroupWrite
+**********************************************************************/
+const DioGroup_t *
+Dio_GroupConfigGet(void)
+{
+  return DioGroups;
+}
+
+/************************ END OF FILE ********************************/
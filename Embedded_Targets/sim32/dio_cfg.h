@@ -0,0 +1,419 @@
+/** 
+ * @file dio_cfg.h
+ * @author Mohamed Hassanin
+ * @brief This module contains interface definitions for the
+ * Dio configuration. This is the header file for the definition of the
+ * interface for retrieving the digital input/output configuration table.
+ * @version 0.1
+ * @date 2021-01-12
+*/
+#ifndef DIO_CFG_H_
+#define DIO_CFG_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the number of pins on each processor port.
+*/
+#define DIO_CHANNELS_PER_PORT 32U
+/**
+* Defines the number of ports on the processor.
+*/
+#define DIO_NUMBER_OF_PORTS 32U
+/**
+ * The feature is supported
+ */
+#define STD_ON 1
+/**
+ * The feature is not supported
+ */
+#define STD_OFF 0
+/**
+* Enables the instrumentation counters of the dio module (calls and
+* register accesses per API entry point and per port, calls per channel).
+* With STD_OFF the instrumentation compiles to nothing.
+*/
+#ifndef DIO_INSTRUMENT
+#define DIO_INSTRUMENT STD_OFF
+#endif
+/**
+* Enables the shadow registers of the dio module: between Dio_BeginBatch
+* and Dio_Commit the output and direction writes only update a RAM mirror
+* of the ports, and the commit writes each changed register once. With
+* STD_OFF the batch API is not built and every write goes to the port.
+* It is off by default, a batch defers the writes of every caller: see
+* Dio_BeginBatch for the writes that may run while a batch is open.
+*/
+#ifndef DIO_SHADOW
+#define DIO_SHADOW STD_OFF
+#endif
+/**
+* Makes the read-modify-write functions of the dio module atomic against
+* ISRs writing the same port: the channel, masked port, group, direction
+* and commit writes, and the reads and writes of each port of
+* Dio_ApplyProfile, run in a critical section. With STD_OFF only the
+* *Atomic functions are protected. Dio_PortWrite and Dio_SetPortDirection
+* are a single write and are always atomic.
+*/
+#ifndef DIO_ATOMIC
+#define DIO_ATOMIC STD_OFF
+#endif
+/**
+* Makes dio.h define Dio_ChannelRead, Dio_ChannelWrite and
+* Dio_SetChannelDirection as static inline functions (dio_inline.h), so
+* that a call with a constant channel folds to the register access. It
+* needs DIO_SHADOW and DIO_INSTRUMENT set to STD_OFF.
+*/
+#ifndef DIO_INLINE
+#define DIO_INLINE STD_OFF
+#endif
+/**
+* The register models of a port. DIO_BACKEND_RMW: a data output register
+* that is updated by read-modify-write (AVR). DIO_BACKEND_SET_CLEAR: the
+* data output register has write-only set and clear registers, a one
+* written to a bit sets or clears that channel only, atomically in
+* hardware, so an output write is a store without a read.
+*/
+#define DIO_BACKEND_RMW 0
+#define DIO_BACKEND_SET_CLEAR 1
+/**
+* Selects the register model of the ports of the target.
+*/
+#define DIO_BACKEND DIO_BACKEND_SET_CLEAR
+/**********************************************************************
+* Preprocessor Macros
+**********************************************************************/
+/**
+* Expands X(Channel) for the 32 channels of port n, PORTn_0 to PORTn_31.
+*/
+#define DIO_PORT_CHANNELS(X, n) \
+  X(PORT##n##_0) \
+  X(PORT##n##_1) \
+  X(PORT##n##_2) \
+  X(PORT##n##_3) \
+  X(PORT##n##_4) \
+  X(PORT##n##_5) \
+  X(PORT##n##_6) \
+  X(PORT##n##_7) \
+  X(PORT##n##_8) \
+  X(PORT##n##_9) \
+  X(PORT##n##_10) \
+  X(PORT##n##_11) \
+  X(PORT##n##_12) \
+  X(PORT##n##_13) \
+  X(PORT##n##_14) \
+  X(PORT##n##_15) \
+  X(PORT##n##_16) \
+  X(PORT##n##_17) \
+  X(PORT##n##_18) \
+  X(PORT##n##_19) \
+  X(PORT##n##_20) \
+  X(PORT##n##_21) \
+  X(PORT##n##_22) \
+  X(PORT##n##_23) \
+  X(PORT##n##_24) \
+  X(PORT##n##_25) \
+  X(PORT##n##_26) \
+  X(PORT##n##_27) \
+  X(PORT##n##_28) \
+  X(PORT##n##_29) \
+  X(PORT##n##_30) \
+  X(PORT##n##_31)
+/**
+* The enumerator of a channel in DioChannel_t.
+*/
+#define DIO_CHANNEL_ENUM(Channel) Channel,
+/**
+* The port of a channel and the mask of the channel in its port registers.
+*/
+#define DIO_CHANNEL_PORT(Channel) \
+  ((DioPort_t)((Channel) / DIO_CHANNELS_PER_PORT))
+#define DIO_CHANNEL_MASK(Channel) \
+  ((DioPortValue_t)((DioPortValue_t)1U << ((Channel) % DIO_CHANNELS_PER_PORT)))
+/**
+* Initializer of a DioGroup_t of Width contiguous channels starting at the
+* channel First. The group must not cross a port boundary.
+*/
+#define DIO_GROUP(First, Width) \
+  { DIO_CHANNEL_PORT(First), \
+    (DioPortValue_t)((DioPortValue_t)((DioPortValue_t)~(DioPortValue_t)0U \
+                                      >> (8U * sizeof(DioPortValue_t) - (Width))) \
+                     << ((First) % DIO_CHANNELS_PER_PORT)), \
+    (uint8_t)((First) % DIO_CHANNELS_PER_PORT) }
+/**
+* Terms of the masks of one port, one term per row of a DIO_CONFIG_TABLE:
+* the OUTPUT channels, the OUTPUT channels driven HIGH, and the INPUT
+* channels with their pull-up enabled.
+* The terms are constant, so the masks are folded by the compiler.
+*/
+#define DIO_CONFIG_DIRECTION(Port, Channel, Direction, Data, Pullup) \
+  | ((DIO_CHANNEL_PORT(Channel) == (Port) && (Direction) == DIO_DIR_OUTPUT) \
+     ? DIO_CHANNEL_MASK(Channel) : 0U)
+#define DIO_CONFIG_DATA(Port, Channel, Direction, Data, Pullup) \
+  | ((DIO_CHANNEL_PORT(Channel) == (Port) && (Direction) == DIO_DIR_OUTPUT \
+      && (Data) == DIO_STATE_HIGH) ? DIO_CHANNEL_MASK(Channel) : 0U)
+#define DIO_CONFIG_PULLUP(Port, Channel, Direction, Data, Pullup) \
+  | ((DIO_CHANNEL_PORT(Channel) == (Port) && (Direction) == DIO_DIR_INPUT \
+      && (Pullup) == DIO_PULLUP_ENABLED) ? DIO_CHANNEL_MASK(Channel) : 0U)
+/**
+* Initializer of the DioConfig_t row of a DIO_CONFIG_TABLE row.
+*/
+#define DIO_CONFIG_ROW(Port, Channel, Direction, Data, Pullup) \
+  { (Channel), (Direction), (Data), (Pullup) },
+/**
+* Initializer of the DioPortConfig_t of Port from the rows of Table, a
+* DIO_CONFIG_TABLE(X, Port) list of X(Port, Channel, Direction, Data, Pullup).
+*/
+#define DIO_PORT_CONFIG(Table, Port) \
+  { (DioPortValue_t)(0U Table(DIO_CONFIG_DIRECTION, Port)), \
+    (DioPortValue_t)(0U Table(DIO_CONFIG_DATA, Port)), \
+    (DioPortValue_t)(0U Table(DIO_CONFIG_PULLUP, Port)) }
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+* Defines the possible states for a digital output pin.
+*/
+typedef enum
+{
+	DIO_STATE_LOW, /**< Defines digital state ground */
+	DIO_STATE_HIGH, /**< Defines digital state power */
+	DIO_STATE_MAX /**< the maximum number of states */
+}DioState_t;
+
+/**
+ * Defines the possible directions of the pin
+ */
+typedef enum 
+{
+	DIO_DIR_INPUT, 
+	DIO_DIR_OUTPUT
+}DioDirection_t;
+
+/**
+ * Defines the possible states of the pull-up resistor of an INPUT pin
+ */
+typedef enum
+{
+	DIO_PULLUP_DISABLED, /**< The input floats */
+	DIO_PULLUP_ENABLED, /**< The input is pulled HIGH */
+	DIO_PULLUP_MAX /**< the maximum number of pull-up states */
+}DioPullup_t;
+
+/**
+* Defines an enumerated list of all the channels (pins) on the MCU
+* device, PORTn_b is channel b of port n. The last element is used to
+* specify the maximum number of enumerated labels.
+*/
+typedef enum
+{
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 0)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 1)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 2)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 3)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 4)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 5)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 6)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 7)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 8)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 9)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 10)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 11)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 12)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 13)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 14)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 15)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 16)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 17)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 18)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 19)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 20)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 21)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 22)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 23)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 24)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 25)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 26)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 27)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 28)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 29)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 30)
+	DIO_PORT_CHANNELS(DIO_CHANNEL_ENUM, 31)
+	DIO_CHANNEL_MAX
+}DioChannel_t;
+
+/**
+* Defines an enumerated list of all the ports on the MCU device, in the
+* same order as the port register tables of the dio module. The last
+* element is used to specify the maximum number of enumerated labels.
+*/
+typedef enum
+{
+	DIO_PORT0,
+	DIO_PORT1,
+	DIO_PORT2,
+	DIO_PORT3,
+	DIO_PORT4,
+	DIO_PORT5,
+	DIO_PORT6,
+	DIO_PORT7,
+	DIO_PORT8,
+	DIO_PORT9,
+	DIO_PORT10,
+	DIO_PORT11,
+	DIO_PORT12,
+	DIO_PORT13,
+	DIO_PORT14,
+	DIO_PORT15,
+	DIO_PORT16,
+	DIO_PORT17,
+	DIO_PORT18,
+	DIO_PORT19,
+	DIO_PORT20,
+	DIO_PORT21,
+	DIO_PORT22,
+	DIO_PORT23,
+	DIO_PORT24,
+	DIO_PORT25,
+	DIO_PORT26,
+	DIO_PORT27,
+	DIO_PORT28,
+	DIO_PORT29,
+	DIO_PORT30,
+	DIO_PORT31,
+	DIO_PORT_MAX
+}DioPort_t;
+
+/**
+* Defines the width of a port register. Bit n of a value holds the
+* state of channel n of the port.
+*/
+typedef uint32_t DioPortValue_t;
+
+/**
+* Defines the digital input/output configuration table’s elements that are used
+* by Dio_Init to configure the Dio peripheral.
+*/
+typedef struct
+{
+	DioChannel_t Channel; /**< The I/O pin */
+	DioDirection_t Direction; /**< OUTPUT or INPUT */
+	DioState_t Data; /**< HIGH or LOW, for an OUTPUT */
+	DioPullup_t Pullup; /**< ENABLED or DISABLED, for an INPUT */
+}DioConfig_t;
+
+/**
+* Defines the packed configuration of one port, read in by Dio_InitPorts.
+* It sets every channel of the port: 3 masks per port instead of one
+* DioConfig_t row per channel.
+*/
+typedef struct
+{
+	DioPortValue_t Direction; /**< The OUTPUT channels, bit n for channel n */
+	DioPortValue_t Data; /**< The OUTPUT channels driven HIGH */
+	DioPortValue_t Pullup; /**< The INPUT channels with their pull-up enabled */
+}DioPortConfig_t;
+
+/**
+* Defines an enumerated list of the pin configuration profiles of the
+* profile table, applied by Dio_ApplyProfile. The last element is used to
+* specify the maximum number of enumerated labels.
+*/
+typedef enum
+{
+	DIO_PROFILE_ACTIVE, /**< Normal operation, the configuration of Dio_Init */
+	DIO_PROFILE_SLEEP, /**< Low power: all channels INPUT with their pull-up */
+	DIO_PROFILE_SAFE, /**< Fault: all channels INPUT, floating (reset state) */
+	DIO_PROFILE_MAX
+}DioProfileId_t;
+
+/**
+* Defines a group of contiguous channels of one port (a bit-field), it is
+* written and read with a single access to the port registers.
+*/
+typedef struct
+{
+	DioPort_t Port; /**< The port of the channels */
+	DioPortValue_t Mask; /**< The channels of the group in the port */
+	uint8_t Shift; /**< The position of the first channel in the port */
+}DioGroup_t;
+
+/**
+* Defines an enumerated list of the channel groups of the group table.
+* The last element is used to specify the maximum number of enumerated
+* labels.
+*/
+typedef enum
+{
+	DIO_GROUP_BUS_DATA, /**< 16-bit parallel data bus */
+	DIO_GROUP_MAX
+}DioGroupId_t;
+
+#if DIO_INSTRUMENT == STD_ON
+/**
+* Defines the API entry points counted by the instrumentation.
+*/
+typedef enum
+{
+	DIO_API_INIT,
+	DIO_API_INIT_PORTS,
+	DIO_API_APPLY_PROFILE,
+	DIO_API_CHANNEL_READ,
+	DIO_API_CHANNEL_WRITE,
+	DIO_API_SET_CHANNEL_DIRECTION,
+	DIO_API_PORT_READ,
+	DIO_API_PORT_WRITE,
+	DIO_API_PORT_WRITE_MASKED,
+	DIO_API_SET_PORT_DIRECTION,
+	DIO_API_SET_PORT_DIRECTION_MASKED,
+	DIO_API_REGISTER_READ,
+	DIO_API_REGISTER_WRITE,
+	DIO_API_GROUP_READ,
+	DIO_API_GROUP_WRITE,
+	DIO_API_COMMIT,
+	DIO_API_MAX
+}DioApi_t;
+
+/**
+* Defines the register access counters.
+*/
+typedef struct
+{
+	uint32_t Reads; /**< Number of register reads */
+	uint32_t Writes; /**< Number of register writes */
+}DioAccess_t;
+
+/**
+* Defines the instrumentation counters returned by Dio_StatsGet.
+*/
+typedef struct
+{
+	uint32_t ApiCalls[DIO_API_MAX]; /**< Calls of each entry point */
+	DioAccess_t ApiAccess[DIO_API_MAX]; /**< Register accesses of each entry point */
+	DioAccess_t PortAccess[DIO_NUMBER_OF_PORTS + 1U]; /**< Register accesses of each port, the last entry is for registers outside the ports */
+	uint32_t ChannelCalls[DIO_CHANNEL_MAX]; /**< Calls made for each channel */
+}DioStats_t;
+#endif
+
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+const DioConfig_t* Dio_ConfigGet(void);
+const DioPortConfig_t* Dio_PortConfigGet(void);
+const DioPortConfig_t* Dio_ProfileConfigGet(DioProfileId_t Id);
+const DioGroup_t* Dio_GroupConfigGet(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* DIO_CFG_H_*/
+/************************* END OF FILE ********************************/
@@ -0,0 +1,113 @@
+/**
+ * @file dio_ext.c
+ * @author Mohamed Hassanin
+ * @brief An extension for the dio module for specific features in MCUs.
+ * @version 0.1
+ * @date 2021-03-07
+ */
+
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_ext.h" /* For this modules definitions */
+#include "dio_memmap.h" /* For Hardware definitions */
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+#if DIO_TOGGLE == STD_ON
+/**
+* Defines a table of pointers to the Port Data Toggle Register. Writing a
+* one to a bit toggles the bit of the output register.
+*/
+static volatile uint32_t* const Dio_PortsToggle[DIO_NUMBER_OF_PORTS] =
+{
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT0),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT1),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT2),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT3),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT4),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT5),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT6),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT7),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT8),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT9),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT10),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT11),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT12),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT13),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT14),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT15),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT16),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT17),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT18),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT19),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT20),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT21),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT22),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT23),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT24),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT25),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT26),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT27),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT28),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT29),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT30),
+  (volatile uint32_t*)DIO_TOGGLE_ADDRESS(DIO_PORT31)
+};
+#endif
+
+/**********************************************************************
+* Functions Definitions
+**********************************************************************/
+#if DIO_TOGGLE == STD_ON
+/**************************************************************************
+* Function : Dio_ChannelToggle()
+*//**
+* \b Description:
+* This function is used to toggle the current state of a channel (pin). <br>
+* Writing a one to a TGLx bit toggles the PORTx bit in hardware, so the<br>
+* toggle is a single store with no read-modify-write, atomic like the<br>
+* set/clear writes of the DIO_BACKEND_SET_CLEAR ports.<br>
+* PRE-CONDITION: The channel is configured as OUTPUT <br>
+* PRE-CONDITION: The channel is within the maximum DioChannel_t definition<br>
+* @param Channel is the pin from the DioChannel_t that is
+* to be modified.
+* \b Example:
+* @code
+* Dio_ChannelToggle(PORT1_20);
+* @endcode
+* @see Dio_PortToggle
+* @return void
+**********************************************************************/
+void 
+Dio_ChannelToggle(DioChannel_t Channel)
+{
+  DIO_REG_WRITE(Dio_PortsToggle[DIO_CHANNEL_PORT(Channel)],
+                DIO_CHANNEL_MASK(Channel));
+}
+
+/**************************************************************************
+* Function : Dio_PortToggle()
+*//**
+* \b Description:
+* This function is used to toggle the current state of the channels of a<br>
+* port selected by Mask, with a single store to its TGLx register.<br>
+* PRE-CONDITION: The masked channels are configured as OUTPUT <br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition<br>
+* @param Port is the port from the DioPort_t that is to be modified.
+* @param Mask selects the channels to toggle, bit n for channel n
+* \b Example:
+* @code
+* Dio_PortToggle(DIO_PORT1, 0x00100001); // Toggle PORT1_0 and PORT1_20
+* @endcode
+* @see Dio_ChannelToggle
+* @return void
+**********************************************************************/
+void 
+Dio_PortToggle(DioPort_t Port, DioPortValue_t Mask)
+{
+  DIO_REG_WRITE(Dio_PortsToggle[Port], Mask);
+}
+#endif
+/*************** END OF FUNCTIONS ********************************/
@@ -0,0 +1,47 @@
+#ifndef DIO_MEMMAP_H
+#define DIO_MEMMAP_H
+
+/*
+ * A simulated MCU with 32 ports of 32 bits (1024 channels), a model of a
+ * soft GPIO block; it only exists on the host. Each port has a block of 8
+ * word registers: PINx (input), DDRx (direction), PORTx (data output) and
+ * the write-only SETx, CLRx and TGLx registers, a one written to a bit of
+ * SETx, CLRx or TGLx sets, clears or toggles that bit of PORTx.
+ */
+#ifdef DIO_SIM
+#include "dio_sim.h"
+#define DIO_REGISTER(Address)	DIO_SIM_REGISTER(Address)
+#define DIO_REG_READ(Register)	DioSim_RegRead(Register)
+#define DIO_REG_WRITE(Register, Value)	DioSim_RegWrite((Register), (Value))
+#define DIO_INTERRUPTS_DISABLE()	DioSim_InterruptsDisable()
+#else
+#error "sim32 is a simulated MCU, build it with DIO_SIM defined"
+#endif
+
+/* Keeps the compiler from moving memory accesses across this point */
+#define DIO_MEMORY_BARRIER()	__asm__ __volatile__ ("" ::: "memory")
+
+/* Register addresses by port index (DioPort_t), folded for a constant Port */
+#define DIO_PORT_BLOCK(Port)	(0x0100U + 8U * (Port))
+#define DIO_PIN_ADDRESS(Port)	DIO_REGISTER(DIO_PORT_BLOCK(Port) + 0U)
+#define DIO_DDR_ADDRESS(Port)	DIO_REGISTER(DIO_PORT_BLOCK(Port) + 1U)
+#define DIO_PORT_ADDRESS(Port)	DIO_REGISTER(DIO_PORT_BLOCK(Port) + 2U)
+#define DIO_SET_ADDRESS(Port)	DIO_REGISTER(DIO_PORT_BLOCK(Port) + 3U)
+#define DIO_CLEAR_ADDRESS(Port)	DIO_REGISTER(DIO_PORT_BLOCK(Port) + 4U)
+#define DIO_TOGGLE_ADDRESS(Port)	DIO_REGISTER(DIO_PORT_BLOCK(Port) + 5U)
+
+#define DIO_UPPER_BOUND_ADDRESS DIO_TOGGLE_ADDRESS(DIO_NUMBER_OF_PORTS - 1U)
+#define DIO_LOWER_BOUND_ADDRESS DIO_PIN_ADDRESS(0U)
+
+/* Status register, bit 7 is the global interrupt enable flag */
+#define SREG	DIO_REGISTER(0x005F)
+
+/* Critical section, saves SREG and disables interrupts until it is restored */
+#define DIO_CRITICAL_ENTER(Sreg) \
+  do { (Sreg) = (uint8_t)DIO_REG_READ((volatile uint32_t *)SREG); \
+       DIO_INTERRUPTS_DISABLE(); } while (0)
+#define DIO_CRITICAL_EXIT(Sreg) \
+  do { __asm__ __volatile__ ("" ::: "memory"); \
+       DIO_REG_WRITE((volatile uint32_t *)SREG, (Sreg)); } while (0)
+
+#endif
@@ -13,6 +13,16 @@
 /*********************************************************************
 * Module Variable Definitions
 **********************************************************************/
+/**
+* The following list contains the configuration data for each
+* digital input/output peripheral channel (pin). Each row represents a 
+* single pin: X(Port, Channel, Direction, Data, Pullup). The list is expanded
+* into the two formats of the configuration below, so they always agree.
+*/
+  //TODO: configure your pins
+#define DIO_CONFIG_TABLE(X, Port) \
+  X(Port, PORTA_0, DIO_DIR_OUTPUT, DIO_STATE_LOW, DIO_PULLUP_DISABLED)
+
 /**
 * The following array contains the configuration data for each
 * digital input/output peripheral channel (pin). Each row represents a 
@@ -22,8 +32,83 @@
 */
 static const DioConfig_t DioConfig[] =
 {
-  //TODO: configure your pins
-  { PORTA_0, DIO_DIR_OUTPUT, DIO_STATE_LOW }
+  DIO_CONFIG_TABLE(DIO_CONFIG_ROW, 0)
+};
+
+/**
+* The following array contains the packed configuration, one row per port
+* indexed by DioPort_t, folded from the same list at build time. It is
+* read in by Dio_InitPorts, which writes each port register once. Its 3
+* masks per port replace the DioConfig_t row of each channel.
+*/
+static const DioPortConfig_t DioPortConfig[DIO_NUMBER_OF_PORTS] =
+{
+  DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORTA),
+  //TODO: one entry per DioPort_t
+};
+
+/**
+* The following array contains the pin configuration profiles, indexed by
+* DioProfileId_t, each one packed as one row per port (DioPortConfig_t).
+* A profile is built from a DIO_CONFIG_TABLE list with DIO_PORT_CONFIG, or
+* written directly as masks. Dio_ApplyProfile switches to a profile by
+* writing only the port registers that differ from it.
+*/
+static const DioPortConfig_t DioProfiles[DIO_PROFILE_MAX][DIO_NUMBER_OF_PORTS] =
+{
+  [DIO_PROFILE_EXAMPLE] =
+  {
+    //TODO: one entry per DioPort_t
+    DIO_PORT_CONFIG(DIO_CONFIG_TABLE, DIO_PORTA),
+  },
+};
+
+/**
+* The following array contains the channel groups, indexed by DioGroupId_t.
+* Each group is a set of contiguous channels of one port that is written
+* and read as a single value by Dio_GroupWrite and Dio_GroupRead.
+*/
+static const DioGroup_t DioGroups[DIO_GROUP_MAX] =
+{
+  [DIO_GROUP_EXAMPLE] = DIO_GROUP(PORTA_0, 2U),
+};
+
+/**
+* The following array contains the debounced channels, one row per port.
+* Each row is sampled once per Dio_DebounceTick.
+*/
+static const DioDebounceConfig_t DioDebounceConfig[DIO_DEBOUNCE_PORTS] =
+{
+  { DIO_PORTA, 0x03, 0x03 },
+};
+
+/**
+* The following array contains the channels of the software PWM. The
+* position of a channel in the table is its index in Dio_PwmDutySet.
+*/
+static const DioChannel_t DioPwmChannels[DIO_PWM_CHANNELS] =
+{
+  PORTA_0, PORTA_1
+};
+
+/**
+* The following arrays contain the channels of the keypad matrix. The
+* rows of one port are selected with one write to the direction register,
+* the columns of one port are sampled with one read of the input register.
+*/
+static const DioChannel_t DioKeypadRows[DIO_KEYPAD_ROWS] =
+{
+  PORTA_0
+};
+
+static const DioChannel_t DioKeypadColumns[DIO_KEYPAD_COLUMNS] =
+{
+  PORTA_1
+};
+
+static const DioKeypadConfig_t DioKeypadConfig =
+{
+  DioKeypadRows, DioKeypadColumns
 };
 /**********************************************************************
 * Function Definitions
@@ -54,4 +139,133 @@ Dio_ConfigGet(void)
   */
   return (const DioConfig_t *)DioConfig;
 }
+
+/**********************************************************************
+* Function : Dio_PortConfigGet()
+*//**
+* \b Description:
+* This function is used to get the packed configuration of the Dio <br>
+* POST-CONDITION: A constant pointer to the first member of the
+* packed configuration will be returned. <br>
+* @return A pointer to the packed configuration of DIO_NUMBER_OF_PORTS
+* rows.
+*
+* \b Example:
+* @code
+* Dio_InitPorts(Dio_PortConfigGet());
+* @endcode
+* @see Dio_InitPorts
+**********************************************************************/
+const DioPortConfig_t *
+Dio_PortConfigGet(void)
+{
+  return DioPortConfig;
+}
+
+/**********************************************************************
+* Function : Dio_ProfileConfigGet()
+*//**
+* \b Description:
+* This function is used to get a pin configuration profile of the Dio <br>
+* PRE-CONDITION: Id < DIO_PROFILE_MAX <br>
+* POST-CONDITION: A constant pointer to the first port of the profile
+* will be returned. <br>
+* @param Id is the profile
+* @return A pointer to the DIO_NUMBER_OF_PORTS rows of the profile.
+*
+* \b Example:
+* @code
+* Dio_InitPorts(Dio_ProfileConfigGet(DIO_PROFILE_EXAMPLE));
+* @endcode
+* @see Dio_ApplyProfile
+**********************************************************************/
+const DioPortConfig_t *
+Dio_ProfileConfigGet(DioProfileId_t Id)
+{
+  return DioProfiles[Id];
+}
+
+/**********************************************************************
+* Function : Dio_GroupConfigGet()
+*//**
+* \b Description:
+* This function is used to get the channel group table of the Dio <br>
+* POST-CONDITION: A constant pointer to the first member of the
+* group table will be returned. <br>
+* @return A pointer to the group table, indexed by DioGroupId_t.
+*
+* \b Example:
+* @code
+* const DioGroup_t *Groups = Dio_GroupConfigGet();
+* Dio_GroupWrite(&Groups[DIO_GROUP_EXAMPLE], 0x3);
+* @endcode
+* @see Dio_GroupWrite
+**********************************************************************/
+const DioGroup_t *
+Dio_GroupConfigGet(void)
+{
+  return DioGroups;
+}
+
+/**********************************************************************
+* Function : Dio_DebounceConfigGet()
+*//**
+* \b Description:
+* This function is used to get the debounce table of the Dio <br>
+* POST-CONDITION: A constant pointer to the first member of the
+* debounce table will be returned. <br>
+* @return A pointer to the debounce table of DIO_DEBOUNCE_PORTS rows.
+*
+* \b Example:
+* @code
+* Dio_DebounceInit(Dio_DebounceConfigGet());
+* @endcode
+* @see Dio_DebounceInit
+**********************************************************************/
+const DioDebounceConfig_t *
+Dio_DebounceConfigGet(void)
+{
+  return DioDebounceConfig;
+}
+
+/**********************************************************************
+* Function : Dio_PwmConfigGet()
+*//**
+* \b Description:
+* This function is used to get the software PWM channel table of the Dio <br>
+* POST-CONDITION: A constant pointer to the first member of the
+* PWM channel table will be returned. <br>
+* @return A pointer to the PWM channel table of DIO_PWM_CHANNELS rows.
+*
+* \b Example:
+* @code
+* Dio_PwmInit(Dio_PwmConfigGet());
+* @endcode
+* @see Dio_PwmInit
+**********************************************************************/
+const DioChannel_t *
+Dio_PwmConfigGet(void)
+{
+  return DioPwmChannels;
+}
+/**********************************************************************
+* Function : Dio_KeypadConfigGet()
+*//**
+* \b Description:
+* This function is used to get the keypad matrix of the Dio <br>
+* POST-CONDITION: A constant pointer to the keypad matrix will be<br>
+* returned. <br>
+* @return A pointer to the keypad matrix.
+*
+* \b Example:
+* @code
+* Dio_KeypadInit(Dio_KeypadConfigGet());
+* @endcode
+* @see Dio_KeypadInit
+**********************************************************************/
+const DioKeypadConfig_t *
+Dio_KeypadConfigGet(void)
+{
+  return &DioKeypadConfig;
+}
 /************************ END OF FILE ********************************/
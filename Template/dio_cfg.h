@@ -10,6 +10,10 @@
 #ifndef DIO_CFG_H_
 #define DIO_CFG_H_
 /**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+/**********************************************************************
 * Preprocessor Constants
 **********************************************************************/
 /**
@@ -20,6 +24,172 @@
 * Defines the number of ports on the processor.
 */
 #define DIO_NUMBER_OF_PORTS 4U
+/**
+ * The feature is supported
+ */
+#define STD_ON 1
+/**
+ * The feature is not supported
+ */
+#define STD_OFF 0
+/**
+* Enables the instrumentation counters of the dio module (calls and
+* register accesses per API entry point and per port, calls per channel).
+* With STD_OFF the instrumentation compiles to nothing.
+*/
+#ifndef DIO_INSTRUMENT
+#define DIO_INSTRUMENT STD_OFF
+#endif
+/**
+* Enables the shadow registers of the dio module: between Dio_BeginBatch
+* and Dio_Commit the output and direction writes only update a RAM mirror
+* of the ports, and the commit writes each changed register once. With
+* STD_OFF the batch API is not built and every write goes to the port.
+* It is off by default, a batch defers the writes of every caller: see
+* Dio_BeginBatch for the writes that may run while a batch is open.
+*/
+#ifndef DIO_SHADOW
+#define DIO_SHADOW STD_OFF
+#endif
+/**
+* Makes the read-modify-write functions of the dio module atomic against
+* ISRs writing the same port: the channel, masked port, group, direction
+* and commit writes, and the reads and writes of each port of
+* Dio_ApplyProfile, run in a critical section. With STD_OFF only the
+* *Atomic functions are protected. Dio_PortWrite and Dio_SetPortDirection
+* are a single write and are always atomic.
+*/
+#ifndef DIO_ATOMIC
+#define DIO_ATOMIC STD_OFF
+#endif
+/**
+* Makes dio.h define Dio_ChannelRead, Dio_ChannelWrite and
+* Dio_SetChannelDirection as static inline functions (dio_inline.h), so
+* that a call with a constant channel folds to the register access. It
+* needs DIO_SHADOW and DIO_INSTRUMENT set to STD_OFF.
+*/
+#ifndef DIO_INLINE
+#define DIO_INLINE STD_OFF
+#endif
+/**
+* The register models of a port. DIO_BACKEND_RMW: a data output register
+* that is updated by read-modify-write (AVR). DIO_BACKEND_SET_CLEAR: the
+* data output register has write-only set and clear registers, a one
+* written to a bit sets or clears that channel only, atomically in
+* hardware, so an output write is a store without a read.
+*/
+#define DIO_BACKEND_RMW 0
+#define DIO_BACKEND_SET_CLEAR 1
+/**
+* Selects the register model of the ports of the target.
+*/
+//TODO: DIO_BACKEND_SET_CLEAR when the ports have set/clear registers
+#define DIO_BACKEND DIO_BACKEND_RMW
+/**
+* Selects the placement of the channel lookup table of the dio module:
+* STD_ON keeps it in flash through DIO_FLASH of dio_memmap.h, STD_OFF
+* in RAM. The masks are fetched by DIO_FLASH_READ_VALUE, which must read
+* the whole width of DioPortValue_t.
+*/
+#define DIO_CHANNEL_MAP_FLASH STD_OFF
+/**
+* Defines the number of ports of the debounce table.
+*/
+#define DIO_DEBOUNCE_PORTS 1U
+/**
+* Defines the depth of the debouncing as the number of bits of the
+* vertical counters. A debounced channel changes state after it has been
+* sampled 2^DIO_DEBOUNCE_COUNTER_BITS times in a row at the new level.
+*/
+#define DIO_DEBOUNCE_COUNTER_BITS 2U
+/**
+* Defines the number of channels of the software PWM table.
+*/
+#define DIO_PWM_CHANNELS 2U
+/**
+* Defines the duty cycle resolution of the software PWM in bits, at most
+* 15. A period is 2^DIO_PWM_BITS - 1 ticks and a duty cycle is the number
+* of ticks a channel is HIGH in a period.
+*/
+#define DIO_PWM_BITS 8U
+/**
+* Selects the modulation of the software PWM: STD_ON drives the channels
+* with bit angle modulation (one frame per duty bit, weighted 2^bit
+* ticks), STD_OFF with pulse width modulation (one pulse per period).
+*/
+#define DIO_PWM_BAM STD_OFF
+/**
+* Defines the number of rows and of columns of the keypad matrix, at most
+* 8 columns. Key n of the keypad is at row n / DIO_KEYPAD_COLUMNS and
+* column n % DIO_KEYPAD_COLUMNS.
+*/
+#define DIO_KEYPAD_ROWS 1U
+#define DIO_KEYPAD_COLUMNS 1U
+/**
+* Defines the depth of the keypad debouncing as the number of bits of the
+* vertical counters. A key changes state after 2^DIO_KEYPAD_COUNTER_BITS
+* scans in a row at the new level.
+*/
+#define DIO_KEYPAD_COUNTER_BITS 2U
+/**
+* Defines the number of entries of the keypad event queue, a power of two
+* of at most 128.
+*/
+#define DIO_KEYPAD_QUEUE_SIZE 8U
+/**
+* Declares the keypad matrix with a diode in series with every key:
+* STD_ON reports any combination of keys (n-key rollover), STD_OFF holds
+* the rows whose keys cannot be told apart from a ghost key.
+*/
+#define DIO_KEYPAD_DIODES STD_OFF
+/**********************************************************************
+* Preprocessor Macros
+**********************************************************************/
+/**
+* The port of a channel and the mask of the channel in its port registers.
+*/
+#define DIO_CHANNEL_PORT(Channel) \
+  ((DioPort_t)((Channel) / DIO_CHANNELS_PER_PORT))
+#define DIO_CHANNEL_MASK(Channel) \
+  ((DioPortValue_t)((DioPortValue_t)1U << ((Channel) % DIO_CHANNELS_PER_PORT)))
+/**
+* Initializer of a DioGroup_t of Width contiguous channels starting at the
+* channel First. The group must not cross a port boundary.
+*/
+#define DIO_GROUP(First, Width) \
+  { DIO_CHANNEL_PORT(First), \
+    (DioPortValue_t)((DioPortValue_t)((DioPortValue_t)~(DioPortValue_t)0U \
+                                      >> (8U * sizeof(DioPortValue_t) - (Width))) \
+                     << ((First) % DIO_CHANNELS_PER_PORT)), \
+    (uint8_t)((First) % DIO_CHANNELS_PER_PORT) }
+/**
+* Terms of the masks of one port, one term per row of a DIO_CONFIG_TABLE:
+* the OUTPUT channels, the OUTPUT channels driven HIGH, and the INPUT
+* channels with their pull-up enabled.
+* The terms are constant, so the masks are folded by the compiler.
+*/
+#define DIO_CONFIG_DIRECTION(Port, Channel, Direction, Data, Pullup) \
+  | ((DIO_CHANNEL_PORT(Channel) == (Port) && (Direction) == DIO_DIR_OUTPUT) \
+     ? DIO_CHANNEL_MASK(Channel) : 0U)
+#define DIO_CONFIG_DATA(Port, Channel, Direction, Data, Pullup) \
+  | ((DIO_CHANNEL_PORT(Channel) == (Port) && (Direction) == DIO_DIR_OUTPUT \
+      && (Data) == DIO_STATE_HIGH) ? DIO_CHANNEL_MASK(Channel) : 0U)
+#define DIO_CONFIG_PULLUP(Port, Channel, Direction, Data, Pullup) \
+  | ((DIO_CHANNEL_PORT(Channel) == (Port) && (Direction) == DIO_DIR_INPUT \
+      && (Pullup) == DIO_PULLUP_ENABLED) ? DIO_CHANNEL_MASK(Channel) : 0U)
+/**
+* Initializer of the DioConfig_t row of a DIO_CONFIG_TABLE row.
+*/
+#define DIO_CONFIG_ROW(Port, Channel, Direction, Data, Pullup) \
+  { (Channel), (Direction), (Data), (Pullup) },
+/**
+* Initializer of the DioPortConfig_t of Port from the rows of Table, a
+* DIO_CONFIG_TABLE(X, Port) list of X(Port, Channel, Direction, Data, Pullup).
+*/
+#define DIO_PORT_CONFIG(Table, Port) \
+  { (DioPortValue_t)(0U Table(DIO_CONFIG_DIRECTION, Port)), \
+    (DioPortValue_t)(0U Table(DIO_CONFIG_DATA, Port)), \
+    (DioPortValue_t)(0U Table(DIO_CONFIG_PULLUP, Port)) }
 /**********************************************************************
 * Typedefs
 **********************************************************************/
@@ -42,6 +212,16 @@ typedef enum
 	DIO_DIR_OUTPUT
 }DioDirection_t;
 
+/**
+ * Defines the possible states of the pull-up resistor of an INPUT pin
+ */
+typedef enum
+{
+	DIO_PULLUP_DISABLED, /**< The input floats */
+	DIO_PULLUP_ENABLED, /**< The input is pulled HIGH */
+	DIO_PULLUP_MAX /**< the maximum number of pull-up states */
+}DioPullup_t;
+
 /**
 * Defines an enumerated list of all the channels (pins) on the MCU
 * device. The last element is used to specify the maximum number of
@@ -55,6 +235,24 @@ typedef enum
 	DIO_CHANNEL_MAX
 }DioChannel_t;
 
+/**
+* Defines an enumerated list of all the ports on the MCU device, in the
+* same order as the port register tables of the dio module. The last
+* element is used to specify the maximum number of enumerated labels.
+*/
+typedef enum
+{
+	/* TODO: Populate this list based on the port register tables */
+	DIO_PORTA,
+	DIO_PORT_MAX
+}DioPort_t;
+
+/**
+* Defines the width of a port register. Bit n of a value holds the
+* state of channel n of the port.
+*/
+typedef TYPE DioPortValue_t;
+
 /**
 * Defines the digital input/output configuration table’s elements that are used
 * by Dio_Init to configure the Dio peripheral.
@@ -63,9 +261,122 @@ typedef struct
 {
 	DioChannel_t Channel; /**< The I/O pin */
 	DioDirection_t Direction; /**< OUTPUT or INPUT */
-	DioState_t Data; /**< HIGH or LOW */
+	DioState_t Data; /**< HIGH or LOW, for an OUTPUT */
+	DioPullup_t Pullup; /**< ENABLED or DISABLED, for an INPUT */
 }DioConfig_t;
 
+/**
+* Defines the packed configuration of one port, read in by Dio_InitPorts.
+* It sets every channel of the port: 3 masks per port instead of one
+* DioConfig_t row per channel.
+*/
+typedef struct
+{
+	DioPortValue_t Direction; /**< The OUTPUT channels, bit n for channel n */
+	DioPortValue_t Data; /**< The OUTPUT channels driven HIGH */
+	DioPortValue_t Pullup; /**< The INPUT channels with their pull-up enabled */
+}DioPortConfig_t;
+
+/**
+* Defines an enumerated list of the pin configuration profiles of the
+* profile table, applied by Dio_ApplyProfile. The last element is used to
+* specify the maximum number of enumerated labels.
+*/
+typedef enum
+{
+	DIO_PROFILE_EXAMPLE, /**< TODO: Populate with the operating modes */
+	DIO_PROFILE_MAX
+}DioProfileId_t;
+
+/**
+* Defines a group of contiguous channels of one port (a bit-field), it is
+* written and read with a single access to the port registers.
+*/
+typedef struct
+{
+	DioPort_t Port; /**< The port of the channels */
+	DioPortValue_t Mask; /**< The channels of the group in the port */
+	uint8_t Shift; /**< The position of the first channel in the port */
+}DioGroup_t;
+
+/**
+* Defines an enumerated list of the channel groups of the group table.
+* The last element is used to specify the maximum number of enumerated
+* labels.
+*/
+typedef enum
+{
+	DIO_GROUP_EXAMPLE, /**< TODO: Populate with the channel groups */
+	DIO_GROUP_MAX
+}DioGroupId_t;
+
+/**
+* Defines the debouncing of the channels of one port, read in by
+* Dio_DebounceInit.
+*/
+typedef struct
+{
+	DioPort_t Port; /**< The port */
+	DioPortValue_t Mask; /**< The channels of the port to debounce */
+	DioPortValue_t ActiveLow; /**< The channels that are pressed when low */
+}DioDebounceConfig_t;
+
+/**
+* Defines the keypad matrix, read in by Dio_KeypadInit. The rows are
+* driven LOW one at a time, the columns are inputs with their pull-ups.
+*/
+typedef struct
+{
+	const DioChannel_t *Rows; /**< The DIO_KEYPAD_ROWS row channels */
+	const DioChannel_t *Columns; /**< The DIO_KEYPAD_COLUMNS column channels */
+}DioKeypadConfig_t;
+
+#if DIO_INSTRUMENT == STD_ON
+/**
+* Defines the API entry points counted by the instrumentation.
+*/
+typedef enum
+{
+	DIO_API_INIT,
+	DIO_API_INIT_PORTS,
+	DIO_API_APPLY_PROFILE,
+	DIO_API_CHANNEL_READ,
+	DIO_API_CHANNEL_WRITE,
+	DIO_API_SET_CHANNEL_DIRECTION,
+	DIO_API_PORT_READ,
+	DIO_API_PORT_WRITE,
+	DIO_API_PORT_WRITE_MASKED,
+	DIO_API_SET_PORT_DIRECTION,
+	DIO_API_SET_PORT_DIRECTION_MASKED,
+	DIO_API_REGISTER_READ,
+	DIO_API_REGISTER_WRITE,
+	DIO_API_GROUP_READ,
+	DIO_API_GROUP_WRITE,
+	DIO_API_COMMIT,
+	DIO_API_MAX
+}DioApi_t;
+
+/**
+* Defines the register access counters.
+*/
+typedef struct
+{
+	uint32_t Reads; /**< Number of register reads */
+	uint32_t Writes; /**< Number of register writes */
+}DioAccess_t;
+
+/**
+* Defines the instrumentation counters returned by Dio_StatsGet.
+*/
+typedef struct
+{
+	uint32_t ApiCalls[DIO_API_MAX]; /**< Calls of each entry point */
+	DioAccess_t ApiAccess[DIO_API_MAX]; /**< Register accesses of each entry point */
+	DioAccess_t PortAccess[DIO_NUMBER_OF_PORTS + 1U]; /**< Register accesses of each port, the last entry is for registers outside the ports */
+	uint32_t ChannelCalls[DIO_CHANNEL_MAX]; /**< Calls made for each channel */
+}DioStats_t;
+#endif
+
 /**********************************************************************
 * Function Prototypes
 **********************************************************************/
@@ -74,6 +385,12 @@ extern "C"{
 #endif
 
 const DioConfig_t* Dio_ConfigGet(void);
+const DioPortConfig_t* Dio_PortConfigGet(void);
+const DioPortConfig_t* Dio_ProfileConfigGet(DioProfileId_t Id);
+const DioGroup_t* Dio_GroupConfigGet(void);
+const DioDebounceConfig_t* Dio_DebounceConfigGet(void);
+const DioChannel_t* Dio_PwmConfigGet(void);
+const DioKeypadConfig_t* Dio_KeypadConfigGet(void);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -0,0 +1,291 @@
+/**
+ * @file dio_debounce.c
+ * @author Mohamed Hassanin
+ * @brief The implementation for the dio input debouncing.
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_debounce.h" /* For this modules definitions */
+#include "dio.h" /* For the port interface */
+#include "dio_memmap.h" /* For the critical section */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Marks a port without a row in the debounce table.
+*/
+#define DIO_DEBOUNCE_NONE 0xFFU
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+* Defines the debouncing state of the channels of one port.
+*/
+typedef struct
+{
+	DioPortValue_t State; /**< The debounced level of the channels */
+	DioPortValue_t Counter[DIO_DEBOUNCE_COUNTER_BITS]; /**< Vertical counters */
+	DioPortValue_t Pressed; /**< Channels pressed since the last get */
+	DioPortValue_t Released; /**< Channels released since the last get */
+}DioDebounce_t;
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The debounce table set by Dio_DebounceInit and the state of its rows.
+*/
+static const DioDebounceConfig_t * Dio_DebounceConfig;
+static DioDebounce_t Dio_Debounce[DIO_DEBOUNCE_PORTS];
+/**
+* The row of each port in the debounce table, DIO_DEBOUNCE_NONE when
+* the port is not debounced.
+*/
+static uint8_t Dio_DebounceRow[DIO_NUMBER_OF_PORTS];
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/*********************************************************************
+* Function : Dio_DebounceInit()
+*//**
+* \b Description:
+* This function is used to start the debouncing of the channels of a<br>
+* debounce table. The debounced state of every channel is set to its<br>
+* current level, so no press or release is reported for the levels found<br>
+* at start up.<br>
+* PRE-CONDITION: Dio_Init has been called <br>
+* PRE-CONDITION: The table has DIO_DEBOUNCE_PORTS rows of distinct ports <br>
+* POST-CONDITION: The channels of the table are debounced by<br>
+* Dio_DebounceTick.<br>
+* @param Config is a pointer to the debounce table
+* @return void
+*
+* \b Example:
+* @code
+* Dio_DebounceInit(Dio_DebounceConfigGet());
+* @endcode
+* @see Dio_DebounceTick
+**********************************************************************/
+void
+Dio_DebounceInit(const DioDebounceConfig_t * const Config)
+{
+  Dio_DebounceConfig = Config;
+
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      Dio_DebounceRow[Port] = DIO_DEBOUNCE_NONE;
+    }
+
+  for (uint8_t Row = 0; Row < DIO_DEBOUNCE_PORTS; Row++)
+    {
+      DioDebounce_t * const Debounce = &Dio_Debounce[Row];
+
+      Dio_DebounceRow[Config[Row].Port] = Row;
+      Debounce->State = Dio_PortRead(Config[Row].Port) & Config[Row].Mask;
+      for (uint8_t Bit = 0; Bit < DIO_DEBOUNCE_COUNTER_BITS; Bit++)
+        {
+          Debounce->Counter[Bit] = 0;
+        }
+      Debounce->Pressed = 0;
+      Debounce->Released = 0;
+    }
+}
+
+/*********************************************************************
+* Function : Dio_DebounceTick()
+*//**
+* \b Description:
+* This function is used to sample and debounce the channels of the<br>
+* debounce table. Each port is read once, the counter of a channel is<br>
+* advanced while its sample differs from its debounced state and cleared<br>
+* otherwise. A channel whose counter wraps changes its debounced state<br>
+* and is latched as pressed or released.<br>
+* The function is called periodically, from a timer interrupt or the main<br>
+* loop; the debounce time is the period times 2^DIO_DEBOUNCE_COUNTER_BITS.<br>
+* PRE-CONDITION: Dio_DebounceInit has been called <br>
+* POST-CONDITION: The debounced state, pressed and released masks are<br>
+* updated.<br>
+* @return void
+*
+* \b Example:
+* @code
+* void Timer_Isr(void) // 1 ms
+* {
+*   Dio_DebounceTick();
+* }
+* @endcode
+* @see Dio_DebouncedRead
+**********************************************************************/
+void
+Dio_DebounceTick(void)
+{
+  for (uint8_t Row = 0; Row < DIO_DEBOUNCE_PORTS; Row++)
+    {
+      const DioDebounceConfig_t * const Config = &Dio_DebounceConfig[Row];
+      DioDebounce_t * const Debounce = &Dio_Debounce[Row];
+      // The channels whose sample differs from their debounced state
+      const DioPortValue_t Changed = (DioPortValue_t)
+        ((Dio_PortRead(Config->Port) ^ Debounce->State) & Config->Mask);
+      DioPortValue_t Carry = Changed;
+
+      // Add the carry to the counters of the changed channels and clear
+      // the counters of the others, the carry out marks the wrapped ones
+      for (uint8_t Bit = 0; Bit < DIO_DEBOUNCE_COUNTER_BITS; Bit++)
+        {
+          Debounce->Counter[Bit] = (DioPortValue_t)
+            ((Debounce->Counter[Bit] ^ Carry) & Changed);
+          Carry &= (DioPortValue_t)~Debounce->Counter[Bit];
+        }
+
+      if(Carry != 0)
+        {
+          DioPortValue_t Active;
+
+          Debounce->State ^= Carry;
+          Active = (DioPortValue_t)(Debounce->State ^ Config->ActiveLow);
+          Debounce->Pressed |= (DioPortValue_t)(Carry & Active);
+          Debounce->Released |= (DioPortValue_t)(Carry & ~Active);
+        }
+    }
+}
+
+/*********************************************************************
+* Function : Dio_DebouncedRead()
+*//**
+* \b Description:
+* This function is used to read the debounced state of a channel.<br>
+* A channel that is not debounced is read directly by Dio_ChannelRead.<br>
+* PRE-CONDITION: Dio_DebounceInit has been called <br>
+* PRE-CONDITION: The channel is within the maximum DioChannel_t definition<br>
+* POST-CONDITION: The debounced channel state is returned.<br>
+* @param Channel is the DioChannel_t that represents a pin
+* @return The debounced state of the channel as HIGH or LOW
+*
+* \b Example:
+* @code
+* if(Dio_DebouncedRead(PORTA_0) == DIO_STATE_LOW) { ... }
+* @endcode
+* @see Dio_DebounceTick
+**********************************************************************/
+DioState_t
+Dio_DebouncedRead(DioChannel_t Channel)
+{
+  const uint8_t Row = Dio_DebounceRow[DIO_CHANNEL_PORT(Channel)];
+  const DioPortValue_t PinMask = DIO_CHANNEL_MASK(Channel);
+
+  if(Row == DIO_DEBOUNCE_NONE || (Dio_DebounceConfig[Row].Mask & PinMask) == 0)
+    {
+      return Dio_ChannelRead(Channel);
+    }
+
+  return ((Dio_Debounce[Row].State & PinMask) ? DIO_STATE_HIGH : DIO_STATE_LOW);
+}
+
+/*********************************************************************
+* Function : Dio_DebouncedPortRead()
+*//**
+* \b Description:
+* This function is used to read the debounced state of the channels of a<br>
+* port, bit n of the value is the state of channel n.<br>
+* PRE-CONDITION: Dio_DebounceInit has been called <br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition<br>
+* POST-CONDITION: The debounced state of the port is returned, the bits<br>
+* of the channels that are not debounced are zero.<br>
+* @param Port is the DioPort_t that represents the port
+* @return The debounced state of the port
+*
+* \b Example:
+* @code
+* DioPortValue_t Buttons = Dio_DebouncedPortRead(DIO_PORTA);
+* @endcode
+* @see Dio_DebounceTick
+**********************************************************************/
+DioPortValue_t
+Dio_DebouncedPortRead(DioPort_t Port)
+{
+  const uint8_t Row = Dio_DebounceRow[Port];
+
+  return (Row == DIO_DEBOUNCE_NONE) ? 0 : Dio_Debounce[Row].State;
+}
+
+/*********************************************************************
+* Function : Dio_DebouncePressedGet()
+*//**
+* \b Description:
+* This function is used to get and clear the channels of a port that<br>
+* were pressed (debounced to their active level) since the last call.<br>
+* It may be called while Dio_DebounceTick runs from an interrupt.<br>
+* PRE-CONDITION: Dio_DebounceInit has been called <br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition<br>
+* POST-CONDITION: The pressed mask of the port is returned and cleared.<br>
+* @param Port is the DioPort_t that represents the port
+* @return The mask of the pressed channels of the port
+*
+* \b Example:
+* @code
+* if(Dio_DebouncePressedGet(DIO_PORTA) & DIO_CHANNEL_MASK(PORTA_0)) { ... }
+* @endcode
+* @see Dio_DebounceReleasedGet
+**********************************************************************/
+DioPortValue_t
+Dio_DebouncePressedGet(DioPort_t Port)
+{
+  const uint8_t Row = Dio_DebounceRow[Port];
+  DioPortValue_t Pressed;
+  uint8_t Sreg;
+
+  if(Row == DIO_DEBOUNCE_NONE)
+    {
+      return 0;
+    }
+
+  DIO_CRITICAL_ENTER(Sreg);
+  Pressed = Dio_Debounce[Row].Pressed;
+  Dio_Debounce[Row].Pressed = 0;
+  DIO_CRITICAL_EXIT(Sreg);
+
+  return Pressed;
+}
+
+/*********************************************************************
+* Function : Dio_DebounceReleasedGet()
+*//**
+* \b Description:
+* This function is used to get and clear the channels of a port that<br>
+* were released (debounced to their inactive level) since the last call.<br>
+* It may be called while Dio_DebounceTick runs from an interrupt.<br>
+* PRE-CONDITION: Dio_DebounceInit has been called <br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition<br>
+* POST-CONDITION: The released mask of the port is returned and cleared.<br>
+* @param Port is the DioPort_t that represents the port
+* @return The mask of the released channels of the port
+*
+* \b Example:
+* @code
+* if(Dio_DebounceReleasedGet(DIO_PORTA) & DIO_CHANNEL_MASK(PORTA_0)) { ... }
+* @endcode
+* @see Dio_DebouncePressedGet
+**********************************************************************/
+DioPortValue_t
+Dio_DebounceReleasedGet(DioPort_t Port)
+{
+  const uint8_t Row = Dio_DebounceRow[Port];
+  DioPortValue_t Released;
+  uint8_t Sreg;
+
+  if(Row == DIO_DEBOUNCE_NONE)
+    {
+      return 0;
+    }
+
+  DIO_CRITICAL_ENTER(Sreg);
+  Released = Dio_Debounce[Row].Released;
+  Dio_Debounce[Row].Released = 0;
+  DIO_CRITICAL_EXIT(Sreg);
+
+  return Released;
+}
+/*************** END OF FUNCTIONS ********************************/
@@ -0,0 +1,38 @@
+/**
+ * @file dio_debounce.h
+ * @author Mohamed Hassanin
+ * @brief The interface definition for the dio input debouncing.
+ * The debounced channels of a port are sampled with a single port read
+ * per tick and debounced together by vertical (bit-sliced) counters:
+ * bit n of counter word k is bit k of the counter of channel n, so one
+ * pass of a few logic operations counts all the channels of the port.
+ * @version 0.1
+ * @date 2021-01-12
+*/
+#ifndef DIO_DEBOUNCE_H_
+#define DIO_DEBOUNCE_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_cfg.h" /**< For dio configuration */
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void Dio_DebounceInit(const DioDebounceConfig_t * const Config);
+void Dio_DebounceTick(void);
+DioState_t Dio_DebouncedRead(DioChannel_t Channel);
+DioPortValue_t Dio_DebouncedPortRead(DioPort_t Port);
+DioPortValue_t Dio_DebouncePressedGet(DioPort_t Port);
+DioPortValue_t Dio_DebounceReleasedGet(DioPort_t Port);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* DIO_DEBOUNCE_H_*/
+/*************** END OF FILE ********************************/
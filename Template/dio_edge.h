@@ -0,0 +1,60 @@
+/**
+ * @file dio_edge.h
+ * @author Mohamed Hassanin
+ * @brief The interface definition for the dio edge detection.
+ * A scan reads all the ports back to back into a snapshot, a coherent
+ * sample of every channel, and compares it with the snapshot of the
+ * previous scan. The rising and falling channels of each port are kept as
+ * masks, and only the channels that changed are dispatched to their
+ * callbacks, so a scan without changes costs one read and one compare
+ * per port.
+ * @version 0.1
+ * @date 2021-01-12
+*/
+#ifndef DIO_EDGE_H_
+#define DIO_EDGE_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_cfg.h" /**< For dio configuration */
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+* Defines the edges a callback is registered for.
+*/
+typedef enum
+{
+	DIO_EDGE_NONE, /**< No edge, the callback is disabled */
+	DIO_EDGE_RISING, /**< Low to high */
+	DIO_EDGE_FALLING, /**< High to low */
+	DIO_EDGE_BOTH, /**< Both edges */
+	DIO_EDGE_MAX
+}DioEdge_t;
+
+/**
+* Defines a callback of a channel edge, State is the new channel state.
+*/
+typedef void (*DioEdgeCallback_t)(DioChannel_t Channel, DioState_t State);
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void Dio_EdgeInit(void);
+void Dio_EdgeRegister(DioChannel_t Channel, DioEdge_t Edge,
+                      DioEdgeCallback_t Callback);
+uint8_t Dio_ScanChanges(void);
+DioPortValue_t Dio_EdgeSnapshotGet(DioPort_t Port);
+DioPortValue_t Dio_EdgeRisingGet(DioPort_t Port);
+DioPortValue_t Dio_EdgeFallingGet(DioPort_t Port);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* DIO_EDGE_H_*/
+/*************** END OF FILE ********************************/
@@ -12,6 +12,7 @@
 #include <inttypes.h>
 #include "dio_ext.h" /* For this modules definitions */
 #include "xxx.h" /* For Hardware definitions */
+#include "dio_inline.h" /* For the port register tables */
 /**********************************************************************
 * Module Variable Definitions
 **********************************************************************/
@@ -71,6 +72,29 @@ Dio_ChannelToggle(DioChannel_t Channel)
   *Dio_PortsToggle[Channel / NUMBER_OF_CHANNELS_PER_PORT] |= 
   (1UL <<(Channel % NUMBER_OF_CHANNELS_PER_PORT));
 }
+
+/**************************************************************************
+* Function : Dio_PortToggle()
+*//**
+* \b Description:
+* This function is used to toggle the current state of the channels of a<br>
+* port selected by Mask. <br>
+* PRE-CONDITION: The masked channels are configured as OUTPUT <br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition<br>
+* @param Port is the port from the DioPort_t that is to be modified.
+* @param Mask selects the channels to toggle, bit n for channel n
+* \b Example:
+* @code
+* Dio_PortToggle(DIO_PORTA, 0x03); // Toggle PORTA_0 and PORTA_1
+* @endcode
+* @see Dio_ChannelToggle
+* @return void
+**********************************************************************/
+void 
+Dio_PortToggle(DioPort_t Port, DioPortValue_t Mask)
+{
+  *Dio_PortsToggle[Port] = Mask;
+}
 #endif
 
 #if DIO_SET_PULLUP == STD_ON
@@ -79,6 +103,8 @@ Dio_ChannelToggle(DioChannel_t Channel)
 *//**
 * \b Description:
 * This function is used to enable/disable pull up resistor for a specific channel. <br>
+* The template follows the MCUs whose output register selects the pull-up<br>
+* of an INPUT channel, a target with a pull-up register writes it instead.<br>
 * PRE-CONDITION: The channel is within the maximum DioChannel_t definition <br>
 * POST-CONDITION: The pullup resistor is dattached/deattached to/from the channel <br>
 * @param Channel is the channel to attach/deattach the resistor to/from.
@@ -91,7 +117,58 @@ Dio_ChannelToggle(DioChannel_t Channel)
 void 
 Dio_SetPullup(DioChannel_t Channel, DioResistor_t State)
 {
-  //TODO
+  const DioPort_t Port = DIO_CHANNEL_PORT(Channel);
+  const DioPortValue_t Mask = DIO_CHANNEL_MASK(Channel);
+  uint8_t Sreg; // Saved interrupt state
+
+  if(State >= MAX_RESISTOR)
+    {
+      //TODO: implement your error handling method
+      return;
+    }
+
+  DIO_CRITICAL_ENTER(Sreg);
+  if(State == ENABLED)
+    {
+      DIO_REG_WRITE(Dio_PortsOut[Port], DIO_REG_READ(Dio_PortsOut[Port]) | Mask);
+    }
+  else
+    {
+      DIO_REG_WRITE(Dio_PortsOut[Port], DIO_REG_READ(Dio_PortsOut[Port]) & (DioPortValue_t)~Mask);
+    }
+  DIO_CRITICAL_EXIT(Sreg);
+}
+
+/**********************************************************************
+* Function : Dio_PortSetPullups()
+*//**
+* \b Description:
+* This function is used to set the pull-up resistors of all the INPUT<br>
+* channels of a port with one register write: the pull-ups of the inputs<br>
+* selected by Mask are enabled and those of the other inputs are disabled.<br>
+* PRE-CONDITION: The port is within the maximum DioPort_t definition<br>
+* POST-CONDITION: The pull-up of each INPUT channel of the port follows<br>
+* its bit in Mask.<br>
+* @param Port is the port to modify.
+* @param Mask selects the inputs to pull up, bit n for channel n
+* \b Example:
+* @code
+* Dio_PortSetPullups(DIO_PORTA, 0x03);
+* @endcode
+* @return void
+**********************************************************************/
+void 
+Dio_PortSetPullups(DioPort_t Port, DioPortValue_t Mask)
+{
+  uint8_t Sreg; // Saved interrupt state
+  DioPortValue_t Direction; // The OUTPUT channels
+
+  DIO_CRITICAL_ENTER(Sreg);
+  Direction = DIO_REG_READ(Dio_PortsDir[Port]);
+  DIO_REG_WRITE(Dio_PortsOut[Port],
+                (DioPortValue_t)((DIO_REG_READ(Dio_PortsOut[Port]) & Direction)
+                                 | (Mask & (DioPortValue_t)~Direction)));
+  DIO_CRITICAL_EXIT(Sreg);
 }
 
 #endif
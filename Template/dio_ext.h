@@ -23,10 +23,12 @@ extern "C"{
 
 #if DIO_TOGGLE == STD_ON
 void Dio_ChannelToggle(DioChannel_t Channel);
+void Dio_PortToggle(DioPort_t Port, DioPortValue_t Mask);
 #endif
 
-#if DIO_PULLUP == STD_ON
+#if DIO_SET_PULLUP == STD_ON
 void Dio_SetPullup(DioChannel_t Channel, DioResistor_t State);
+void Dio_PortSetPullups(DioPort_t Port, DioPortValue_t Mask);
 #endif
 #if DIO_PULLDOWN == STD_ON
 void Dio_SetPulldown(DioChannel_t Channel, DioResistor_t State);
@@ -0,0 +1,435 @@
+/**
+ * @file dio_keypad.c
+ * @author Mohamed Hassanin
+ * @brief The implementation for the dio matrix keypad scanner.
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_keypad.h" /* For this modules definitions */
+#include "dio.h" /* For the port interface */
+#include "dio_memmap.h" /* For the critical section */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+#if DIO_KEYPAD_COLUMNS > 8U
+#error "DIO_KEYPAD_COLUMNS must be at most 8"
+#endif
+#if (DIO_KEYPAD_QUEUE_SIZE & (DIO_KEYPAD_QUEUE_SIZE - 1U)) != 0 || DIO_KEYPAD_QUEUE_SIZE > 128U
+#error "DIO_KEYPAD_QUEUE_SIZE must be a power of two of at most 128"
+#endif
+/**
+* Wraps an index of the event queue.
+*/
+#define DIO_KEYPAD_QUEUE_MASK (DIO_KEYPAD_QUEUE_SIZE - 1U)
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The port and the mask of each row, and the row channels of each port.
+*/
+static DioPort_t Dio_KeypadRowPort[DIO_KEYPAD_ROWS];
+static DioPortValue_t Dio_KeypadRowMask[DIO_KEYPAD_ROWS];
+static DioPortValue_t Dio_KeypadRowsOf[DIO_NUMBER_OF_PORTS];
+/**
+* The port and the mask of each column, and the ports that have columns.
+*/
+static DioPort_t Dio_KeypadColumnPort[DIO_KEYPAD_COLUMNS];
+static DioPortValue_t Dio_KeypadColumnMask[DIO_KEYPAD_COLUMNS];
+static DioPort_t Dio_KeypadColumnPorts[DIO_KEYPAD_COLUMNS];
+static uint8_t Dio_KeypadColumnPortCount;
+/**
+* The debounced keys of each row, bit n for column n, and the vertical
+* counters of the keys.
+*/
+static uint8_t Dio_KeypadState[DIO_KEYPAD_ROWS];
+static uint8_t Dio_KeypadCounter[DIO_KEYPAD_COUNTER_BITS][DIO_KEYPAD_ROWS];
+/**
+* The event queue. The head is written by Dio_KeypadScan only and the
+* tail by Dio_KeypadEventRead only.
+*/
+static DioKeypadEvent_t Dio_KeypadQueue[DIO_KEYPAD_QUEUE_SIZE];
+static volatile uint8_t Dio_KeypadHead;
+static volatile uint8_t Dio_KeypadTail;
+/**
+* The number of events lost because the queue was full.
+*/
+static volatile uint16_t Dio_KeypadOverflows;
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : Dio_KeypadPush()
+*//**
+* \b Description:
+* Appends an event to the queue, or counts an overflow when it is full.
+**********************************************************************/
+static inline void
+Dio_KeypadPush(uint8_t Key, uint8_t Pressed)
+{
+  const uint8_t Head = Dio_KeypadHead;
+  const uint8_t Next = (uint8_t)((Head + 1U) & DIO_KEYPAD_QUEUE_MASK);
+
+  if(Next == Dio_KeypadTail)
+    {
+      Dio_KeypadOverflows++;
+      return;
+    }
+
+  Dio_KeypadQueue[Head].Key = Key;
+  Dio_KeypadQueue[Head].Pressed = Pressed;
+  // Publish the entry only after it is written
+  DIO_MEMORY_BARRIER();
+  Dio_KeypadHead = Next;
+}
+
+/**********************************************************************
+* Function : Dio_KeypadSample()
+*//**
+* \b Description:
+* Drives each row LOW in turn and samples the columns, a pressed key
+* pulls its column LOW. Sample receives the keys seen LOW on each row,
+* bit n for column n. The rows are released at the end.
+**********************************************************************/
+static void
+Dio_KeypadSample(uint8_t * const Sample)
+{
+  DioPortValue_t Levels[DIO_NUMBER_OF_PORTS];
+
+  for (uint8_t Row = 0; Row < DIO_KEYPAD_ROWS; Row++)
+    {
+      const DioPort_t Port = Dio_KeypadRowPort[Row];
+      uint8_t Keys = 0;
+
+      // Release the rows of the previous port before leaving it
+      if(Row != 0 && Dio_KeypadRowPort[Row - 1U] != Port)
+        {
+          Dio_SetPortDirectionMaskedIsr(Dio_KeypadRowPort[Row - 1U],
+                                        Dio_KeypadRowsOf[Dio_KeypadRowPort[Row - 1U]], 0);
+        }
+      Dio_SetPortDirectionMaskedIsr(Port, Dio_KeypadRowsOf[Port],
+                                    Dio_KeypadRowMask[Row]);
+
+      // The call to Dio_PortRead covers the input synchronizer delay
+      for (uint8_t Index = 0; Index < Dio_KeypadColumnPortCount; Index++)
+        {
+          const DioPort_t ColumnPort = Dio_KeypadColumnPorts[Index];
+
+          Levels[ColumnPort] = (DioPortValue_t)~Dio_PortRead(ColumnPort);
+        }
+
+      for (uint8_t Column = 0; Column < DIO_KEYPAD_COLUMNS; Column++)
+        {
+          if(Levels[Dio_KeypadColumnPort[Column]] & Dio_KeypadColumnMask[Column])
+            {
+              Keys |= (uint8_t)(1U << Column);
+            }
+        }
+      Sample[Row] = Keys;
+    }
+
+  Dio_SetPortDirectionMaskedIsr(Dio_KeypadRowPort[DIO_KEYPAD_ROWS - 1U],
+                                Dio_KeypadRowsOf[Dio_KeypadRowPort[DIO_KEYPAD_ROWS - 1U]], 0);
+}
+
+#if DIO_KEYPAD_DIODES == STD_OFF
+/**********************************************************************
+* Function : Dio_KeypadDeghost()
+*//**
+* \b Description:
+* Without diodes, three keys at the corners of a rectangle of the matrix
+* also close the fourth corner. Two rows that share a column with two or
+* more columns between them cannot be told apart from such a ghost, their
+* sample is replaced by their debounced state until the keys are released.
+**********************************************************************/
+static void
+Dio_KeypadDeghost(uint8_t * const Sample)
+{
+  uint8_t Ghost[DIO_KEYPAD_ROWS] = { 0 };
+
+  for (uint8_t Row = 0; Row < DIO_KEYPAD_ROWS; Row++)
+    {
+      for (uint8_t Other = (uint8_t)(Row + 1U); Other < DIO_KEYPAD_ROWS; Other++)
+        {
+          const uint8_t Both = (uint8_t)(Sample[Row] | Sample[Other]);
+
+          if((Sample[Row] & Sample[Other]) != 0 && (Both & (Both - 1U)) != 0)
+            {
+              Ghost[Row] = 1;
+              Ghost[Other] = 1;
+            }
+        }
+    }
+
+  for (uint8_t Row = 0; Row < DIO_KEYPAD_ROWS; Row++)
+    {
+      if(Ghost[Row] != 0)
+        {
+          Sample[Row] = Dio_KeypadState[Row];
+        }
+    }
+}
+#endif
+
+/*********************************************************************
+* Function : Dio_KeypadInit()
+*//**
+* \b Description:
+* This function is used to set up the keypad matrix: the rows are<br>
+* released (INPUT with their PORTx bits LOW) and the columns are inputs<br>
+* with their pull-ups enabled. All keys start released and the event<br>
+* queue is emptied.<br>
+* PRE-CONDITION: Dio_Init has been called <br>
+* PRE-CONDITION: The rows and the columns are distinct channels <br>
+* POST-CONDITION: The keypad is scanned by Dio_KeypadScan.<br>
+* @param Config is a pointer to the keypad matrix
+* @return void
+*
+* \b Example:
+* @code
+* Dio_KeypadInit(Dio_KeypadConfigGet());
+* @endcode
+* @see Dio_KeypadScan
+**********************************************************************/
+void
+Dio_KeypadInit(const DioKeypadConfig_t * const Config)
+{
+  DioPortValue_t ColumnsOf[DIO_NUMBER_OF_PORTS] = { 0 };
+
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      Dio_KeypadRowsOf[Port] = 0;
+    }
+
+  for (uint8_t Row = 0; Row < DIO_KEYPAD_ROWS; Row++)
+    {
+      Dio_KeypadRowPort[Row] = DIO_CHANNEL_PORT(Config->Rows[Row]);
+      Dio_KeypadRowMask[Row] = DIO_CHANNEL_MASK(Config->Rows[Row]);
+      Dio_KeypadRowsOf[Dio_KeypadRowPort[Row]] |= Dio_KeypadRowMask[Row];
+      Dio_KeypadState[Row] = 0;
+      for (uint8_t Bit = 0; Bit < DIO_KEYPAD_COUNTER_BITS; Bit++)
+        {
+          Dio_KeypadCounter[Bit][Row] = 0;
+        }
+    }
+
+  Dio_KeypadColumnPortCount = 0;
+  for (uint8_t Column = 0; Column < DIO_KEYPAD_COLUMNS; Column++)
+    {
+      const DioPort_t Port = DIO_CHANNEL_PORT(Config->Columns[Column]);
+
+      if(ColumnsOf[Port] == 0)
+        {
+          Dio_KeypadColumnPorts[Dio_KeypadColumnPortCount] = Port;
+          Dio_KeypadColumnPortCount++;
+        }
+      Dio_KeypadColumnPort[Column] = Port;
+      Dio_KeypadColumnMask[Column] = DIO_CHANNEL_MASK(Config->Columns[Column]);
+      ColumnsOf[Port] |= Dio_KeypadColumnMask[Column];
+    }
+
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      const DioPortValue_t Mask = Dio_KeypadRowsOf[Port] | ColumnsOf[Port];
+
+      if(Mask != 0)
+        {
+          // INPUT first, so that no row is driven HIGH by its PORTx bit
+          Dio_SetPortDirectionMasked((DioPort_t)Port, Mask, 0);
+          Dio_PortWriteMasked((DioPort_t)Port, Mask, ColumnsOf[Port]);
+        }
+    }
+
+  Dio_KeypadHead = 0;
+  Dio_KeypadTail = 0;
+  Dio_KeypadOverflows = 0;
+}
+
+/*********************************************************************
+* Function : Dio_KeypadScan()
+*//**
+* \b Description:
+* This function is used to scan and debounce the keypad. Each row costs<br>
+* one direction write and one input read per column port. A key whose<br>
+* sample differs from its debounced state for 2^DIO_KEYPAD_COUNTER_BITS<br>
+* scans in a row changes state and queues an event. Any number of keys<br>
+* is tracked at once; without diodes the rows of ambiguous keys keep<br>
+* their state while the ambiguity lasts.<br>
+* PRE-CONDITION: Dio_KeypadInit has been called <br>
+* POST-CONDITION: The key bitmap and the event queue are updated.<br>
+* @return void
+*
+* \b Example:
+* @code
+* void Timer_Isr(void) // 5 ms
+* {
+*   Dio_KeypadScan();
+* }
+* @endcode
+* @see Dio_KeypadEventRead
+**********************************************************************/
+void
+Dio_KeypadScan(void)
+{
+  uint8_t Sample[DIO_KEYPAD_ROWS];
+
+  Dio_KeypadSample(Sample);
+#if DIO_KEYPAD_DIODES == STD_OFF
+  Dio_KeypadDeghost(Sample);
+#endif
+
+  for (uint8_t Row = 0; Row < DIO_KEYPAD_ROWS; Row++)
+    {
+      const uint8_t Changed = (uint8_t)(Sample[Row] ^ Dio_KeypadState[Row]);
+      uint8_t Carry = Changed;
+
+      // Add the carry to the counters of the changed keys and clear the
+      // counters of the others, the carry out marks the wrapped ones
+      for (uint8_t Bit = 0; Bit < DIO_KEYPAD_COUNTER_BITS; Bit++)
+        {
+          Dio_KeypadCounter[Bit][Row] = (uint8_t)
+            ((Dio_KeypadCounter[Bit][Row] ^ Carry) & Changed);
+          Carry &= (uint8_t)~Dio_KeypadCounter[Bit][Row];
+        }
+
+      if(Carry == 0)
+        {
+          continue;
+        }
+
+      Dio_KeypadState[Row] ^= Carry;
+      for (uint8_t Column = 0; Column < DIO_KEYPAD_COLUMNS; Column++)
+        {
+          if(Carry & (1U << Column))
+            {
+              Dio_KeypadPush((uint8_t)(Row * DIO_KEYPAD_COLUMNS + Column),
+                             (uint8_t)((Dio_KeypadState[Row] >> Column) & 1U));
+            }
+        }
+    }
+}
+
+/*********************************************************************
+* Function : Dio_KeypadIsPressed()
+*//**
+* \b Description:
+* This function is used to get the debounced state of a key.<br>
+* PRE-CONDITION: Key < DIO_KEYPAD_KEYS <br>
+* @param Key is the key, row * DIO_KEYPAD_COLUMNS + column
+* @return 1 when the key is pressed, else 0
+*
+* \b Example:
+* @code
+* if(Dio_KeypadIsPressed(15)) { ... } // '#' of a 4x4 keypad
+* @endcode
+* @see Dio_KeypadBitmapGet
+**********************************************************************/
+uint8_t
+Dio_KeypadIsPressed(uint8_t Key)
+{
+  if(Key >= DIO_KEYPAD_KEYS)
+    {
+      //TODO: implement your error handling method
+      return 0;
+    }
+
+  return (uint8_t)((Dio_KeypadState[Key / DIO_KEYPAD_COLUMNS]
+                    >> (Key % DIO_KEYPAD_COLUMNS)) & 1U);
+}
+
+/*********************************************************************
+* Function : Dio_KeypadBitmapGet()
+*//**
+* \b Description:
+* This function is used to get the debounced state of all the keys, one<br>
+* byte per row with bit n for column n. The copy is taken in a critical<br>
+* section, so it is consistent with a scan run from an interrupt.<br>
+* @param Bitmap receives DIO_KEYPAD_ROWS bytes
+* @return void
+*
+* \b Example:
+* @code
+* uint8_t Keys[DIO_KEYPAD_ROWS];
+* Dio_KeypadBitmapGet(Keys);
+* @endcode
+* @see Dio_KeypadIsPressed
+**********************************************************************/
+void
+Dio_KeypadBitmapGet(uint8_t * const Bitmap)
+{
+  uint8_t Sreg;
+
+  DIO_CRITICAL_ENTER(Sreg);
+  for (uint8_t Row = 0; Row < DIO_KEYPAD_ROWS; Row++)
+    {
+      Bitmap[Row] = Dio_KeypadState[Row];
+    }
+  DIO_CRITICAL_EXIT(Sreg);
+}
+
+/*********************************************************************
+* Function : Dio_KeypadEventRead()
+*//**
+* \b Description:
+* This function is used to take the oldest key event from the queue.<br>
+* @param Event receives the event
+* @return 1 when an event was taken, 0 when the queue is empty
+*
+* \b Example:
+* @code
+* DioKeypadEvent_t Event;
+* while(Dio_KeypadEventRead(&Event))
+*   {
+*     if(Event.Pressed) { Menu_Key(Event.Key); }
+*   }
+* @endcode
+* @see Dio_KeypadScan
+**********************************************************************/
+uint8_t
+Dio_KeypadEventRead(DioKeypadEvent_t * const Event)
+{
+  const uint8_t Tail = Dio_KeypadTail;
+
+  if(Tail == Dio_KeypadHead)
+    {
+      return 0;
+    }
+
+  *Event = Dio_KeypadQueue[Tail];
+  // Free the entry only after it is copied
+  DIO_MEMORY_BARRIER();
+  Dio_KeypadTail = (uint8_t)((Tail + 1U) & DIO_KEYPAD_QUEUE_MASK);
+
+  return 1;
+}
+
+/*********************************************************************
+* Function : Dio_KeypadOverflowsGet()
+*//**
+* \b Description:
+* This function is used to get the number of key events lost because<br>
+* the queue was full since Dio_KeypadInit.<br>
+* @return The number of lost events
+*
+* \b Example:
+* @code
+* if(Dio_KeypadOverflowsGet() != 0) { ... }
+* @endcode
+* @see Dio_KeypadEventRead
+**********************************************************************/
+uint16_t
+Dio_KeypadOverflowsGet(void)
+{
+  uint16_t Overflows;
+  uint8_t Sreg;
+
+  DIO_CRITICAL_ENTER(Sreg);
+  Overflows = Dio_KeypadOverflows;
+  DIO_CRITICAL_EXIT(Sreg);
+
+  return Overflows;
+}
+/*************** END OF FUNCTIONS ********************************/
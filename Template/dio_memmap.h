@@ -0,0 +1,46 @@
+#ifndef DIO_MEMMAP_H
+#define DIO_MEMMAP_H
+
+#include <inttypes.h>
+
+/* Register access, redirected to the simulated register file for a host build */
+#ifdef DIO_SIM
+#include "dio_sim.h"
+#define DIO_REGISTER(Address)	DIO_SIM_REGISTER(Address)
+#define DIO_REG_READ(Register)	DioSim_RegRead(Register)
+#define DIO_REG_WRITE(Register, Value)	DioSim_RegWrite((Register), (Value))
+#else
+#define DIO_REGISTER(Address)	(Address)
+#define DIO_REG_READ(Register)	(*(Register))
+#define DIO_REG_WRITE(Register, Value)	(*(Register) = (Value))
+#endif
+
+/* Placement of constant tables in flash, plain const data on this MCU */
+#define DIO_FLASH
+#define DIO_FLASH_READ_BYTE(Address)	(*(Address))
+//TODO: Read a DioPortValue_t, pgm_read_word or pgm_read_dword on a wider port
+#define DIO_FLASH_READ_VALUE(Address)	(*(Address))
+
+//TODO: Populate with the port register addresses of the MCU
+#define PORTB	DIO_REGISTER(0x0000)
+#define DDRB	DIO_REGISTER(0x0000)
+#define PINB	DIO_REGISTER(0x0000)
+//TODO: Populate with the set and clear register addresses (DIO_BACKEND_SET_CLEAR)
+#define SETB	DIO_REGISTER(0x0000)
+#define CLRB	DIO_REGISTER(0x0000)
+
+/* Keeps the compiler from moving memory accesses across this point */
+#define DIO_MEMORY_BARRIER()	__asm__ __volatile__ ("" ::: "memory")
+
+/*
+ * Critical section, not ported: a build that uses it fails to link on
+ * Dio_CriticalSectionNotPorted instead of running without interrupt
+ * protection.
+ */
+uint8_t Dio_CriticalSectionNotPorted(void);
+//TODO: Save the interrupt state in Sreg and disable the interrupts
+#define DIO_CRITICAL_ENTER(Sreg)	do { (Sreg) = Dio_CriticalSectionNotPorted(); } while (0)
+//TODO: Restore the interrupt state saved in Sreg
+#define DIO_CRITICAL_EXIT(Sreg)	((void)Dio_CriticalSectionNotPorted(), (void)(Sreg))
+
+#endif
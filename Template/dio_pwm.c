@@ -0,0 +1,374 @@
+/**
+ * @file dio_pwm.c
+ * @author Mohamed Hassanin
+ * @brief The implementation for the dio software PWM.
+ * @version 0.1
+ * @date 2021-01-12
+ */
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "dio_pwm.h" /* For this modules definitions */
+#include "dio.h" /* For the port interface */
+#include "dio_memmap.h" /* For the memory barrier */
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+#if DIO_PWM_BITS > 15U
+#error "DIO_PWM_BITS must be at most 15"
+#endif
+/**
+* Defines the maximum number of frames of a timeline: one per duty bit
+* with bit angle modulation, the start of the period and the end of each
+* pulse with pulse width modulation.
+*/
+#if DIO_PWM_BAM == STD_ON
+#define DIO_PWM_FRAMES DIO_PWM_BITS
+#else
+#define DIO_PWM_FRAMES (DIO_PWM_CHANNELS + 1U)
+#endif
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+* Defines a frame: the value of the PWM channels of each PWM port from
+* the tick Slot of the period on.
+*/
+typedef struct
+{
+	uint16_t Slot; /**< The tick of the period the frame starts at */
+	DioPortValue_t Value[DIO_NUMBER_OF_PORTS]; /**< Value of each PWM port */
+}DioPwmFrame_t;
+
+/**
+* Defines the frames of a period, in tick order.
+*/
+typedef struct
+{
+	uint8_t Count; /**< The number of frames */
+	DioPwmFrame_t Frame[DIO_PWM_FRAMES]; /**< The frames */
+}DioPwmTimeline_t;
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The PWM channel table, the ports it touches with the mask of its
+* channels in each, and the entry of each channel in these ports.
+*/
+static const DioChannel_t * Dio_PwmChannels;
+static uint8_t Dio_PwmPortCount;
+static DioPort_t Dio_PwmPorts[DIO_NUMBER_OF_PORTS];
+static DioPortValue_t Dio_PwmMasks[DIO_NUMBER_OF_PORTS];
+static uint8_t Dio_PwmChannelPort[DIO_PWM_CHANNELS];
+/**
+* The duty cycles set by Dio_PwmDutySet, compiled by Dio_PwmCommit.
+*/
+static uint16_t Dio_PwmDuty[DIO_PWM_CHANNELS];
+/**
+* The timelines: the active one is played by Dio_PwmTick, the other one
+* is compiled by Dio_PwmCommit and made active at the start of the next
+* period when Pending is set.
+*/
+static DioPwmTimeline_t Dio_PwmTimelines[2];
+static volatile uint8_t Dio_PwmActive;
+static volatile uint8_t Dio_PwmPending;
+/**
+* The tick of the period and the next frame of the active timeline.
+*/
+static uint16_t Dio_PwmSlot;
+static uint8_t Dio_PwmNext;
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+static void Dio_PwmCompile(DioPwmTimeline_t * const Timeline);
+static void Dio_PwmAppend(DioPwmTimeline_t * const Timeline, uint16_t Slot,
+                          const DioPortValue_t * const Value);
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/*********************************************************************
+* Function : Dio_PwmInit()
+*//**
+* \b Description:
+* This function is used to initialize the software PWM of the channels of<br>
+* a PWM channel table. All the duty cycles are set to zero.<br>
+* PRE-CONDITION: Dio_Init has been called and configured the channels<br>
+* as OUTPUT <br>
+* PRE-CONDITION: The table has DIO_PWM_CHANNELS distinct channels <br>
+* PRE-CONDITION: Dio_PwmTick is not running <br>
+* POST-CONDITION: Dio_PwmTick drives the channels LOW.<br>
+* @param Channels is a pointer to the PWM channel table
+* @return void
+*
+* \b Example:
+* @code
+* Dio_PwmInit(Dio_PwmConfigGet());
+* @endcode
+* @see Dio_PwmTick
+**********************************************************************/
+void
+Dio_PwmInit(const DioChannel_t * const Channels)
+{
+  Dio_PwmChannels = Channels;
+  Dio_PwmPortCount = 0;
+
+  for (uint8_t Port = 0; Port < DIO_NUMBER_OF_PORTS; Port++)
+    {
+      DioPortValue_t Mask = 0;
+
+      for (uint8_t Index = 0; Index < DIO_PWM_CHANNELS; Index++)
+        {
+          if(DIO_CHANNEL_PORT(Channels[Index]) == Port)
+            {
+              Mask |= DIO_CHANNEL_MASK(Channels[Index]);
+              Dio_PwmChannelPort[Index] = Dio_PwmPortCount;
+            }
+        }
+
+      if(Mask != 0)
+        {
+          Dio_PwmPorts[Dio_PwmPortCount] = (DioPort_t)Port;
+          Dio_PwmMasks[Dio_PwmPortCount] = Mask;
+          Dio_PwmPortCount++;
+        }
+    }
+
+  for (uint8_t Index = 0; Index < DIO_PWM_CHANNELS; Index++)
+    {
+      Dio_PwmDuty[Index] = 0;
+    }
+
+  Dio_PwmCompile(&Dio_PwmTimelines[0]);
+  Dio_PwmActive = 0;
+  Dio_PwmPending = 0;
+  Dio_PwmSlot = 0;
+  Dio_PwmNext = 0;
+}
+
+/*********************************************************************
+* Function : Dio_PwmDutySet()
+*//**
+* \b Description:
+* This function is used to set the duty cycle of a PWM channel, the<br>
+* number of ticks of a period the channel is HIGH. The duty cycles take<br>
+* effect together at Dio_PwmCommit.<br>
+* PRE-CONDITION: Dio_PwmInit has been called <br>
+* PRE-CONDITION: Index < DIO_PWM_CHANNELS <br>
+* POST-CONDITION: The duty cycle is stored, limited to DIO_PWM_PERIOD.<br>
+* @param Index is the position of the channel in the PWM channel table
+* @param Duty is the duty cycle, 0 (LOW) to DIO_PWM_PERIOD (HIGH)
+* @return void
+*
+* \b Example:
+* @code
+* Dio_PwmDutySet(0, DIO_PWM_PERIOD / 4U);
+* Dio_PwmDutySet(1, DIO_PWM_PERIOD / 2U);
+* Dio_PwmCommit();
+* @endcode
+* @see Dio_PwmCommit
+**********************************************************************/
+void
+Dio_PwmDutySet(uint8_t Index, uint16_t Duty)
+{
+  if(Index >= DIO_PWM_CHANNELS)
+    {
+      //TODO: implement your error handling method
+      return;
+    }
+
+  Dio_PwmDuty[Index] = (Duty > DIO_PWM_PERIOD) ? DIO_PWM_PERIOD : Duty;
+}
+
+/*********************************************************************
+* Function : Dio_PwmCommit()
+*//**
+* \b Description:
+* This function is used to apply the duty cycles set by Dio_PwmDutySet.<br>
+* They are compiled into the inactive timeline, which Dio_PwmTick makes<br>
+* active at the start of the next period, so a period is never played<br>
+* with a mix of old and new duty cycles. A commit made before the<br>
+* previous one took effect replaces it.<br>
+* PRE-CONDITION: Dio_PwmInit has been called <br>
+* POST-CONDITION: The duty cycles take effect at the next period.<br>
+* @return void
+*
+* \b Example:
+* @code
+* Dio_PwmDutySet(0, Brightness);
+* Dio_PwmCommit();
+* @endcode
+* @see Dio_PwmDutySet
+**********************************************************************/
+void
+Dio_PwmCommit(void)
+{
+  DioPwmTimeline_t * Timeline;
+
+  // Keep the tick from taking the inactive timeline while it is compiled
+  Dio_PwmPending = 0;
+  DIO_MEMORY_BARRIER();
+
+  Timeline = &Dio_PwmTimelines[Dio_PwmActive ^ 1U];
+  Dio_PwmCompile(Timeline);
+
+  DIO_MEMORY_BARRIER();
+  Dio_PwmPending = 1;
+}
+
+/*********************************************************************
+* Function : Dio_PwmTick()
+*//**
+* \b Description:
+* This function is used to advance the software PWM by one tick. When<br>
+* the tick starts a frame, each PWM port is written once with the frame<br>
+* value; the other ticks do not access the ports. The timeline compiled<br>
+* by the last Dio_PwmCommit becomes active at the start of a period.<br>
+* PRE-CONDITION: Dio_PwmInit has been called <br>
+* POST-CONDITION: The PWM channels hold the value of the current frame.<br>
+* @return void
+*
+* \b Example:
+* @code
+* void Timer_Isr(void) // DIO_PWM_PERIOD ticks per PWM period
+* {
+*   Dio_PwmTick();
+* }
+* @endcode
+* @see Dio_PwmCommit
+**********************************************************************/
+void
+Dio_PwmTick(void)
+{
+  const DioPwmTimeline_t * Timeline;
+
+  if(Dio_PwmSlot == 0)
+    {
+      if(Dio_PwmPending != 0)
+        {
+          Dio_PwmActive ^= 1U;
+          Dio_PwmPending = 0;
+        }
+      Dio_PwmNext = 0;
+    }
+
+  Timeline = &Dio_PwmTimelines[Dio_PwmActive];
+
+  if(Dio_PwmNext < Timeline->Count && Timeline->Frame[Dio_PwmNext].Slot == Dio_PwmSlot)
+    {
+      const DioPwmFrame_t * const Frame = &Timeline->Frame[Dio_PwmNext];
+
+      for (uint8_t Port = 0; Port < Dio_PwmPortCount; Port++)
+        {
+          Dio_PortWriteMaskedIsr(Dio_PwmPorts[Port], Dio_PwmMasks[Port], Frame->Value[Port]);
+        }
+      Dio_PwmNext++;
+    }
+
+  Dio_PwmSlot++;
+  if(Dio_PwmSlot >= DIO_PWM_PERIOD)
+    {
+      Dio_PwmSlot = 0;
+    }
+}
+
+/**********************************************************************
+* Function : Dio_PwmCompile()
+*//**
+* \b Description:
+* Compiles the duty cycles into a timeline. With bit angle modulation,
+* the frame of duty bit n starts at tick 2^n - 1 and lasts 2^n ticks. With
+* pulse width modulation, a frame starts at tick 0 and at the end of each
+* distinct pulse.
+**********************************************************************/
+static void
+Dio_PwmCompile(DioPwmTimeline_t * const Timeline)
+{
+  DioPortValue_t Value[DIO_NUMBER_OF_PORTS];
+
+  Timeline->Count = 0;
+
+#if DIO_PWM_BAM == STD_ON
+  for (uint8_t Bit = 0; Bit < DIO_PWM_BITS; Bit++)
+    {
+      for (uint8_t Port = 0; Port < Dio_PwmPortCount; Port++)
+        {
+          Value[Port] = 0;
+        }
+
+      for (uint8_t Index = 0; Index < DIO_PWM_CHANNELS; Index++)
+        {
+          if(Dio_PwmDuty[Index] & (1U << Bit))
+            {
+              Value[Dio_PwmChannelPort[Index]] |= DIO_CHANNEL_MASK(Dio_PwmChannels[Index]);
+            }
+        }
+
+      Dio_PwmAppend(Timeline, (uint16_t)((1U << Bit) - 1U), Value);
+    }
+#else
+  uint16_t Slot = 0;
+
+  while(Slot < DIO_PWM_PERIOD)
+    {
+      // The channels still HIGH at Slot, and the end of the next pulse
+      uint16_t Next = DIO_PWM_PERIOD;
+
+      for (uint8_t Port = 0; Port < Dio_PwmPortCount; Port++)
+        {
+          Value[Port] = 0;
+        }
+
+      for (uint8_t Index = 0; Index < DIO_PWM_CHANNELS; Index++)
+        {
+          if(Dio_PwmDuty[Index] > Slot)
+            {
+              Value[Dio_PwmChannelPort[Index]] |= DIO_CHANNEL_MASK(Dio_PwmChannels[Index]);
+              if(Dio_PwmDuty[Index] < Next)
+                {
+                  Next = Dio_PwmDuty[Index];
+                }
+            }
+        }
+
+      Dio_PwmAppend(Timeline, Slot, Value);
+      Slot = Next;
+    }
+#endif
+}
+
+/**********************************************************************
+* Function : Dio_PwmAppend()
+*//**
+* \b Description:
+* Appends a frame to a timeline, unless it holds the same values as the
+* last frame and would not change the ports.
+**********************************************************************/
+static void
+Dio_PwmAppend(DioPwmTimeline_t * const Timeline, uint16_t Slot,
+              const DioPortValue_t * const Value)
+{
+  DioPwmFrame_t * const Frame = &Timeline->Frame[Timeline->Count];
+
+  if(Timeline->Count != 0)
+    {
+      uint8_t Same = 1;
+
+      for (uint8_t Port = 0; Port < Dio_PwmPortCount; Port++)
+        {
+          Same &= (Frame[-1].Value[Port] == Value[Port]);
+        }
+      if(Same != 0)
+        {
+          return;
+        }
+    }
+
+  Frame->Slot = Slot;
+  for (uint8_t Port = 0; Port < Dio_PwmPortCount; Port++)
+    {
+      Frame->Value[Port] = Value[Port];
+    }
+  Timeline->Count++;
+}
+/*************** END OF FUNCTIONS ********************************/